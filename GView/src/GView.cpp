@@ -1,5 +1,9 @@
 #include "../GViewCore/include/GView.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
 #include <iostream>
+#include <limits>
 
 enum class CommandID
 {
@@ -8,7 +12,9 @@ enum class CommandID
     Open,
     Reset,
     ListTypes,
-    UpdateConfig
+    UpdateConfig,
+    Identify,
+    SelfCheck
 };
 
 struct CommandInfo
@@ -37,6 +43,8 @@ CommandInfo commands[] = {
     { CommandID::Reset, _U("reset") },
     { CommandID::ListTypes, _U("list-types") },
     { CommandID::UpdateConfig, _U("updateconfig") },
+    { CommandID::Identify, _U("identify") },
+    { CommandID::SelfCheck, _U("selfcheck") },
 };
 
 std::string_view help = R"HELP(
@@ -61,11 +69,36 @@ Where <command> is on of:
 
    list-types             List all available types (as loaded from gview.ini).
                           Ex: 'GView list-types' 
+
+   identify [files|paths] Identifies the type of the files (folders are
+                          scanned recursively) without opening any window.
+                          Prints the type, confidence and time for each file.
+                          Confidence: 90 = magic bytes at a fixed offset,
+                          60 = text pattern, 30 = extension only (+10 when
+                          the extension matched as well as a pattern)
+                          Ex: 'GView identify samples/ --json -j 8'
+
+   selfcheck              Compares the vectorized code paths (new lines
+                          scanner) with their byte by byte versions on
+                          generated data. Exits with 1 if they differ.
+                          Ex: 'GView selfcheck'
 And <options> are:
    --type:<type>          Specify the type of the file (if knwon)
                           Ex: 'GView open a.temp --type:PE'    
    --selectType           Specify the type of the file should be manually selected
                           Ex: 'GView open a.temp --selectType'   
+   --json                 (identify) Prints the results in JSON format
+   --bestMatch            (identify) Validates all matching types, not just the
+                          first one (reported as 'matches' in JSON output)
+   -j <N>                 (identify) Number of worker threads (default: one
+                          per CPU core)
+   --time                 (identify) Identifies every file several times on
+                          one thread and prints the best/average latency of
+                          each file and a summary for binary vs text files
+                          (--json and -j are ignored)
+   --startup-trace        Prints (on exit) the time spent initializing the
+                          framework, reading the settings, loading the
+                          plugins and until the first paint
 )HELP";
 
 void ShowHelp()
@@ -104,6 +137,275 @@ bool ListTypes()
     return true;
 }
 
+template <typename T>
+void ArgToString(const T* arg, LocalString<128>& result)
+{
+    // options are always in ASCII format
+    result.Clear();
+    while ((*arg))
+    {
+        result.AddChar(static_cast<char>(*arg));
+        arg++;
+    }
+}
+
+void AddFilesToIdentify(const std::filesystem::path& path, std::vector<std::filesystem::path>& files)
+{
+    try
+    {
+        if (!std::filesystem::is_directory(path))
+        {
+            files.push_back(path);
+            return;
+        }
+        for (const auto& entry :
+             std::filesystem::recursive_directory_iterator(path, std::filesystem::directory_options::skip_permission_denied))
+        {
+            if (entry.is_regular_file())
+                files.push_back(entry.path());
+        }
+    }
+    catch (const std::filesystem::filesystem_error&)
+    {
+        // unreadable paths are reported as failures
+        files.push_back(path);
+    }
+}
+
+void PrintJSONString(std::string_view text)
+{
+    std::cout << '"';
+    for (auto ch : text)
+    {
+        switch (ch)
+        {
+        case '"':
+            std::cout << "\\\"";
+            break;
+        case '\\':
+            std::cout << "\\\\";
+            break;
+        default:
+            if (static_cast<uint8>(ch) < 32)
+                std::cout << "\\u" << std::hex << std::setw(4) << std::setfill('0') << (uint32) ch << std::dec << std::setfill(' ');
+            else
+                std::cout << ch;
+        }
+    }
+    std::cout << '"';
+}
+
+void PrintStartupTrace()
+{
+    GView::App::StartupTrace trace;
+    if (!GView::App::GetStartupTrace(trace))
+        return;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Startup trace:" << std::endl;
+    std::cout << "  Framework init : " << std::setw(10) << trace.frameworkInit << " ms" << std::endl;
+    std::cout << "  Settings       : " << std::setw(10) << trace.settings << " ms"
+              << (trace.registryCacheUsed ? " (from plugins registry)" : " (from gview.ini)") << std::endl;
+    std::cout << "  Plugin loading : " << std::setw(10) << trace.pluginsLoading << " ms (" << trace.pluginsLoaded << " plugins)"
+              << std::endl;
+    if (trace.firstPaint > 0)
+        std::cout << "  First paint    : " << std::setw(10) << trace.firstPaint << " ms" << std::endl;
+}
+
+constexpr uint32 IDENTIFY_TIME_RUNS = 5;
+
+void PrintIdentifyLatencySummary(std::string_view name, std::vector<double>& latencies)
+{
+    if (latencies.empty())
+    {
+        std::cout << "  " << std::left << std::setw(8) << name << ": no files" << std::endl;
+        return;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    auto total = 0.0;
+    for (auto value : latencies)
+        total += value;
+    std::cout << "  " << std::left << std::setw(8) << name << ": " << std::right << std::setw(6) << latencies.size() << " files, avg "
+              << std::setw(8) << total / (double) latencies.size() << " ms, median " << std::setw(8) << latencies[latencies.size() / 2]
+              << " ms, max " << std::setw(8) << latencies.back() << " ms" << std::endl;
+}
+
+// every file is identified IDENTIFY_TIME_RUNS times on one thread (the first run also brings the file in the OS cache)
+// the best latency of each file is the one used for the binary vs text summary
+void IdentifyFilesWithTiming(const std::vector<std::filesystem::path>& files, GView::App::OpenMethod method)
+{
+    struct FileTiming
+    {
+        std::string_view typeName;
+        double best, total;
+        bool text, success;
+    };
+    std::vector<FileTiming> timings(files.size(), FileTiming{ "", std::numeric_limits<double>::max(), 0.0, false, true });
+    for (uint32 run = 0; run < IDENTIFY_TIME_RUNS; run++)
+    {
+        // one worker thread => the results come in the same order as the files
+        size_t index = 0;
+        GView::App::IdentifyFiles(
+              files,
+              1,
+              method,
+              [&](const std::filesystem::path&, const GView::App::IdentifyResult& result)
+              {
+                  auto& t    = timings[index++];
+                  t.typeName = result.typeName;
+                  t.best     = std::min<>(t.best, result.duration);
+                  t.text     = result.textDecoded;
+                  t.success  = t.success && result.success;
+                  t.total += result.duration;
+              });
+    }
+
+    std::vector<double> binaryFiles, textFiles;
+    std::cout << std::fixed << std::setprecision(3);
+    for (size_t idx = 0; idx < files.size(); idx++)
+    {
+        const auto& t   = timings[idx];
+        const auto type = t.success ? (t.typeName.empty() ? "?" : t.typeName) : "<error>";
+        const auto kind = t.text ? "text" : "binary";
+        const auto avg  = t.total / IDENTIFY_TIME_RUNS;
+        std::cout << std::left << std::setw(15) << type << std::setw(7) << kind << std::right << std::setw(10) << t.best << " ms (best) "
+                  << std::setw(10) << avg << " ms (avg)  " << files[idx].string() << std::endl;
+        if (t.success)
+            (t.text ? textFiles : binaryFiles).push_back(t.best);
+    }
+    std::cout << "Best latency of " << IDENTIFY_TIME_RUNS << " runs:" << std::endl;
+    PrintIdentifyLatencySummary("binary", binaryFiles);
+    PrintIdentifyLatencySummary("text", textFiles);
+}
+
+template <typename T>
+int ProcessIdentifyCommand(int argc, T** argv, int startIndex)
+{
+    LocalString<128> tempString;
+    auto json         = false;
+    auto threadsCount = 0U;
+    auto startupTrace = false;
+    auto timing       = false;
+    auto method       = GView::App::OpenMethod::FirstMatch;
+    std::vector<std::filesystem::path> files;
+
+    for (auto index = startIndex; index < argc; index++)
+    {
+        if (argv[index][0] != '-')
+        {
+            AddFilesToIdentify(argv[index], files);
+            continue;
+        }
+        ArgToString(argv[index], tempString);
+        if (tempString.Equals("--json", true))
+        {
+            json = true;
+            continue;
+        }
+        if (tempString.Equals("--bestMatch", true))
+        {
+            method = GView::App::OpenMethod::BestMatch;
+            continue;
+        }
+        if (tempString.Equals("--startup-trace", true))
+        {
+            startupTrace = true;
+            continue;
+        }
+        if (tempString.Equals("--time", true))
+        {
+            timing = true;
+            continue;
+        }
+        if (tempString.StartsWith("-j", true))
+        {
+            // both '-j N' and '-jN' are accepted
+            auto number = tempString.ToStringView().substr(2);
+            if ((number.empty()) && (index + 1 < argc))
+            {
+                index++;
+                ArgToString(argv[index], tempString);
+                number = tempString.ToStringView();
+            }
+            auto value = Number::ToUInt32(number);
+            if (value.has_value())
+            {
+                threadsCount = value.value();
+                continue;
+            }
+        }
+        std::cout << "Unknwon option: " << tempString.ToStringView() << std::endl;
+        std::cout << "Type 'GView help' for a detailed list of available options" << std::endl;
+        return 1;
+    }
+    if (files.empty())
+    {
+        std::cout << "No files to identify !" << std::endl;
+        return 1;
+    }
+    if (!GView::App::InitHeadless())
+    {
+        std::cout << "Fail to load the configuration file (use 'GView reset' to create one)" << std::endl;
+        return 1;
+    }
+    if (timing)
+    {
+        IdentifyFilesWithTiming(files, method);
+        if (startupTrace)
+            PrintStartupTrace();
+        return 0;
+    }
+
+    auto count    = 0U;
+    auto failures = 0U;
+    auto start    = std::chrono::steady_clock::now();
+    if (json)
+        std::cout << "{\n  \"files\": [";
+    GView::App::IdentifyFiles(
+          files,
+          threadsCount,
+          method,
+          [&](const std::filesystem::path& path, const GView::App::IdentifyResult& result)
+          {
+              const auto name = path.string();
+              if (!result.success)
+                  failures++;
+              if (json)
+              {
+                  std::cout << (count > 0 ? ",\n    " : "\n    ") << "{ \"path\": ";
+                  PrintJSONString(name);
+                  std::cout << ", \"type\": ";
+                  if (result.typeName.empty())
+                      std::cout << "null";
+                  else
+                      PrintJSONString(result.typeName);
+                  std::cout << ", \"confidence\": " << result.confidence << ", \"matches\": " << result.matchesCount
+                            << ", \"ms\": " << result.duration << ", \"error\": " << (result.success ? "false" : "true") << " }";
+              }
+              else
+              {
+                  const auto type = result.success ? (result.typeName.empty() ? "?" : result.typeName) : "<error>";
+                  std::cout << std::left << std::setw(15) << type << std::right << std::setw(4) << result.confidence << "% " << std::fixed
+                            << std::setprecision(3) << std::setw(10) << result.duration << " ms  " << name << std::endl;
+              }
+              count++;
+          });
+    const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const auto speed   = seconds > 0 ? (double) count / seconds : 0.0;
+    if (json)
+    {
+        std::cout << "\n  ],\n  \"count\": " << count << ",\n  \"errors\": " << failures << ",\n  \"seconds\": " << seconds
+                  << ",\n  \"filesPerSecond\": " << speed << "\n}" << std::endl;
+    }
+    else
+    {
+        std::cout << std::fixed << std::setprecision(3) << count << " files (" << failures << " errors) in " << seconds << " sec ("
+                  << std::setprecision(1) << speed << " files/sec)" << std::endl;
+    }
+    if ((startupTrace) && (!json))
+        PrintStartupTrace();
+    return 0;
+}
+
 template <typename T>
 int ProcessOpenCommand(int argc, T** argv, int startIndex)
 {
@@ -111,21 +413,15 @@ int ProcessOpenCommand(int argc, T** argv, int startIndex)
     auto start = startIndex;
     LocalString<128> tempString;
     LocalString<16> type;
-    auto method = GView::App::OpenMethod::FirstMatch;
+    auto method       = GView::App::OpenMethod::FirstMatch;
+    auto startupTrace = false;
 
     // check options
     for (; start < argc; start++)
     {
         if (argv[start][0] == '-')
         {
-            // options are always in ASCII format
-            tempString.Clear();
-            const T* p = argv[start];
-            while ((*p))
-            {
-                tempString.AddChar(static_cast<char>(*p));
-                p++;
-            }
+            ArgToString(argv[start], tempString);
             if (tempString.StartsWith("--type:", true))
             {
                 method = GView::App::OpenMethod::ForceType;
@@ -137,6 +433,11 @@ int ProcessOpenCommand(int argc, T** argv, int startIndex)
                 method = GView::App::OpenMethod::Select;
                 continue;
             }
+            if (tempString.Equals("--startup-trace", true))
+            {
+                startupTrace = true;
+                continue;
+            }
             std::cout << "Unknwon option: " << tempString.ToStringView() << std::endl;
             std::cout << "Type 'GView help' for a detailed list of available options" << std::endl;
             return 1;
@@ -154,6 +455,21 @@ int ProcessOpenCommand(int argc, T** argv, int startIndex)
     AppCUI::Application::ArrangeWindows(AppCUI::Application::ArrangeWindowsMethod::Grid);
     GView::App::Run();
 
+    // the UI is closed at this point => the trace can be printed
+    if (startupTrace)
+        PrintStartupTrace();
+    return 0;
+}
+
+int SelfCheck()
+{
+    LocalString<256> error;
+    if (!GView::Utils::LineScanner::SelfCheck(error))
+    {
+        std::cout << "LineScanner : FAILED (" << error.ToStringView() << ")" << std::endl;
+        return 1;
+    }
+    std::cout << "LineScanner : OK" << std::endl;
     return 0;
 }
 
@@ -183,6 +499,10 @@ int main(int argc, const char** argv)
         return 0;
     case CommandID::Open:
         return ProcessOpenCommand(argc, argv, 2);
+    case CommandID::Identify:
+        return ProcessIdentifyCommand(argc, argv, 2);
+    case CommandID::SelfCheck:
+        return SelfCheck();
     case CommandID::Unknown:
         return ProcessOpenCommand(argc, argv, 1);
     default:
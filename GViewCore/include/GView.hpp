@@ -5,6 +5,9 @@
 
 #include <AppCUI/include/AppCUI.hpp>
 
+#include <functional>
+#include <mutex>
+
 using namespace AppCUI::Controls;
 using namespace AppCUI::Utils;
 using namespace AppCUI::Graphics;
@@ -69,14 +72,62 @@ namespace Utils
 
         void PopulateListView(AppCUI::Utils::Reference<AppCUI::Controls::ListView> listView) const;
     };
+    struct DataCacheStatistics
+    {
+        uint64 requestedBytes; // bytes returned by Get (hits + misses)
+        uint64 readBytes;      // bytes actually read from the underlying object
+        uint64 hits;
+        uint64 misses;
+
+        inline double GetReadAmplification() const
+        {
+            return requestedBytes > 0 ? ((double) readBytes) / ((double) requestedBytes) : 0.0;
+        }
+    };
     class CORE_EXPORT DataCache
     {
+        struct Slot
+        {
+            uint64 start, end, lastUsed;
+            uint8* data;
+            uint32 allocated;
+            uint32 pins;
+            bool detached; // pinned window that passed the end of a truncated file (only kept until it is unpinned)
+        };
+        struct Mapping
+        {
+            uint8* data;
+            uint64 size;
+            uint32 delta;
+        };
+        struct SharedFile;
+        class RangeReader;
+        static constexpr uint32 MAX_SLOTS = 16;
+
         AppCUI::OS::DataObject* fileObj;
         uint64 fileSize, start, end, currentPos;
-        uint8* cache;
+        uint8* cache; // data of the most recently used slot ([start, end) window)
         uint32 cacheSize;
+        uint32 slotSize;
+        uint32 slotsCount;
+        uint32 mruSlot;
+        uint64 tick;
+        Slot slots[MAX_SLOTS];
+        DataCacheStatistics stats;
+        bool isMapped; // 'cache' points to a read-only memory mapping of the entire file (start = 0, end = fileSize)
+        std::mutex* ioLock; // serializes the access to 'fileObj' (SetCurrentPos + Read) between threads
+        std::filesystem::path* mappedFilePath; // file that is mapped (nullptr if the object is not memory mapped)
+        uint64 mappedFileOffset;               // offset (in the mapped file) of the first byte of this object
+        uint32 mappingDelta;                   // views are mapped from an aligned offset => 'cache' - mappingDelta is the view
+        uint64 mappingSize;                    // address space at 'cache' (mapped, or reserved for the growth of the file)
+        std::vector<Mapping>* oldMappings;     // replaced when the file outgrew its mapping (views stay valid until destruction)
+        SharedFile* sharedFile;                // owns 'fileObj' and 'ioLock' (shared with the readers from CreateRangeReader)
 
         bool CopyObject(void* buffer, uint64 offset, uint32 requestedSize);
+        bool ReadFromObject(uint64 offset, void* buffer, uint32 size);
+        void SetMostRecentlyUsedSlot(uint32 index);
+        int32 FindSlot(uint64 offset, uint64 endOffset) const;
+        int32 FindVictimSlot(uint32 windowSize) const;
 
       public:
         DataCache();
@@ -84,9 +135,17 @@ namespace Utils
         ~DataCache();
 
         bool Init(std::unique_ptr<AppCUI::OS::DataObject> file, uint32 cacheSize);
+        // regular files are memory mapped ; if another process truncates the file, the views past its new end read zeros
+        // (GetSize() keeps the old value until UpdateSize is called)
+        bool Init(std::unique_ptr<AppCUI::OS::File> file, const std::filesystem::path& path, uint32 cacheSize);
+        // [offset, offset+size) of a memory mapped parent (the same file is mapped again => no copy and no link to the parent)
+        bool Init(const DataCache& parent, uint64 offset, uint64 size, uint32 cacheSize);
         BufferView Get(uint64 offset, uint32 requestedSize, bool failIfRequestedSizeCanNotBeRead);
+        // empty view if the file is not memory mapped and does not fit in the cache (use ForEachChunk for those files)
         inline BufferView GetEntireFile()
         {
+            if (isMapped)
+                return BufferView(cache, (size_t) fileSize);
             return fileSize < 0xFFFFFFFF ? Get(0, (uint32) fileSize, true) : BufferView();
         }
 
@@ -105,11 +164,35 @@ namespace Utils
         {
             return cacheSize;
         }
+        inline uint32 GetSlotSize() const
+        {
+            return slotSize;
+        }
+        inline const DataCacheStatistics& GetStatistics() const
+        {
+            return stats;
+        }
+        inline void ResetStatistics()
+        {
+            stats = {};
+        }
+
+        // a pinned view stays valid (its slot is never evicted) until Unpin is called for it
+        BufferView Pin(uint64 offset, uint32 requestedSize, bool failIfRequestedSizeCanNotBeRead = true);
+        void Unpin(BufferView view);
+        inline bool IsMemoryMapped() const
+        {
+            return isMapped;
+        }
 
         inline uint64 GetSize() const
         {
             return fileSize;
         }
+        // polls the size of the underlying file and updates the size of the object (the views returned before stay valid ;
+        // past the new end of a truncated file they read zeros or stale bytes) ; a mapped file that grows is mapped in place
+        // only files opened directly can change their size ; returns true if GetSize() changed
+        bool UpdateSize();
         inline uint64 GetCurrentPos() const
         {
             return currentPos;
@@ -125,9 +208,56 @@ namespace Utils
             return CopyObject(&object, offset, sizeof(T));
         }
 
-        bool WriteTo(Reference<AppCUI::OS::DataObject> output, uint64 offset, uint32 size);
+        bool WriteTo(Reference<AppCUI::OS::DataObject> output, uint64 offset, uint64 size);
+
+        // calls callback(uint64 chunkOffset, BufferView chunk) for consecutive chunks of [offset, offset+size) (no 4 GB limit)
+        // chunks are views (into the mapping or into a read-ahead buffer) valid only during the call ; all chunks except the
+        // last one have the same size ('chunkSize' clamped to [4K, 16M], 0 = cache size). Returning false stops the iteration.
+        template <typename T>
+        bool ForEachChunk(uint64 offset, uint64 size, T&& callback, uint32 chunkSize = 0);
+
+        // thread safe read that bypasses the cache slots
+        bool ReadDirect(uint64 offset, void* buffer, uint32 size);
+        // read-only object over [offset, offset+size) that reads through the file object of this cache (no copy) ; the file
+        // object is shared => the reader can outlive this cache. nullptr if there is no file object (memory mapped slices)
+        std::unique_ptr<AppCUI::OS::DataObject> CreateRangeReader(uint64 offset, uint64 size);
+        // hints the OS that [offset, offset+size) will be needed soon (only for memory mapped files)
+        void Prefetch(uint64 offset, uint64 size);
     };
 
+    // Reads [offset, offset+size) in consecutive chunks. While the caller processes the current chunk the next one is read
+    // on a background thread (or, for memory mapped files, requested from the OS read-ahead).
+    class CORE_EXPORT SequentialReader
+    {
+        void* data;
+
+      public:
+        SequentialReader(DataCache& cache, uint64 offset, uint64 size, uint32 chunkSize = 0);
+        SequentialReader(const SequentialReader&) = delete;
+        ~SequentialReader();
+
+        // the last 'keepBytes' bytes (at most MAX_KEEP_BYTES) of the previous chunk are prepended to the returned one
+        // the returned view is valid until the next call to Next
+        BufferView Next(uint32 keepBytes = 0);
+        uint64 GetChunkOffset() const; // file offset of the first byte from the view returned by the last Next call
+        bool HasErrors() const;
+
+        static constexpr uint32 MAX_KEEP_BYTES = 256;
+    };
+
+    template <typename T>
+    inline bool DataCache::ForEachChunk(uint64 offset, uint64 size, T&& callback, uint32 chunkSize)
+    {
+        CHECK((offset <= fileSize) && (size <= fileSize - offset), false, "Invalid range: %llu bytes from %llu", size, offset);
+        SequentialReader reader(*this, offset, size, chunkSize);
+        for (auto buf = reader.Next(); buf.IsValid(); buf = reader.Next())
+        {
+            if (!callback(reader.GetChunkOffset(), buf))
+                return true;
+        }
+        return !reader.HasErrors();
+    }
+
     enum class DemangleKind : uint8
     {
         Auto,
@@ -137,6 +267,84 @@ namespace Utils
     };
     CORE_EXPORT bool Demangle(std::string_view input, String& output, DemangleKind format = DemangleKind::Auto);
 
+    // Shannon entropy and byte class of every BLOCK_SIZE block of an object. The blocks are computed in background (on all
+    // cores, each worker with its own reader) starting from the first queried offset; a query for a block that was not
+    // computed yet computes it on the spot.
+    class CORE_EXPORT EntropyMap
+    {
+        void* data;
+
+      public:
+        static constexpr uint32 BLOCK_SIZE = 0x1000;
+        enum class BlockType : uint8
+        {
+            NotComputed = 0,
+            Zero,   // only 0x00 bytes
+            Text,   // mostly printable ASCII characters and white spaces
+            Binary, // code, tables, structures
+            Packed  // entropy close to 8 bits/byte (compressed or encrypted data)
+        };
+
+        EntropyMap(Object& obj);
+        EntropyMap(const EntropyMap&) = delete;
+        ~EntropyMap();
+
+        // starts the background computation from the block of 'offset' (if not already started) without reading anything
+        // itself ; if the object changed its size since the last call, the workers are restarted for the new size
+        void Start(uint64 offset);
+        void Stop(); // the computed blocks are kept
+        bool IsCompleted() const;
+        uint64 GetBlocksCount() const;
+
+        // entropy (between 0 and 8 bits/byte) of the block that contains 'offset'
+        double GetEntropy(uint64 offset);
+        // mean of the entropy of the blocks from [offset, offset+size) ; useful for packer heuristics on sections/segments
+        double GetEntropy(uint64 offset, uint64 size);
+        BlockType GetBlockType(uint64 offset);
+        // does not compute anything ; returns false if the block of 'offset' was not computed yet
+        bool TryGet(uint64 offset, double& entropy, BlockType& type) const;
+        // mean of the entropy of the blocks from [offset, offset+size) ; false if one of them was not computed yet
+        bool TryGet(uint64 offset, uint64 size, double& entropy) const;
+    };
+
+    // Splits a text into lines ('\n', '\r', CRLF and LFCR end a line) without decoding it: only the new line characters are
+    // looked for (16 or 32 bytes at once) and, for UTF-8, only the lead bytes are counted as characters.
+    class CORE_EXPORT LineScanner
+    {
+        void* data;
+
+      public:
+        enum class Encoding : uint8
+        {
+            Ascii, // one byte per character (also used for binary data)
+            UTF8,  // an invalid sequence counts as one character for each of its lead bytes
+            UTF16LE,
+            UTF16BE
+        };
+        struct Line
+        {
+            uint64 offset;
+            uint32 size;        // in bytes, without the new line characters
+            uint32 charsCount;  // without the new line characters
+            uint32 newLineSize; // in bytes ; 0 for a split line or for the last line of the text
+        };
+
+        // a line with more than 'maxCharsPerLine' characters (0 = no limit) is split right after its last allowed character
+        // (a new line that follows a split line ends an empty line)
+        LineScanner(Encoding encoding, uint64 offset, uint32 maxCharsPerLine = 0);
+        LineScanner(const LineScanner&) = delete;
+        ~LineScanner();
+
+        // 'chunk' must start where the previous one ended ; the lines that end in it are appended to 'lines'
+        void Scan(BufferView chunk, std::vector<Line>& lines);
+        // appends the lines that are still pending (must be called after the last chunk)
+        void Finish(std::vector<Line>& lines);
+        uint64 GetOffset() const; // offset of the first byte that was not scanned yet
+
+        // compares the vectorized scan (whole texts and texts fed in chunks) with the byte by byte one on generated texts
+        static bool SelfCheck(String& error);
+    };
+
 } // namespace Utils
 
 namespace Hashes
@@ -572,6 +780,7 @@ namespace Compression
  *   - a folder
  *   - a process
  *   - a memory buffer
+ *   - a slice (a sub-range of another object)
  */
 class CORE_EXPORT Object
 {
@@ -581,11 +790,13 @@ class CORE_EXPORT Object
         File,
         Folder,
         MemoryBuffer,
-        Process
+        Process,
+        Slice
     };
 
   private:
     Utils::DataCache cache;
+    Utils::EntropyMap entropy; // must be declared after 'cache' (its workers read through it)
     TypeInterface* contentType;
     AppCUI::Utils::UnicodeStringBuilder name;
     AppCUI::Utils::UnicodeStringBuilder filePath;
@@ -594,7 +805,8 @@ class CORE_EXPORT Object
 
   public:
     Object(Type objType, Utils::DataCache&& dataCache, TypeInterface* contType, ConstString objName, ConstString objFilePath, uint32 pid)
-        : cache(std::move(dataCache)), contentType(contType), name(objName), filePath(objFilePath), PID(pid), objectType(objType)
+        : cache(std::move(dataCache)), entropy(*this), contentType(contType), name(objName), filePath(objFilePath), PID(pid),
+          objectType(objType)
     {
         if (contentType)
             contentType->obj = this;
@@ -603,6 +815,14 @@ class CORE_EXPORT Object
     {
         return cache;
     }
+    inline Utils::EntropyMap& GetEntropyMap()
+    {
+        return entropy;
+    }
+    inline double GetEntropy(uint64 offset)
+    {
+        return entropy.GetEntropy(offset);
+    }
     inline u16string_view GetName() const
     {
         return name.ToStringView();
@@ -628,6 +848,11 @@ class CORE_EXPORT Object
     {
         return objectType;
     }
+
+    // creates an independent reader (with its own cache, mapping or file handle) that can be used from a worker thread while
+    // the UI thread keeps using GetData(). Readers for objects that are neither mapped nor files (buffers, processes) read
+    // through this object and must not outlive it. Returns nullptr on failure.
+    std::unique_ptr<Utils::DataCache> CreateReader();
 };
 
 namespace View
@@ -692,6 +917,7 @@ namespace View
 
             Settings();
             void AddZone(uint64 start, uint64 size, ColorPair col, std::string_view name);
+            void ReserveZones(uint32 count); // before adding a large number of zones (one per line, record, ...)
             void AddBookmark(uint8 bookmarkID, uint64 fileOffset);
             void SetOffsetTranslationList(std::initializer_list<std::string_view> list, Reference<OffsetTranslateInterface> cbk);
             void SetPositionToColorCallback(Reference<PositionToColorInterface> cbk);
@@ -1269,12 +1495,52 @@ namespace App
     void CORE_EXPORT OpenBuffer(BufferView buf, const ConstString& name, OpenMethod method, std::string_view typeName = "");
     void CORE_EXPORT
     OpenBuffer(BufferView buf, const ConstString& name, const ConstString& path, OpenMethod method, std::string_view typeName = "");
+    // opens [offset, offset+size) from 'parent' as a new object (without copying it if the parent is memory mapped)
+    void CORE_EXPORT OpenSubObject(
+          Reference<GView::Object> parent,
+          uint64 offset,
+          uint64 size,
+          const ConstString& name,
+          OpenMethod method         = OpenMethod::BestMatch,
+          std::string_view typeName = "");
     Reference<GView::Object> CORE_EXPORT GetObject(uint32 index);
     uint32 CORE_EXPORT GetObjectsCount();
     std::string_view CORE_EXPORT GetTypePluginName(uint32 index);
     std::string_view CORE_EXPORT GetTypePluginDescription(uint32 index);
     uint32 CORE_EXPORT GetTypePluginsCount();
 
+    struct StartupTrace
+    {
+        double frameworkInit;  // AppCUI initialization (including reading gview.ini) - in milliseconds
+        double settings;       // building the type/generic plugins list (from the registry cache or from gview.ini)
+        double pluginsLoading; // loading the .tpl files (so far)
+        double firstPaint;     // from the start of the initialization until the desktop was started
+        uint32 pluginsLoaded;
+        bool registryCacheUsed;
+    };
+    // timings recorded while GView was initialized (only available after Init or InitHeadless)
+    bool CORE_EXPORT GetStartupTrace(StartupTrace& trace);
+
+    struct IdentifyResult
+    {
+        std::string_view typeName; // empty if no type plugin recognized the file
+        uint32 confidence;         // 0 = not identified, 30 = extension, 60 = text pattern, 90 = magic (+10 if the extension matched too)
+        uint32 matchesCount;       // how many type plugins validated the content
+        double duration;           // in milliseconds
+        bool success;              // false if the file could not be read
+        bool textDecoded;          // the content was converted to UTF-16 (a text pattern was evaluated on a text file)
+    };
+    // loads the settings and all type plugins without creating any UI
+    bool CORE_EXPORT InitHeadless();
+    // identifies the files using 'threadsCount' worker threads (0 = one per CPU core).
+    // 'method' can be FirstMatch or BestMatch (BestMatch never shows the selection dialog).
+    // calls to 'onResult' are serialized, but they come from the worker threads (in completion order)
+    bool CORE_EXPORT IdentifyFiles(
+          const std::vector<std::filesystem::path>& files,
+          uint32 threadsCount,
+          OpenMethod method,
+          std::function<void(const std::filesystem::path& path, const IdentifyResult& result)> onResult);
+
 }; // namespace App
 }; // namespace GView
 
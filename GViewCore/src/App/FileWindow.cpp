@@ -75,6 +75,9 @@ FileWindow::FileWindow(std::unique_ptr<GView::Object> _obj, Reference<GView::App
     // set the name
     this->SetText(obj->GetName());
     this->SetTag(obj->GetContentType()->GetTypeName(), "");
+
+    // strings are indexed in background, but only when the Strings panel or a buffer view needs them
+    this->strings.Init(Reference<GView::Object>(this->obj.get()));
 }
 Reference<GView::Object> FileWindow::GetObject()
 {
@@ -127,8 +130,14 @@ bool FileWindow::AddPanel(Pointer<TabPage> page, bool verticalPosition)
 }
 bool FileWindow::CreateViewer(const std::string_view& name, GView::View::BufferViewer::Settings& settings)
 {
-    return this->view->CreateChildControl<GView::View::BufferViewer::Instance>(name, Reference<GView::Object>(this->obj.get()), &settings)
-          .IsValid();
+    auto v =
+          this->view->CreateChildControl<GView::View::BufferViewer::Instance>(name, Reference<GView::Object>(this->obj.get()), &settings);
+    if (v.IsValid())
+    {
+        v->SetStringsIndex(&this->strings);
+        v->SetMatchZones(&this->matchZones);
+    }
+    return v.IsValid();
 }
 bool FileWindow::CreateViewer(const std::string_view& name, GView::View::TextViewer::Settings& settings)
 {
@@ -277,6 +286,8 @@ bool FileWindow::OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar)
 }
 void FileWindow::Start()
 {
+    AddPanel(Pointer<TabPage>(new StringsPanel(this, &this->strings)), false);
+    AddPanel(Pointer<TabPage>(new RulesPanel(this, &this->matchZones)), false);
     this->view->SetCurrentTabPageByIndex(0);
     this->view->SetFocus();
 }
@@ -54,6 +54,26 @@ bool GView::App::Init()
     }
     return true;
 }
+bool GView::App::InitHeadless()
+{
+    gviewAppInstance = new GView::App::Instance();
+    if (!gviewAppInstance->InitHeadless())
+    {
+        delete gviewAppInstance;
+        gviewAppInstance = nullptr;
+        RETURNERROR(false, "Fail to initialize GView (headless mode)");
+    }
+    return true;
+}
+bool GView::App::IdentifyFiles(
+      const std::vector<std::filesystem::path>& files,
+      uint32 threadsCount,
+      OpenMethod method,
+      std::function<void(const std::filesystem::path& path, const IdentifyResult& result)> onResult)
+{
+    CHECK(gviewAppInstance, false, "GView was not initialized !");
+    return gviewAppInstance->IdentifyFiles(files, threadsCount, method, onResult);
+}
 void GView::App::Run()
 {
     if (gviewAppInstance)
@@ -143,6 +163,12 @@ void GView::App::OpenBuffer(BufferView buf, const ConstString& name, const Const
     if (gviewAppInstance)
         gviewAppInstance->AddBufferWindow(buf, name, path, method, typeName);
 }
+void GView::App::OpenSubObject(
+      Reference<GView::Object> parent, uint64 offset, uint64 size, const ConstString& name, OpenMethod method, std::string_view typeName)
+{
+    if (gviewAppInstance)
+        gviewAppInstance->AddSubObjectWindow(parent, offset, size, name, method, typeName);
+}
 
 Reference<GView::Object> GView::App::GetObject(uint32 index)
 {
@@ -164,6 +190,12 @@ std::string_view GView::App::GetTypePluginDescription(uint32 index)
     CHECK(gviewAppInstance, nullptr, "GView was not initialized !");
     return gviewAppInstance->GetTypePluginDescription(index);
 }
+bool GView::App::GetStartupTrace(StartupTrace& trace)
+{
+    CHECK(gviewAppInstance, false, "GView was not initialized !");
+    gviewAppInstance->GetStartupTrace(trace);
+    return true;
+}
 uint32 CORE_EXPORT GView::App::GetTypePluginsCount()
 {
     CHECK(gviewAppInstance, 0, "GView was not initialized !");
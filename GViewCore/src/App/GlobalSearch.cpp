@@ -0,0 +1,580 @@
+#include "Internal.hpp"
+
+using namespace GView::App;
+using namespace GView::Utils::CharacterEncoding;
+using namespace AppCUI::Input;
+
+constexpr int32 BTN_ID_SEARCH = 1;
+constexpr int32 BTN_ID_GOTO   = 2;
+constexpr int32 BTN_ID_CLOSE  = 3;
+
+constexpr std::string_view SEARCH_TYPES  = "Text (any encoding),Text (ASCII),Hex (separate patterns with |),Regular expression";
+constexpr uint32 SEARCH_TYPE_TEXT        = 0;
+constexpr uint32 SEARCH_TYPE_ASCII       = 1;
+constexpr uint32 SEARCH_TYPE_HEX         = 2;
+constexpr uint32 SEARCH_TYPE_REGEX       = 3;
+constexpr std::string_view SEARCH_SCOPES = "All open windows,Folder (recursively)";
+constexpr uint32 SEARCH_SCOPE_WINDOWS    = 0;
+constexpr uint32 SEARCH_SCOPE_FOLDER     = 1;
+
+constexpr uint64 CHUNK_SIZE      = 0x2000000; // 32 MB ; larger objects are split in several tasks (that can be stolen)
+constexpr uint32 FILE_CACHE_SIZE = 0x100000;  // 1 MB (only used for files that can not be memory mapped)
+constexpr size_t MAX_RESULTS     = 100000;
+constexpr size_t FLUSH_RESULTS   = 256; // a task publishes its results in batches
+constexpr uint32 CONTEXT_BYTES   = 16;  // bytes shown before and after a match
+constexpr uint32 MAX_SHOWN_MATCH = 48;
+constexpr uint32 NO_SOURCE       = 0xFFFFFFFF;
+constexpr uint64 NO_RESULT       = 0xFFFFFFFFFFFFFFFFULL;
+
+namespace
+{
+// a file from a folder gets a source index when its first match is published
+struct FileSource
+{
+    std::filesystem::path path;
+    uint32 index;
+};
+struct SearchContext
+{
+    GView::Utils::WorkStealingPool pool;
+    const GView::Utils::Searcher* searcher;
+    uint32 overlap; // a match that starts in a chunk may end in the next one
+    std::atomic<bool> cancel;
+    std::atomic<uint64> searchedBytes, filesCount, matchesCount;
+    std::atomic<uint32> errors;
+    std::mutex lock; // guards 'sources', 'found' and the index of the file sources
+    std::vector<GlobalSearchSource>& sources;
+    std::vector<GlobalSearchResult> found; // published, but not listed yet
+
+    SearchContext(std::vector<GlobalSearchSource>& s) : searcher(nullptr), overlap(0), sources(s)
+    {
+        cancel        = false;
+        searchedBytes = 0;
+        filesCount    = 0;
+        matchesCount  = 0;
+        errors        = 0;
+    }
+};
+
+void BuildContext(GView::Utils::DataCache& cache, uint64 offset, uint32 size, std::string& context)
+{
+    // before[match]after ; the bytes are read with ReadDirect (the cache is used by the search at the same time)
+    uint8 buf[CONTEXT_BYTES * 2 + MAX_SHOWN_MATCH];
+    const auto shown = std::min<uint32>(size, MAX_SHOWN_MATCH);
+    const auto start = offset > CONTEXT_BYTES ? offset - CONTEXT_BYTES : 0;
+    const auto end   = std::min<uint64>(offset + shown + CONTEXT_BYTES, cache.GetSize());
+    const auto len   = (uint32) (end - start);
+    context.clear();
+    if (!cache.ReadDirect(start, buf, len))
+        return;
+    for (uint32 tr = 0; tr < len; tr++)
+    {
+        const auto pos = start + tr;
+        if (pos == offset)
+            context.push_back('[');
+        context.push_back(((buf[tr] >= 32) && (buf[tr] < 127)) ? (char) buf[tr] : '.');
+        if (pos + 1 == offset + shown)
+        {
+            if (shown < size)
+                context += "...";
+            context.push_back(']');
+        }
+    }
+}
+void Publish(SearchContext* ctx, std::vector<GlobalSearchResult>& results, const std::shared_ptr<FileSource>& file)
+{
+    if (results.empty())
+        return;
+    std::lock_guard<std::mutex> guard(ctx->lock);
+    if (file)
+    {
+        if (file->index == NO_SOURCE)
+        {
+            file->index = (uint32) ctx->sources.size();
+            ctx->sources.push_back({ file->path, file->path.u16string(), nullptr });
+        }
+        for (auto& r : results)
+            r.source = file->index;
+    }
+    for (auto& r : results)
+    {
+        if (ctx->matchesCount >= MAX_RESULTS)
+        {
+            ctx->cancel = true;
+            break;
+        }
+        ctx->found.push_back(std::move(r));
+        ctx->matchesCount++;
+    }
+    results.clear();
+}
+// matches that start in [offset, offset + size) ; the search goes 'overlap' bytes further for the matches that cross the end
+void SearchChunk(
+      SearchContext* ctx,
+      GView::Utils::DataCache& cache,
+      uint64 offset,
+      uint64 size,
+      uint32 source,
+      const std::shared_ptr<FileSource>& file)
+{
+    const auto end = offset + size;
+    const auto len = std::min<uint64>(size + ctx->overlap, cache.GetSize() - offset);
+    std::vector<GlobalSearchResult> results;
+    const auto ok = ctx->searcher->Search(
+          cache,
+          offset,
+          len,
+          [&](const GView::Utils::SearchMatch& m)
+          {
+              if (m.offset >= end)
+                  return false;
+              results.push_back({ m.offset, m.size, source, std::string() });
+              BuildContext(cache, m.offset, m.size, results.back().context);
+              if (results.size() >= FLUSH_RESULTS)
+                  Publish(ctx, results, file);
+              return !ctx->cancel.load(std::memory_order_relaxed);
+          },
+          &ctx->cancel);
+    Publish(ctx, results, file);
+    ctx->searchedBytes += size;
+    if ((!ok) && (!ctx->cancel))
+        ctx->errors++;
+}
+void SearchObjectChunk(SearchContext* ctx, Reference<GView::Object> obj, uint64 offset, uint32 source)
+{
+    if (ctx->cancel)
+        return;
+    auto reader = obj->CreateReader();
+    if (!reader)
+    {
+        ctx->errors++;
+        return;
+    }
+    SearchChunk(ctx, *reader, offset, std::min<uint64>(CHUNK_SIZE, reader->GetSize() - offset), source, nullptr);
+}
+// empty files are not loaded in the cache (there is nothing to search in them)
+bool OpenFile(const std::filesystem::path& path, GView::Utils::DataCache& cache, uint64& size)
+{
+    auto f = std::make_unique<AppCUI::OS::File>();
+    if (!f->OpenRead(path))
+        return false;
+    size = f->GetSize();
+    return (size == 0) || (cache.Init(std::move(f), path, FILE_CACHE_SIZE));
+}
+void SearchFileChunk(SearchContext* ctx, std::shared_ptr<FileSource> file, uint64 offset)
+{
+    if (ctx->cancel)
+        return;
+    GView::Utils::DataCache cache;
+    uint64 size = 0;
+    if (!OpenFile(file->path, cache, size))
+    {
+        ctx->errors++;
+        return;
+    }
+    if (offset < size)
+        SearchChunk(ctx, cache, offset, std::min<uint64>(CHUNK_SIZE, size - offset), NO_SOURCE, file);
+}
+void SearchFile(SearchContext* ctx, std::filesystem::path path, uint32 worker)
+{
+    if (ctx->cancel)
+        return;
+    auto file = std::make_shared<FileSource>(FileSource{ std::move(path), NO_SOURCE });
+    GView::Utils::DataCache cache;
+    uint64 size = 0;
+    ctx->filesCount++;
+    if (!OpenFile(file->path, cache, size))
+    {
+        ctx->errors++;
+        return;
+    }
+    if (size == 0)
+        return;
+    // the rest of a large file is queued on this worker (idle workers steal it)
+    for (auto offset = CHUNK_SIZE; offset < size; offset += CHUNK_SIZE)
+        ctx->pool.Push([ctx, file, offset](uint32) { SearchFileChunk(ctx, file, offset); }, worker);
+    SearchChunk(ctx, cache, 0, std::min<uint64>(CHUNK_SIZE, size), NO_SOURCE, file);
+}
+void SearchFolder(SearchContext* ctx, std::filesystem::path path, uint32 worker)
+{
+    if (ctx->cancel)
+        return;
+    // every folder is a task => the enumeration of a large tree is spread over all the workers as well
+    std::error_code ec;
+    for (auto it = std::filesystem::directory_iterator(path, std::filesystem::directory_options::skip_permission_denied, ec);
+         (!ec) && (it != std::filesystem::directory_iterator());
+         it.increment(ec))
+    {
+        if (ctx->cancel)
+            return;
+        std::error_code typeError;
+        if (it->is_symlink(typeError))
+            continue; // avoids cycles
+        if (it->is_directory(typeError))
+            ctx->pool.Push([ctx, p = it->path()](uint32 w) { SearchFolder(ctx, p, w); }, worker);
+        else if (it->is_regular_file(typeError))
+            ctx->pool.Push([ctx, p = it->path()](uint32 w) { SearchFile(ctx, p, w); }, worker);
+    }
+    if (ec)
+        ctx->errors++;
+}
+} // namespace
+
+GlobalSearchData::GlobalSearchData()
+{
+    this->typeIndex      = SEARCH_TYPE_TEXT;
+    this->scopeIndex     = SEARCH_SCOPE_WINDOWS;
+    this->matchCase      = false;
+    this->truncated      = false;
+    this->selectedResult = 0;
+}
+
+GlobalSearchDialog::GlobalSearchDialog(Reference<GlobalSearchData> _search, const std::u16string_view& currentFolder)
+    : Window("Search", "d:c,w:120,h:32", WindowFlags::ProcessReturn | WindowFlags::Sizeable), search(_search)
+{
+    Factory::Label::Create(this, "&Pattern", "x:1,y:1,w:8");
+    Factory::Label::Create(this, "&Type", "x:1,y:3,w:8");
+    Factory::Label::Create(this, "&Scope", "x:1,y:5,w:8");
+    txPattern   = Factory::TextField::Create(this, std::u16string_view(search->text), "l:10,t:1,r:1,h:1");
+    cbType      = Factory::ComboBox::Create(this, "x:10,y:3,w:40", SEARCH_TYPES);
+    cbMatchCase = Factory::CheckBox::Create(this, "&Match case", "x:53,y:3,w:20");
+    cbScope     = Factory::ComboBox::Create(this, "x:10,y:5,w:40", SEARCH_SCOPES);
+    txFolder    = Factory::TextField::Create(this, std::u16string_view(search->folder), "l:53,t:5,r:1,h:1");
+    lbStatus    = Factory::Label::Create(this, "", "l:1,t:7,r:1,h:1");
+    lst         = Factory::ListView::Create(
+          this,
+          "l:1,t:8,r:1,b:3",
+          { "n:Object,a:l,w:40", "n:Offset,a:r,w:18", "n:Size,a:r,w:8", "n:Context,a:l,w:120" },
+          ListViewFlags::None);
+    txPattern->SetHotKey('P');
+    cbType->SetHotKey('T');
+    cbScope->SetHotKey('S');
+    cbType->SetCurentItemIndex(search->typeIndex);
+    cbScope->SetCurentItemIndex(search->scopeIndex);
+    cbMatchCase->SetChecked(search->matchCase);
+    // the folder of the current window (if any) is the default folder
+    if (!currentFolder.empty())
+    {
+        txFolder->SetText(currentFolder);
+        if (search->results.empty())
+            cbScope->SetCurentItemIndex(SEARCH_SCOPE_FOLDER);
+    }
+    UpdateControls();
+
+    Factory::Button::Create(this, "&Search", "l:40,b:0,w:13", BTN_ID_SEARCH);
+    Factory::Button::Create(this, "&Go to", "l:55,b:0,w:13", BTN_ID_GOTO);
+    Factory::Button::Create(this, "&Close", "l:70,b:0,w:13", BTN_ID_CLOSE);
+
+    // the results of the previous search
+    for (size_t idx = 0; idx < search->results.size(); idx++)
+        AddResultItem(idx);
+    UpdateStatus(search->results.empty() ? nullptr : "Previous search");
+    txPattern->SetFocus();
+}
+void GlobalSearchDialog::UpdateControls()
+{
+    cbMatchCase->SetEnabled(cbType->GetCurrentItemIndex() != SEARCH_TYPE_HEX);
+    txFolder->SetEnabled(cbScope->GetCurrentItemIndex() == SEARCH_SCOPE_FOLDER);
+}
+void GlobalSearchDialog::UpdateStatus(const char* state)
+{
+    LocalString<128> tmp;
+    if (state == nullptr)
+        tmp.Clear();
+    else if (search->truncated)
+        tmp.Format("%s: %llu matches (stopped after the first %llu)", state, (uint64) search->results.size(), (uint64) MAX_RESULTS);
+    else
+        tmp.Format("%s: %llu matches in %llu objects", state, (uint64) search->results.size(), (uint64) search->sources.size());
+    lbStatus->SetText(tmp);
+}
+void GlobalSearchDialog::AddResultItem(size_t index)
+{
+    LocalString<32> tmp;
+    NumericFormatter n;
+    const auto& r = search->results[index];
+    auto item     = lst->AddItem(search->sources[r.source].name);
+    item.SetText(1, n.ToString(r.offset, { NumericFormatFlags::HexPrefix, 16 }));
+    item.SetText(2, tmp.Format("%u", r.size));
+    item.SetText(3, r.context);
+    item.SetData((uint64) index);
+}
+bool GlobalSearchDialog::PrepareSearcher(const GView::Utils::Searcher*& searcher)
+{
+    LocalUnicodeStringBuilder<256> text;
+    if ((text.Set(txPattern->GetText()) == false) || (text.Len() == 0))
+    {
+        Dialogs::MessageBox::ShowError("Error", "Please write a pattern to search for !");
+        txPattern->SetFocus();
+        return false;
+    }
+
+    const auto type       = cbType->GetCurrentItemIndex();
+    const auto ignoreCase = !cbMatchCase->IsChecked();
+    engine.Clear();
+    regex.Clear();
+    if (type == SEARCH_TYPE_REGEX)
+    {
+        // the expression is matched against bytes => non ASCII characters are searched as their UTF-8 sequence
+        std::string pattern;
+        LocalString<256> error;
+        EncodedCharacter ec;
+        for (auto ch : text.ToStringView())
+        {
+            const auto bytes = ec.Encode(ch, Encoding::UTF8);
+            pattern.append((const char*) bytes.GetData(), bytes.GetLength());
+        }
+        if (regex.Compile(pattern, ignoreCase, error) == false)
+        {
+            Dialogs::MessageBox::ShowError("Error", error);
+            txPattern->SetFocus();
+            return false;
+        }
+        searcher = &regex;
+    }
+    else if (type == SEARCH_TYPE_HEX)
+    {
+        LocalString<256> hex;
+        if (hex.Set(txPattern->GetText()) == false)
+        {
+            Dialogs::MessageBox::ShowError("Error", "Invalid hex pattern (expecting ascii characters) !");
+            txPattern->SetFocus();
+            return false;
+        }
+        std::string_view patterns = hex.ToStringView();
+        while (!patterns.empty())
+        {
+            const auto next = patterns.find('|');
+            if (engine.AddHexPattern(patterns.substr(0, next)) == false)
+            {
+                Dialogs::MessageBox::ShowError(
+                      "Error", "Invalid hex pattern (expecting hex pairs or ?? for any byte, like `4D 5A ?? 00`) !");
+                txPattern->SetFocus();
+                return false;
+            }
+            patterns = next == std::string_view::npos ? std::string_view() : patterns.substr(next + 1);
+        }
+        searcher = &engine;
+    }
+    else
+    {
+        bool result;
+        if (type == SEARCH_TYPE_ASCII)
+            result = engine.AddTextPattern(text.ToStringView(), Encoding::Ascii, ignoreCase);
+        else
+            result = engine.AddTextPattern(text.ToStringView(), Encoding::UTF8, ignoreCase) &&
+                     engine.AddTextPattern(text.ToStringView(), Encoding::Unicode16LE, ignoreCase) &&
+                     engine.AddTextPattern(text.ToStringView(), Encoding::Unicode16BE, ignoreCase);
+        if (result == false)
+        {
+            Dialogs::MessageBox::ShowError("Error", "The text can not be searched with the selected encoding (or it is too long) !");
+            txPattern->SetFocus();
+            return false;
+        }
+        searcher = &engine;
+    }
+
+    search->text      = text.ToStringView();
+    search->typeIndex = type;
+    search->matchCase = !ignoreCase;
+    return true;
+}
+void GlobalSearchDialog::Search()
+{
+    const GView::Utils::Searcher* searcher = nullptr;
+    if (!PrepareSearcher(searcher))
+        return;
+
+    LocalUnicodeStringBuilder<512> folder;
+    const auto scope = cbScope->GetCurrentItemIndex();
+    if (scope == SEARCH_SCOPE_FOLDER)
+    {
+        std::error_code ec;
+        if ((folder.Set(txFolder->GetText()) == false) || (folder.Len() == 0) ||
+            (!std::filesystem::is_directory(std::filesystem::path(folder.ToStringView()), ec)))
+        {
+            Dialogs::MessageBox::ShowError("Error", "Please write the path of an existing folder !");
+            txFolder->SetFocus();
+            return;
+        }
+        search->folder = folder.ToStringView();
+    }
+    search->scopeIndex = scope;
+    search->sources.clear();
+    search->results.clear();
+    search->truncated = false;
+    lst->DeleteAllItems();
+
+    SearchContext ctx(search->sources);
+    ctx.searcher = searcher;
+    ctx.overlap  = searcher->GetMaxMatchSize() - 1;
+    CHECKRET(ctx.pool.Start(), "Fail to start the search workers !");
+
+    if (scope == SEARCH_SCOPE_WINDOWS)
+    {
+        // objects of the open windows are split in chunks ; the sources are known before the search starts
+        const auto count = GView::App::GetObjectsCount();
+        for (uint32 idx = 0; idx < count; idx++)
+        {
+            auto obj = GView::App::GetObject(idx);
+            if (!obj.IsValid())
+                continue;
+            const auto source = (uint32) search->sources.size();
+            const auto size   = obj->GetData().GetSize();
+            search->sources.push_back({ std::filesystem::path(obj->GetPath()), std::u16string(obj->GetName()), &obj->GetData() });
+            ctx.filesCount++;
+            for (uint64 offset = 0; offset < size; offset += CHUNK_SIZE)
+                ctx.pool.Push([c = &ctx, obj, offset, source](uint32) { SearchObjectChunk(c, obj, offset, source); });
+        }
+    }
+    else
+    {
+        ctx.pool.Push([c = &ctx, p = std::filesystem::path(folder.ToStringView())](uint32 w) { SearchFolder(c, p, w); });
+    }
+
+    // results are listed while the workers are searching
+    LocalString<128> tmp;
+    std::vector<GlobalSearchResult> found;
+    auto flush = [&]()
+    {
+        // the workers may add new sources (files from a folder) => the list is updated under the same lock
+        std::lock_guard<std::mutex> guard(ctx.lock);
+        std::swap(found, ctx.found);
+        for (auto& r : found)
+        {
+            search->results.push_back(std::move(r));
+            AddResultItem(search->results.size() - 1);
+        }
+        found.clear();
+    };
+    ProgressStatus::Init("Searching ...");
+    while (!ctx.pool.Wait(std::chrono::milliseconds(100)))
+    {
+        flush();
+        const auto bytes = ctx.searchedBytes.load(std::memory_order_relaxed);
+        tmp.Format("%llu objects, %llu MB, %llu matches", (uint64) ctx.filesCount.load(), bytes >> 20, (uint64) search->results.size());
+        if (ProgressStatus::Update(bytes, tmp))
+            ctx.cancel = true;
+    }
+    const auto canceled = ctx.cancel && (ctx.matchesCount < MAX_RESULTS);
+    ctx.pool.Stop();
+    flush();
+
+    search->truncated = ctx.matchesCount >= MAX_RESULTS;
+    if (canceled)
+        UpdateStatus("Canceled");
+    else if (ctx.errors > 0)
+        UpdateStatus(tmp.Format("Done (%u objects could not be read)", ctx.errors.load()));
+    else
+        UpdateStatus("Done");
+    lst->SetFocus();
+}
+void GlobalSearchDialog::Validate()
+{
+    const auto idx = lst->GetCurrentItem().GetData(NO_RESULT);
+    if (idx >= search->results.size())
+        return;
+    search->selectedResult = (size_t) idx;
+    Exit(Dialogs::Result::Ok);
+}
+bool GlobalSearchDialog::OnEvent(Reference<Control> control, Event eventType, int ID)
+{
+    switch (eventType)
+    {
+    case Event::ButtonClicked:
+        switch (ID)
+        {
+        case BTN_ID_SEARCH:
+            Search();
+            return true;
+        case BTN_ID_GOTO:
+            Validate();
+            return true;
+        case BTN_ID_CLOSE:
+            Exit(Dialogs::Result::Cancel);
+            return true;
+        }
+        break;
+    case Event::ComboBoxSelectedItemChanged:
+        UpdateControls();
+        return true;
+    case Event::ListViewItemPressed:
+        Validate();
+        return true;
+    case Event::WindowAccept:
+        if (lst->HasFocus())
+            Validate();
+        else
+            Search();
+        return true;
+    case Event::WindowClose:
+        Exit(Dialogs::Result::Cancel);
+        return true;
+    }
+    return false;
+}
+
+void Instance::ShowGlobalSearch()
+{
+    // a folder window => its path is the default folder
+    std::u16string folder;
+    auto dsk = AppCUI::Application::GetDesktop();
+    if ((dsk.IsValid()) && (dsk->GetChildrenCount() > 0))
+    {
+        auto focused = dsk->GetFocusedChild();
+        if (focused.IsValid())
+        {
+            auto obj = focused.ToObjectRef<FileWindow>()->GetObject();
+            if (obj->GetObjectType() == GView::Object::Type::Folder)
+                folder = obj->GetPath();
+        }
+    }
+
+    GlobalSearchDialog dlg(&this->globalSearch, folder);
+    if (dlg.Show() != Dialogs::Result::Ok)
+        return;
+    if (GoToGlobalSearchResult(this->globalSearch.results[this->globalSearch.selectedResult]) == false)
+        ShowErrors();
+}
+bool Instance::GoToGlobalSearchResult(const GlobalSearchResult& result)
+{
+    CHECK(result.source < this->globalSearch.sources.size(), false, "Invalid search result !");
+    const auto& src = this->globalSearch.sources[result.source];
+    auto dsk        = AppCUI::Application::GetDesktop();
+    CHECK(dsk.IsValid(), false, "Fail to get Desktop object from AppCUI !");
+
+    // the window that was searched or, for files, any window with the same file
+    Reference<FileWindow> win;
+    const auto count = dsk->GetChildrenCount();
+    for (uint32 idx = 0; (idx < count) && (!win.IsValid()); idx++)
+    {
+        auto w   = dsk->GetChild(idx).ToObjectRef<FileWindow>();
+        auto obj = w->GetObject();
+        if (src.data)
+        {
+            if (&obj->GetData() == src.data)
+                win = w;
+        }
+        else if ((obj->GetObjectType() == GView::Object::Type::File) && (std::filesystem::path(obj->GetPath()) == src.path))
+            win = w;
+    }
+    if (!win.IsValid())
+    {
+        if (src.data)
+        {
+            errList.AddError("The window of `%s` was closed !", src.path.u8string().c_str());
+            RETURNERROR(false, "The window of `%s` was closed !", src.path.u8string().c_str());
+        }
+        CHECK(AddFileWindow(src.path, OpenMethod::BestMatch, ""), false, "Fail to open: %s", src.path.u8string().c_str());
+        // the new window is the last one
+        win = dsk->GetChild(dsk->GetChildrenCount() - 1).ToObjectRef<FileWindow>();
+        CHECK(win.IsValid(), false, "");
+    }
+
+    win->SetFocus();
+    auto view = win->GetCurrentView();
+    CHECK(view.IsValid(), false, "");
+    view->GoTo(result.offset);
+    view->Select(result.offset, result.size);
+    view->SetFocus();
+    return true;
+}
@@ -0,0 +1,117 @@
+#include "Internal.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace GView::App;
+using namespace AppCUI::Utils;
+
+// confidence of an identification = what matched for the selected plugin (sync this with the help of the identify command)
+constexpr uint32 CONFIDENCE_MAGIC     = 90; // bytes at a fixed offset (magic) matched and the plugin validated the content
+constexpr uint32 CONFIDENCE_TEXT      = 60; // a text pattern (startswith / linestartswith) matched and the plugin validated it
+constexpr uint32 CONFIDENCE_EXTENSION = 30; // only the extension matched (the plugin validated the content by itself)
+constexpr uint32 CONFIDENCE_BONUS     = 10; // added when both the extension and a pattern matched
+
+bool Instance::InitHeadless()
+{
+    // no AppCUI initialization => settings are read directly from the configuration file
+    this->startTime = std::chrono::steady_clock::now();
+    IniObject ini;
+    CHECK(ini.CreateFromFile(AppCUI::Application::GetAppSettingsFile()), false, "Fail to load the configuration file (gview.ini) !");
+    auto settingsStart               = std::chrono::steady_clock::now();
+    this->startupTrace.frameworkInit = std::chrono::duration<double, std::milli>(settingsStart - this->startTime).count();
+    this->typePlugins.reserve(128);
+    CHECK(LoadSettings(&ini), false, "Fail to load settings !");
+    this->startupTrace.settings = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - settingsStart).count();
+    this->defaultPlugin.Init();
+
+    // plugins are loaded upfront => Identify does not change any plugin and can be called from multiple threads
+    for (auto& p : this->typePlugins)
+    {
+        if (!p.Load())
+            errList.AddWarning("Fail to load type plugin (%s)", p.GetName().data());
+    }
+    return true;
+}
+void Instance::Identify(const std::filesystem::path& path, OpenMethod method, IdentifyResult& result)
+{
+    const auto start    = std::chrono::steady_clock::now();
+    result.typeName     = "";
+    result.confidence   = 0;
+    result.matchesCount = 0;
+    result.success      = false;
+    result.textDecoded  = false;
+
+    uint8 buffer[IDENTIFY_BUFFER_SIZE];
+    uint32 bytesRead = 0;
+    AppCUI::OS::File f;
+    if (f.OpenRead(path))
+    {
+        const auto toRead = (uint32) std::min<uint64>(f.GetSize(), IDENTIFY_BUFFER_SIZE);
+        result.success    = (toRead == 0) || (f.ReadBuffer(buffer, toRead, bytesRead));
+        f.Close();
+    }
+    if (result.success)
+    {
+        const auto buf      = BufferView(buffer, bytesRead);
+        auto tp             = GView::Type::Matcher::TextParser(buf);
+        auto extHash        = GView::Type::Plugin::ExtensionToHash(path.extension().u16string());
+        const auto maxCount = method == OpenMethod::FirstMatch ? 1U : 0xFFFFFFFFU; // BestMatch => all of them are counted
+        GView::Type::Matcher::SignatureMatches candidates;
+        this->signatures.Match(buf, tp, candidates);
+
+        // same search as the one the GUI does before it shows a dialog
+        TypePluginsMatch match;
+        MatchTypePlugins(buf, tp, extHash, candidates, maxCount, match);
+        result.matchesCount = match.count;
+        if (match.first != nullptr)
+        {
+            result.typeName = match.first->GetName();
+            // the other plugins that validated the content are reported through 'matchesCount' (they do not change how
+            // much evidence there is for the selected one)
+            if (!match.byContent)
+                result.confidence = CONFIDENCE_EXTENSION;
+            else
+                result.confidence = (match.byMagic ? CONFIDENCE_MAGIC : CONFIDENCE_TEXT) + (match.byExtension ? CONFIDENCE_BONUS : 0);
+        }
+        result.textDecoded = tp.WasDecoded();
+    }
+    result.duration = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+bool Instance::IdentifyFiles(
+      const std::vector<std::filesystem::path>& files,
+      uint32 threadsCount,
+      OpenMethod method,
+      std::function<void(const std::filesystem::path& path, const IdentifyResult& result)> onResult)
+{
+    CHECK((method == OpenMethod::FirstMatch) || (method == OpenMethod::BestMatch), false, "Only FirstMatch and BestMatch are supported !");
+    if (threadsCount == 0)
+        threadsCount = std::max<>(std::thread::hardware_concurrency(), 1U);
+    threadsCount = (uint32) std::min<size_t>(threadsCount, std::max<size_t>(files.size(), 1));
+
+    std::atomic<size_t> next = 0;
+    std::mutex lock;
+    auto worker = [&]()
+    {
+        IdentifyResult result;
+        for (auto idx = next++; idx < files.size(); idx = next++)
+        {
+            Identify(files[idx], method, result);
+            if (onResult)
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                onResult(files[idx], result);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadsCount - 1);
+    for (uint32 tr = 1; tr < threadsCount; tr++)
+        threads.emplace_back(worker);
+    worker(); // the current thread is also a worker
+    for (auto& t : threads)
+        t.join();
+    return true;
+}
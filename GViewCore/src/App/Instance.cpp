@@ -24,6 +24,8 @@ constexpr _MenuCommand_ menuFileList[] = {
     { "Open &process", MenuCommands::OPEN_PID, Key::None },
     { "Open process &tree", MenuCommands::OPEN_PROCESS_TREE, Key::None },
     { "", 0, Key::None },
+    { "&Search in all windows or in a folder", MenuCommands::SEARCH_ALL, Key::None },
+    { "", 0, Key::None },
     { "E&xit", MenuCommands::EXIT_GVIEW, Key::Shift | Key::Escape },
 };
 constexpr _MenuCommand_ menuWindowList[] = {
@@ -75,17 +77,25 @@ Instance::Instance()
     this->mnuWindow         = nullptr;
     this->mnuHelp           = nullptr;
     this->mnuFile           = nullptr;
+    this->startTime         = std::chrono::steady_clock::now();
+    this->startupTrace      = {};
 }
-bool Instance::LoadSettings()
+bool Instance::LoadSettings(AppCUI::Utils::IniObject* ini)
 {
-    auto ini = AppCUI::Application::GetAppSettings();
     CHECK(ini, false, "");
     CHECK(ini->GetSectionsCount() > 0, false, "");
+
+    // type plugins are read from the registry cache (if gview.ini and the plugins did not change since it was created)
+    GView::Type::PluginRegistry registry;
+    auto registryValid                   = registry.Init(AppCUI::Application::GetAppSettingsFile());
+    auto typeErrors                      = false;
+    this->startupTrace.registryCacheUsed = registryValid && registry.Load(this->typePlugins);
+
     // check plugins
     for (auto section : *ini)
     {
         auto sectionName = section.GetName();
-        if (String::StartsWith(sectionName, "type.", true))
+        if ((!this->startupTrace.registryCacheUsed) && (String::StartsWith(sectionName, "type.", true)))
         {
             GView::Type::Plugin p;
             if (p.Init(section))
@@ -95,6 +105,7 @@ bool Instance::LoadSettings()
             else
             {
                 errList.AddWarning("Fail to load type plugin (%s)", sectionName.data());
+                typeErrors = true;
             }
         }
         if (String::StartsWith(sectionName, "generic.", true))
@@ -111,8 +122,14 @@ bool Instance::LoadSettings()
         }
     }
 
+    // a registry is not created if some sections are invalid (so that the warnings are shown every time)
+    if ((registryValid) && (!this->startupTrace.registryCacheUsed) && (!typeErrors))
+        registry.Save(this->typePlugins);
+
     // sort all plugins based on their priority
     std::sort(this->typePlugins.begin(), this->typePlugins.end());
+    // compile all patterns (plugins are identified by their index in typePlugins => must be done after sorting)
+    this->signatures.Build(this->typePlugins);
 
     // read instance settings
     auto sect               = ini->GetSection("GView");
@@ -138,14 +155,20 @@ bool Instance::BuildMainMenus()
 
 bool Instance::Init()
 {
+    // in FPS mode the controls are asked (OnFrameUpdate) if they need to be repainted even when there is no input => the views
+    // show the work done in background (a followed file that grew) without waiting for a key or a mouse event
     InitializationData initData;
     initData.Flags = InitializationFlags::Menu | InitializationFlags::CommandBar | InitializationFlags::LoadSettingsFile |
-                     InitializationFlags::AutoHotKeyForWindow;
+                     InitializationFlags::AutoHotKeyForWindow | InitializationFlags::EnableFPSMode;
 
+    this->startTime = std::chrono::steady_clock::now();
     CHECK(AppCUI::Application::Init(initData), false, "Fail to initialize AppCUI framework !");
+    auto settingsStart               = std::chrono::steady_clock::now();
+    this->startupTrace.frameworkInit = std::chrono::duration<double, std::milli>(settingsStart - this->startTime).count();
     // reserve some space fo type
     this->typePlugins.reserve(128);
-    CHECK(LoadSettings(), false, "Fail to load settings !");
+    CHECK(LoadSettings(AppCUI::Application::GetAppSettings()), false, "Fail to load settings !");
+    this->startupTrace.settings = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - settingsStart).count();
     CHECK(BuildMainMenus(), false, "Fail to create bundle menus !");
     this->defaultPlugin.Init();
     // set up handlers
@@ -214,34 +237,51 @@ Reference<GView::Type::Plugin> Instance::IdentifyTypePlugin_Select(
         return dlg.GetSelectedPlugin(&this->defaultPlugin);
     return nullptr;
 }
-Reference<GView::Type::Plugin> Instance::IdentifyTypePlugin_FirstMatch(
-      AppCUI::Utils::BufferView buf, GView::Type::Matcher::TextParser& textParser, uint64 extensionHash)
+void Instance::MatchTypePlugins(
+      AppCUI::Utils::BufferView buf,
+      GView::Type::Matcher::TextParser& textParser,
+      uint64 extensionHash,
+      GView::Type::Matcher::SignatureMatches& candidates,
+      uint32 maxCount,
+      TypePluginsMatch& match)
 {
-    // check for extension first
-    if (extensionHash != 0)
+    match = {};
+    // the plugins that match the extension are checked in the first pass and the content candidates (computed for all the
+    // plugins at once) in the second one => a plugin that matches both is validated (and counted) only once
+    for (uint32 pass = 0; (pass < 2) && (match.count < maxCount); pass++)
     {
-        for (auto& pType : this->typePlugins)
+        for (uint32 idx = 0; (idx < (uint32) this->typePlugins.size()) && (match.count < maxCount); idx++)
         {
-            if (pType.MatchExtension(extensionHash))
+            auto& pType          = this->typePlugins[idx];
+            const auto extension = (extensionHash != 0) && (pType.MatchExtension(extensionHash));
+            if (extension != (pass == 0))
+                continue;
+            // content is checked only when needed (text patterns convert the buffer to UTF-16)
+            if ((pass == 1) && (!candidates.IsCandidate(idx)))
+                continue;
+            if (!pType.IsOfType(buf, textParser))
+                continue;
+            if (match.first == nullptr)
             {
-                if (pType.IsOfType(buf, textParser))
-                    return &pType;
+                match.first       = &pType;
+                match.byExtension = extension;
+                match.byContent   = (!extension) || (candidates.IsCandidate(idx));
+                match.byMagic     = candidates.IsMagicCandidate(idx);
             }
+            match.count++;
         }
     }
-
-    // check the content
-    for (auto& pType : this->typePlugins)
-    {
-        if (pType.MatchContent(buf, textParser))
-        {
-            if (pType.IsOfType(buf, textParser))
-                return &pType;
-        }
-    }
-
+}
+Reference<GView::Type::Plugin> Instance::IdentifyTypePlugin_FirstMatch(
+      AppCUI::Utils::BufferView buf,
+      GView::Type::Matcher::TextParser& textParser,
+      uint64 extensionHash,
+      GView::Type::Matcher::SignatureMatches& candidates)
+{
+    TypePluginsMatch match;
+    MatchTypePlugins(buf, textParser, extensionHash, candidates, 1, match);
     // nothing matched => return the default plugin
-    return &this->defaultPlugin;
+    return match.first != nullptr ? match.first : &this->defaultPlugin;
 }
 Reference<GView::Type::Plugin> Instance::IdentifyTypePlugin_BestMatch(
       const AppCUI::Utils::ConstString& name,
@@ -249,44 +289,15 @@ Reference<GView::Type::Plugin> Instance::IdentifyTypePlugin_BestMatch(
       uint64 dataSize,
       AppCUI::Utils::BufferView buf,
       GView::Type::Matcher::TextParser& textParser,
-      uint64 extensionHash)
+      uint64 extensionHash,
+      GView::Type::Matcher::SignatureMatches& candidates)
 {
-    auto plg   = &this->defaultPlugin;
-    auto count = 0;
-    if (extensionHash != 0)
-    {
-        for (auto& pType : this->typePlugins)
-        {
-            if (pType.MatchExtension(extensionHash))
-            {
-                if (pType.IsOfType(buf, textParser))
-                {
-                    count++;
-                    plg = &pType;
-                    if (count > 1) // at least two options
-                        return IdentifyTypePlugin_Select(name, path, dataSize, buf, textParser, extensionHash);
-                }
-            }
-        }
-    }
-
-    // check the content
-    for (auto& pType : this->typePlugins)
-    {
-        if (pType.MatchContent(buf, textParser))
-        {
-            if (pType.IsOfType(buf, textParser))
-            {
-                count++;
-                plg = &pType;
-                if (count > 1) // at least two options
-                    return IdentifyTypePlugin_Select(name, path, dataSize, buf, textParser, extensionHash);
-            }
-        }
-    }
-
+    TypePluginsMatch match;
+    MatchTypePlugins(buf, textParser, extensionHash, candidates, 2, match);
+    if (match.count > 1) // at least two options
+        return IdentifyTypePlugin_Select(name, path, dataSize, buf, textParser, extensionHash);
     // nothing matched => return the default plugin
-    return plg;
+    return match.first != nullptr ? match.first : &this->defaultPlugin;
 }
 Reference<GView::Type::Plugin> Instance::IdentifyTypePlugin(
       const AppCUI::Utils::ConstString& name,
@@ -296,20 +307,19 @@ Reference<GView::Type::Plugin> Instance::IdentifyTypePlugin(
       OpenMethod method,
       std::string_view typeName)
 {
-    auto buf    = cache.Get(0, 0x8800, false);
-    auto bomLen = 0U;
-    auto enc    = GView::Utils::CharacterEncoding::AnalyzeBufferForEncoding(buf, true, bomLen);
-    auto text   = enc != GView::Utils::CharacterEncoding::Encoding::Binary ? GView::Utils::CharacterEncoding::ConvertToUnicode16(buf)
-                                                                           : GView::Utils::UnicodeString();
-    auto tp     = GView::Type::Matcher::TextParser(text.text, text.size);
-    auto sz     = cache.GetSize();
+    auto buf = cache.Get(0, IDENTIFY_BUFFER_SIZE, false);
+    auto tp  = GView::Type::Matcher::TextParser(buf); // text is converted only if a text pattern needs it
+    auto sz  = cache.GetSize();
+    GView::Type::Matcher::SignatureMatches candidates;
 
     switch (method)
     {
     case OpenMethod::FirstMatch:
-        return IdentifyTypePlugin_FirstMatch(buf, tp, extensionHash);
+        this->signatures.Match(buf, tp, candidates);
+        return IdentifyTypePlugin_FirstMatch(buf, tp, extensionHash, candidates);
     case OpenMethod::BestMatch:
-        return IdentifyTypePlugin_BestMatch(name, path, sz, buf, tp, extensionHash);
+        this->signatures.Match(buf, tp, candidates);
+        return IdentifyTypePlugin_BestMatch(name, path, sz, buf, tp, extensionHash, candidates);
     case OpenMethod::Select:
         return IdentifyTypePlugin_Select(name, path, sz, buf, tp, extensionHash);
     case OpenMethod::ForceType:
@@ -321,16 +331,13 @@ Reference<GView::Type::Plugin> Instance::IdentifyTypePlugin(
 }
 bool Instance::Add(
       GView::Object::Type objType,
-      std::unique_ptr<AppCUI::OS::DataObject> data,
+      GView::Utils::DataCache&& cache,
       const AppCUI::Utils::ConstString& name,
       const AppCUI::Utils::ConstString& path,
       uint32 PID,
       OpenMethod method,
       std::string_view typeName)
 {
-    GView::Utils::DataCache cache;
-    CHECK(cache.Init(std::move(data), this->defaultCacheSize), false, "Fail to instantiate cache object");
-
     // extract extension
     LocalUnicodeStringBuilder<256> temp;
     CHECK(temp.Set(path), false, "Fail to get path object");
@@ -386,6 +393,41 @@ bool Instance::AddFolder(const std::filesystem::path& path)
     // error case
     return false;
 }
+bool Instance::AddProcess(uint32 pid)
+{
+    auto process = std::make_unique<GView::Utils::ProcessDataObject>();
+    if (process->Open(pid) == false)
+    {
+        errList.AddError("Fail to open process %u (it does not exist or there are not enough privileges)", pid);
+        RETURNERROR(false, "Fail to open process %u", pid);
+    }
+    auto contentType = GView::Type::ProcessViewPlugin::CreateInstance(pid, process->GetRegionsMap());
+    CHECK(contentType, false, "`CreateInstance` returned a null pointer to a type object !");
+
+    GView::Utils::DataCache cache;
+    CHECK(cache.Init(std::move(process), this->defaultCacheSize), false, "Fail to instantiate cache object");
+
+    LocalString<64> name;
+    name.Format("Process %u", pid);
+    auto win = std::make_unique<FileWindow>(
+          std::make_unique<GView::Object>(
+                GView::Object::Type::Process, std::move(cache), contentType, name.ToStringView(), name.ToStringView(), pid),
+          this,
+          nullptr);
+
+    // instantiate window
+    while (true)
+    {
+        GView::Type::ProcessViewPlugin::PopulateWindow(win.get());
+        win->Start(); // starts the window and set focus
+        auto res = AppCUI::Application::AddWindow(std::move(win));
+        CHECKBK(res != InvalidItemHandle, "Fail to add newly created window to desktop");
+
+        return true;
+    }
+    // error case
+    return false;
+}
 void Instance::ShowErrors()
 {
     if (errList.Empty())
@@ -410,7 +452,10 @@ bool Instance::AddFileWindow(const std::filesystem::path& path, OpenMethod metho
                 errList.AddError("Fail to open file: %s", path.u8string().c_str());
                 RETURNERROR(false, "Fail to open file: %s", path.u8string().c_str());
             }
-            return Add(Object::Type::File, std::move(f), path.filename().u16string(), path.u16string(), 0, method, typeName);
+            // regular files are memory mapped (if possible) => no copies and no cache size limit
+            GView::Utils::DataCache cache;
+            CHECK(cache.Init(std::move(f), path, this->defaultCacheSize), false, "Fail to instantiate cache object");
+            return Add(Object::Type::File, std::move(cache), path.filename().u16string(), path.u16string(), 0, method, typeName);
         }
     }
     catch (std::filesystem::filesystem_error /* e */)
@@ -427,7 +472,35 @@ bool Instance::AddBufferWindow(BufferView buf, const ConstString& name, const Co
         errList.AddError("Fail to open memory buffer of size: %llu", buf.GetLength());
         RETURNERROR(false, "Fail to open memory buffer of size: %llu", buf.GetLength());
     }
-    return Add(Object::Type::MemoryBuffer, std::move(f), name, path, 0, method, typeName);
+    GView::Utils::DataCache cache;
+    CHECK(cache.Init(std::move(f), this->defaultCacheSize), false, "Fail to instantiate cache object");
+    return Add(Object::Type::MemoryBuffer, std::move(cache), name, path, 0, method, typeName);
+}
+bool Instance::AddSubObjectWindow(
+      Reference<GView::Object> parent, uint64 offset, uint64 size, const ConstString& name, OpenMethod method, string_view typeName)
+{
+    CHECK(parent.IsValid(), false, "Expecting a valid parent object !");
+    auto& parentCache = parent->GetData();
+    if ((offset >= parentCache.GetSize()) || (size == 0))
+    {
+        errList.AddError("Invalid range: %llu bytes from offset %llu (object size is %llu)", size, offset, parentCache.GetSize());
+        RETURNERROR(false, "Invalid range: %llu bytes from offset %llu", size, offset);
+    }
+    size = std::min<>(size, parentCache.GetSize() - offset);
+
+    // memory mapped parents => the range is mapped directly from the file
+    // otherwise (or if the file can not be mapped again) => the range is read through the file object of the parent
+    // in both cases nothing is copied and the new object does not depend on the lifetime of its parent
+    GView::Utils::DataCache cache;
+    if ((parentCache.IsMemoryMapped()) && (cache.Init(parentCache, offset, size, this->defaultCacheSize)))
+        return Add(Object::Type::Slice, std::move(cache), name, name, 0, method, typeName);
+    auto reader = parentCache.CreateRangeReader(offset, size);
+    if ((!reader) || (!cache.Init(std::move(reader), this->defaultCacheSize)))
+    {
+        errList.AddError("Fail to create a reader for %llu bytes from offset %llu", size, offset);
+        RETURNERROR(false, "Fail to create a reader for %llu bytes from offset %llu", size, offset);
+    }
+    return Add(Object::Type::Slice, std::move(cache), name, name, 0, method, typeName);
 }
 void Instance::OpenFile()
 {
@@ -438,6 +511,15 @@ void Instance::OpenFile()
             ShowErrors();
     }
 }
+void Instance::OpenProcess()
+{
+    OpenProcessDialog dlg;
+    if (dlg.Show() == Dialogs::Result::Ok)
+    {
+        if (AddProcess(dlg.GetPID()) == false)
+            ShowErrors();
+    }
+}
 void Instance::UpdateCommandBar(AppCUI::Application::CommandBar& commandBar)
 {
     auto idx = GENERIC_PLUGINS_CMDID;
@@ -510,6 +592,12 @@ bool Instance::OnEvent(Reference<Control> control, Event eventType, int ID)
         case MenuCommands::OPEN_FILE:
             OpenFile();
             return true;
+        case MenuCommands::OPEN_PID:
+            OpenProcess();
+            return true;
+        case MenuCommands::SEARCH_ALL:
+            ShowGlobalSearch();
+            return true;
         }
         if ((ID >= GENERIC_PLUGINS_CMDID) && (ID < GENERIC_PLUGINS_CMDID + GENERIC_PLUGINS_FRAME * 1000))
         {
@@ -524,8 +612,18 @@ bool Instance::OnEvent(Reference<Control> control, Event eventType, int ID)
 }
 void Instance::OnStart(Reference<Control> control)
 {
+    if (this->startupTrace.firstPaint == 0)
+    {
+        const auto elapsed            = std::chrono::steady_clock::now() - this->startTime;
+        this->startupTrace.firstPaint = std::chrono::duration<double, std::milli>(elapsed).count();
+    }
     ShowErrors();
 }
+void Instance::GetStartupTrace(StartupTrace& trace)
+{
+    trace = this->startupTrace;
+    GView::Type::Plugin::GetLoadingStats(trace.pluginsLoading, trace.pluginsLoaded);
+}
 //===============================[PROPERTIES]==================================
 bool Instance::GetPropertyValue(uint32 propertyID, PropertyValue& value)
 {
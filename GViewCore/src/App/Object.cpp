@@ -0,0 +1,75 @@
+#include "GView.hpp"
+
+using namespace GView;
+
+constexpr uint32 READER_CACHE_SIZE = 0x100000; // 1 MB
+
+// read-only view over another DataCache (reads go through the thread safe DataCache::ReadDirect)
+class ObjectDataReader : public AppCUI::OS::DataObject
+{
+    GView::Utils::DataCache& source;
+    uint64 size, pos;
+
+  public:
+    ObjectDataReader(GView::Utils::DataCache& src) : source(src), size(src.GetSize()), pos(0)
+    {
+    }
+    bool ReadBuffer(void* buffer, uint32 bufferSize, uint32& bytesRead) override
+    {
+        bytesRead = 0;
+        CHECK(source.ReadDirect(pos, buffer, bufferSize), false, "Fail to read %u bytes from %llu", bufferSize, pos);
+        pos += bufferSize;
+        bytesRead = bufferSize;
+        return true;
+    }
+    bool WriteBuffer(const void* buffer, uint32 bufferSize, uint32& bytesWritten) override
+    {
+        bytesWritten = 0;
+        RETURNERROR(false, "A reader object is read-only !");
+    }
+    uint64 GetSize() override
+    {
+        return size;
+    }
+    uint64 GetCurrentPos() const override
+    {
+        return pos;
+    }
+    bool SetSize(uint64 newSize) override
+    {
+        RETURNERROR(false, "A reader object is read-only !");
+    }
+    bool SetCurrentPos(uint64 newPosition) override
+    {
+        CHECK(newPosition <= size, false, "Invalid position: %llu (size is %llu)", newPosition, size);
+        pos = newPosition;
+        return true;
+    }
+    void Close() override
+    {
+    }
+};
+
+std::unique_ptr<GView::Utils::DataCache> Object::CreateReader()
+{
+    auto reader = std::make_unique<GView::Utils::DataCache>();
+
+    // memory mapped objects (files and slices) => a new view of the same file
+    if ((cache.IsMemoryMapped()) && (reader->Init(cache, 0, cache.GetSize(), READER_CACHE_SIZE)))
+        return reader;
+
+    // files that could not be mapped => a new file handle
+    if ((objectType == Type::File) && (!cache.IsMemoryMapped()))
+    {
+        auto f = std::make_unique<AppCUI::OS::File>();
+        if (f->OpenRead(std::filesystem::path(std::u16string(GetPath()))))
+        {
+            CHECK(reader->Init(std::move(f), READER_CACHE_SIZE), nullptr, "Fail to initialize the reader cache");
+            return reader;
+        }
+    }
+
+    // everything else is read through this object
+    CHECK(reader->Init(std::make_unique<ObjectDataReader>(cache), READER_CACHE_SIZE), nullptr, "Fail to initialize the reader cache");
+    return reader;
+}
@@ -0,0 +1,64 @@
+#include "Internal.hpp"
+
+using namespace GView::App;
+
+constexpr int32 BTN_ID_OK     = 1;
+constexpr int32 BTN_ID_CANCEL = 2;
+
+OpenProcessDialog::OpenProcessDialog() : Window("Open process", "d:c,w:40,h:8", WindowFlags::ProcessReturn), pid(0)
+{
+    Factory::Label::Create(this, "&PID", "x:1,y:1,w:6");
+    txPID = Factory::TextField::Create(this, "", "x:8,y:1,w:28");
+    txPID->SetHotKey('P');
+
+    Factory::Button::Create(this, "&OK", "l:5,b:0,w:13", BTN_ID_OK);
+    Factory::Button::Create(this, "&Cancel", "l:20,b:0,w:13", BTN_ID_CANCEL);
+
+    txPID->SetFocus();
+}
+void OpenProcessDialog::Validate()
+{
+    LocalString<128> tmp;
+    if (tmp.Set(txPID->GetText()) == false)
+    {
+        Dialogs::MessageBox::ShowError("Error", "Invalid PID (expecting ascii characters) !");
+        txPID->SetFocus();
+        return;
+    }
+    auto value = Number::ToUInt32(tmp);
+    if ((!value.has_value()) || (value.value() == 0))
+    {
+        Dialogs::MessageBox::ShowError("Error", "Invalid PID (expecting a positive number) !");
+        txPID->SetFocus();
+        return;
+    }
+    pid = value.value();
+    Exit(Dialogs::Result::Ok);
+}
+bool OpenProcessDialog::OnEvent(Reference<Control> control, Event eventType, int ID)
+{
+    if (eventType == Event::ButtonClicked)
+    {
+        switch (ID)
+        {
+        case BTN_ID_CANCEL:
+            Exit(Dialogs::Result::Cancel);
+            return true;
+        case BTN_ID_OK:
+            Validate();
+            return true;
+        }
+    }
+
+    switch (eventType)
+    {
+    case Event::WindowAccept:
+        Validate();
+        return true;
+    case Event::WindowClose:
+        Exit(Dialogs::Result::Cancel);
+        return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,348 @@
+#include "Internal.hpp"
+
+#include <condition_variable>
+#include <thread>
+
+using namespace GView::App;
+using namespace AppCUI::Input;
+
+constexpr int32 BTN_ID_BROWSE       = 1;
+constexpr int32 BTN_ID_SCAN         = 2;
+constexpr uint64 MAX_RULES_SIZE     = 0x1000000; // 16 MB
+constexpr size_t MAX_LISTED_MATCHES = 10000;
+constexpr uint32 MAX_MATCH_ZONES    = 0x100000;
+constexpr size_t MAX_ZONE_NAME      = 25;
+constexpr uint32 MAX_SHOWN_BYTES    = 64;
+constexpr uint32 MAX_SCAN_WORKERS   = 16;
+constexpr uint32 FOLDER_CACHE_SIZE  = 0x100000; // 1 MB (only used for files that can not be memory mapped)
+constexpr uint64 NO_MATCH_INDEX     = GView::Utils::INVALID_OFFSET;
+
+static const ColorPair ruleColors[] = {
+    ColorPair{ Color::Black, Color::Yellow }, ColorPair{ Color::White, Color::Magenta }, ColorPair{ Color::Black, Color::Aqua },
+    ColorPair{ Color::White, Color::Red },    ColorPair{ Color::Black, Color::Green },   ColorPair{ Color::White, Color::Olive },
+};
+static std::filesystem::path lastRulesPath; // shared by all the windows (the last rules file that was used)
+
+RulesPanel::RulesPanel(Reference<FileWindow> _win, Reference<GView::Utils::ZonesList> _zones)
+    : TabPage("&Rules"), win(_win), zones(_zones)
+{
+    Factory::Label::Create(this, "R&ules", "x:1,y:0,w:6");
+    txRules = Factory::TextField::Create(this, lastRulesPath.u16string(), "l:8,t:0,r:52,h:1");
+    txRules->SetHotKey('U');
+    Factory::Button::Create(this, "&Browse", "r:39,t:0,w:12", BTN_ID_BROWSE);
+    Factory::Button::Create(this, "S&can", "r:26,t:0,w:12", BTN_ID_SCAN);
+    lbStatus = Factory::Label::Create(this, "", "r:1,t:0,w:24");
+
+    // a folder => every file from it is scanned ; anything else => the matches from the current object
+    folderMode = win->GetObject()->GetObjectType() == GView::Object::Type::Folder;
+    if (folderMode)
+        lst = Factory::ListView::Create(
+              this, "l:0,t:2,r:0,b:0", { "n:File,a:l,w:80", "n:Rules,a:l,w:60", "n:Matches,a:r,w:10" }, ListViewFlags::None);
+    else
+        lst = Factory::ListView::Create(
+              this,
+              "l:0,t:2,r:0,b:0",
+              { "n:Rule,a:l,w:24", "n:String,a:l,w:16", "n:Offset,a:r,w:18", "n:Size,a:r,w:8", "n:Data,a:l,w:70" },
+              ListViewFlags::None);
+}
+bool RulesPanel::LoadRules()
+{
+    LocalUnicodeStringBuilder<512> tmp;
+    CHECK(tmp.Set(txRules->GetText()), false, "");
+    if (tmp.Len() == 0)
+    {
+        Dialogs::MessageBox::ShowError("Error", "Select a rules file first !");
+        return false;
+    }
+    const std::filesystem::path path(tmp.ToStringView());
+
+    AppCUI::OS::File f;
+    if (!f.OpenRead(path))
+    {
+        Dialogs::MessageBox::ShowError("Error", "Fail to open the rules file !");
+        return false;
+    }
+    const auto size = f.GetSize();
+    if (size > MAX_RULES_SIZE)
+    {
+        f.Close();
+        Dialogs::MessageBox::ShowError("Error", "The rules file is too large !");
+        return false;
+    }
+    std::string content((size_t) size, '\0');
+    uint32 bytesRead = 0;
+    const auto ok    = (size == 0) || (f.ReadBuffer(content.data(), (uint32) size, bytesRead) && (bytesRead == (uint32) size));
+    f.Close();
+    if (!ok)
+    {
+        Dialogs::MessageBox::ShowError("Error", "Fail to read the rules file !");
+        return false;
+    }
+
+    String error;
+    if (!engine.Compile(content, error))
+    {
+        Dialogs::MessageBox::ShowError("Invalid rules", error);
+        return false;
+    }
+    lastRulesPath = path;
+    return true;
+}
+void RulesPanel::Browse()
+{
+    auto res = Dialogs::FileDialog::ShowOpenFileWindow("", "", ".");
+    if (res.has_value())
+        txRules->SetText(res.value().u16string());
+}
+void RulesPanel::ScanObject()
+{
+    auto obj         = win->GetObject();
+    auto& data       = obj->GetData();
+    const auto size  = data.GetSize();
+    const auto start = std::chrono::steady_clock::now();
+
+    // AddMatch is called from the worker thread, 'result' is only used after the search ends
+    engine.InitResult(result, size);
+    const auto completed = engine.SearchWithProgress(
+          obj,
+          0,
+          size,
+          "Scanning rules ...",
+          [this](const GView::Utils::SearchMatch& m)
+          {
+              engine.AddMatch(result, m);
+              return true;
+          });
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<bool> matching(engine.GetRulesCount());
+    uint32 matchingCount = 0;
+    for (uint32 tr = 0; tr < engine.GetRulesCount(); tr++)
+    {
+        matching[tr] = engine.IsMatching(tr, result);
+        matchingCount += matching[tr] ? 1 : 0;
+    }
+
+    LocalString<128> tmp;
+    LocalString<MAX_SHOWN_BYTES + 16> text;
+    NumericFormatter n;
+    std::vector<bool> listedRules(engine.GetRulesCount());
+    uint32 listed = 0;
+    lst->DeleteAllItems();
+    this->zones->Clear();
+    this->zones->Reserve((uint32) std::min<size_t>(result.matches.size(), MAX_MATCH_ZONES));
+    // only the strings of the rules that match are reported
+    for (size_t idx = 0; idx < result.matches.size(); idx++)
+    {
+        const auto& m   = result.matches[idx];
+        const auto rule = engine.GetStringRule(m.patternIndex);
+        if (!matching[rule])
+            continue;
+        listedRules[rule] = true;
+        if (this->zones->GetCount() < MAX_MATCH_ZONES)
+        {
+            tmp.Format("%s:%s", engine.GetRuleName(rule).data(), engine.GetStringName(m.patternIndex).data());
+            const auto name = tmp.ToStringView().substr(0, MAX_ZONE_NAME);
+            this->zones->Add(m.offset, m.offset + m.size - 1, ruleColors[rule % ARRAY_LEN(ruleColors)], name);
+        }
+        if (listed >= MAX_LISTED_MATCHES)
+            continue;
+        const auto buf = data.Get(m.offset, std::min<>(m.size, MAX_SHOWN_BYTES), false);
+        text.Clear();
+        for (uint32 tr = 0; tr < (uint32) buf.GetLength(); tr++)
+            text.AddChar(((buf[tr] >= 32) && (buf[tr] < 127)) ? (char) buf[tr] : '.');
+        auto item = lst->AddItem(engine.GetRuleName(rule));
+        item.SetText(1, engine.GetStringName(m.patternIndex));
+        item.SetText(2, n.ToString(m.offset, { NumericFormatFlags::HexPrefix, 16 }));
+        item.SetText(3, tmp.Format("%u", m.size));
+        item.SetText(4, text);
+        item.SetData((uint64) idx);
+        listed++;
+    }
+    // rules that match without any string match (e.g. 'filesize < 100' or 'not $a')
+    for (uint32 tr = 0; tr < engine.GetRulesCount(); tr++)
+    {
+        if ((!matching[tr]) || (listedRules[tr]))
+            continue;
+        auto item = lst->AddItem(engine.GetRuleName(tr));
+        item.SetText(1, "-");
+        item.SetData(NO_MATCH_INDEX);
+    }
+
+    if (!completed)
+        tmp.Format("Canceled (%u rules)", matchingCount);
+    else
+        tmp.Format("%u/%u rules (%llu ms)", matchingCount, engine.GetRulesCount(), (uint64) ms);
+    lbStatus->SetText(tmp);
+}
+void RulesPanel::ScanFolder()
+{
+    const std::filesystem::path root(win->GetObject()->GetPath());
+    std::vector<std::filesystem::path> paths;
+    LocalString<128> tmp;
+
+    // list the files first (so that the progress can be computed)
+    AppCUI::Graphics::ProgressStatus::Init("Listing files");
+    std::error_code ec;
+    auto canceled  = false;
+    uint64 visited = 0;
+    for (auto it = std::filesystem::recursive_directory_iterator(root, std::filesystem::directory_options::skip_permission_denied, ec);
+         (!ec) && (it != std::filesystem::recursive_directory_iterator());
+         it.increment(ec))
+    {
+        if (it->is_regular_file(ec))
+            paths.push_back(it->path());
+        if (((++visited & 0x3FF) == 0) &&
+            (AppCUI::Graphics::ProgressStatus::Update(paths.size(), tmp.Format("Files: %llu", (uint64) paths.size()))))
+        {
+            canceled = true;
+            break;
+        }
+    }
+
+    // every worker takes the next file, scans it with its own cache and adds the matching files to 'files'
+    std::atomic<size_t> nextFile  = 0;
+    std::atomic<size_t> processed = 0;
+    std::atomic<uint32> errors    = 0;
+    std::atomic<bool> cancel      = canceled;
+    std::mutex lock;
+    std::condition_variable cv;
+    uint32 running   = 0;
+    const auto start = std::chrono::steady_clock::now();
+    this->files.clear();
+
+    auto worker = [&]()
+    {
+        GView::Utils::RuleScanResult fileResult;
+        std::string names;
+        while (!cancel.load(std::memory_order_relaxed))
+        {
+            const auto idx = nextFile.fetch_add(1);
+            if (idx >= paths.size())
+                break;
+            auto f = std::make_unique<AppCUI::OS::File>();
+            GView::Utils::DataCache cache;
+            if ((!f->OpenRead(paths[idx])) || (!cache.Init(std::move(f), paths[idx], FOLDER_CACHE_SIZE)) ||
+                (!engine.Scan(cache, fileResult, &cancel)))
+            {
+                errors++;
+                processed++;
+                continue;
+            }
+            names.clear();
+            for (uint32 tr = 0; tr < engine.GetRulesCount(); tr++)
+            {
+                if (!engine.IsMatching(tr, fileResult))
+                    continue;
+                if (!names.empty())
+                    names += ", ";
+                names += engine.GetRuleName(tr);
+            }
+            if (!names.empty())
+            {
+                uint64 count = 0;
+                for (auto c : fileResult.counts)
+                    count += c;
+                std::lock_guard<std::mutex> guard(lock);
+                this->files.push_back({ paths[idx], names, count });
+            }
+            processed++;
+        }
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            running--;
+        }
+        cv.notify_all();
+    };
+
+    std::vector<std::thread> workers;
+    const auto threads = std::clamp<uint32>(std::thread::hardware_concurrency(), 1, MAX_SCAN_WORKERS);
+    const auto count   = (uint32) std::min<size_t>(threads, paths.size());
+    running            = count;
+    for (uint32 tr = 0; tr < count; tr++)
+        workers.emplace_back(worker);
+
+    AppCUI::Graphics::ProgressStatus::Init("Scanning files", paths.size());
+    std::unique_lock<std::mutex> guard(lock);
+    while (!cv.wait_for(guard, std::chrono::milliseconds(100), [&running] { return running == 0; }))
+    {
+        guard.unlock();
+        const auto pos = processed.load(std::memory_order_relaxed);
+        tmp.Format("Scanned %llu out of %llu files", (uint64) pos, (uint64) paths.size());
+        if (AppCUI::Graphics::ProgressStatus::Update(pos, tmp))
+            cancel = true;
+        guard.lock();
+    }
+    guard.unlock();
+    for (auto& w : workers)
+        w.join();
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    // workers finish in any order => files are listed sorted by path
+    std::sort(this->files.begin(), this->files.end(), [](const FileResult& a, const FileResult& b) { return a.path < b.path; });
+    lst->DeleteAllItems();
+    for (size_t idx = 0; idx < this->files.size(); idx++)
+    {
+        const auto& fr = this->files[idx];
+        auto item      = lst->AddItem(fr.path.lexically_relative(root).u16string());
+        item.SetText(1, fr.rules);
+        item.SetText(2, tmp.Format("%llu", fr.matchesCount));
+        item.SetData((uint64) idx);
+    }
+
+    if (cancel)
+        tmp.Format("Canceled (%llu files)", (uint64) this->files.size());
+    else if (errors > 0)
+        tmp.Format("%llu files, %u errors", (uint64) this->files.size(), errors.load());
+    else
+        tmp.Format("%llu/%llu files (%llu ms)", (uint64) this->files.size(), (uint64) paths.size(), (uint64) ms);
+    lbStatus->SetText(tmp);
+}
+void RulesPanel::OpenSelectedItem()
+{
+    const auto value = lst->GetCurrentItem().GetData(NO_MATCH_INDEX);
+    if (folderMode)
+    {
+        if (value < this->files.size())
+            GView::App::OpenFile(this->files[value].path, GView::App::OpenMethod::BestMatch);
+        return;
+    }
+    if (value >= result.matches.size())
+        return; // a rule that matched without a string
+    const auto& m = result.matches[value];
+    auto v        = win->GetCurrentView();
+    if (v.IsValid())
+    {
+        v->GoTo(m.offset);
+        v->Select(m.offset, m.size);
+        v->SetFocus();
+    }
+}
+bool RulesPanel::OnEvent(Reference<Control> control, Event eventType, int ID)
+{
+    switch (eventType)
+    {
+    case Event::ButtonClicked:
+        if (ID == BTN_ID_BROWSE)
+        {
+            Browse();
+            return true;
+        }
+        if (ID == BTN_ID_SCAN)
+        {
+            if (LoadRules())
+            {
+                if (folderMode)
+                    ScanFolder();
+                else
+                    ScanObject();
+            }
+            return true;
+        }
+        break;
+    case Event::ListViewItemPressed:
+        OpenSelectedItem();
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,119 @@
+#include "Internal.hpp"
+
+using namespace GView::App;
+using namespace AppCUI::Input;
+
+constexpr int32 BTN_ID_REFRESH      = 1;
+constexpr size_t MAX_LISTED_STRINGS = 10000; // an object may have millions of strings => only the first matches are listed
+constexpr uint32 MAX_SHOWN_CHARS    = 256;
+
+StringsPanel::StringsPanel(Reference<FileWindow> _win, Reference<GView::Utils::StringsExtractorList> _strings)
+    : TabPage("&Strings"), win(_win), strings(_strings)
+{
+    Factory::Label::Create(this, "&Filter", "x:1,y:0,w:7");
+    txFilter = Factory::TextField::Create(this, "", "l:9,t:0,r:42,h:1");
+    txFilter->SetHotKey('F');
+    Factory::Button::Create(this, "&Refresh", "r:28,t:0,w:12", BTN_ID_REFRESH);
+    lbStatus = Factory::Label::Create(this, "", "r:1,t:0,w:26");
+    lst      = Factory::ListView::Create(
+          this, "l:0,t:2,r:0,b:0", { "n:Offset,a:r,w:18", "n:Size,a:r,w:10", "n:Type,a:l,w:8", "n:Text,a:l,w:260" }, ListViewFlags::None);
+    // the extraction starts on the first refresh (not for every opened object)
+    lbStatus->SetText(strings->IsEnabled() ? "Refresh to list strings" : "Not available");
+}
+void StringsPanel::Refresh()
+{
+    LocalString<128> tmp;
+    LocalString<MAX_SHOWN_CHARS + 16> text;
+    NumericFormatter n;
+    std::string filter, lowerText;
+
+    // the filter is a case insensitive ASCII substring
+    if (tmp.Set(txFilter->GetText()) == false)
+    {
+        Dialogs::MessageBox::ShowError("Error", "The filter can only contain ASCII characters !");
+        return;
+    }
+    for (auto ch : tmp.ToStringView())
+        filter.push_back((char) tolower(ch));
+
+    // the panel always uses the default settings (the buffer views have their own extractors)
+    auto index = strings->GetDefault();
+    if (index.IsValid() == false)
+    {
+        lbStatus->SetText("Not available");
+        return;
+    }
+    lst->DeleteAllItems();
+    this->listed.clear();
+    auto& data       = win->GetObject()->GetData();
+    const auto count = index->GetCount();
+    size_t idx       = 0;
+    for (; (idx < count) && (this->listed.size() < MAX_LISTED_STRINGS); idx++)
+    {
+        GView::Utils::StringRange s;
+        if (!index->GetString(idx, s))
+            break;
+        const auto step  = s.unicode ? 2U : 1U;
+        const auto chars = std::min<>(s.size / step, MAX_SHOWN_CHARS);
+        const auto buf   = data.Get(s.offset, chars * step, false);
+        text.Clear();
+        lowerText.clear();
+        for (uint32 tr = 0; tr < (uint32) buf.GetLength(); tr += step)
+        {
+            const auto ch = buf[tr] < 32 ? ' ' : (char) buf[tr];
+            text.AddChar(ch);
+            lowerText.push_back((char) tolower(ch));
+        }
+        if ((!filter.empty()) && (lowerText.find(filter) == std::string::npos))
+            continue;
+        auto item = lst->AddItem(n.ToString(s.offset, { NumericFormatFlags::HexPrefix, 16 }));
+        item.SetText(1, tmp.Format("%u", s.size));
+        item.SetText(2, s.unicode ? "UTF-16" : "ASCII");
+        item.SetText(3, text);
+        item.SetData((uint64) this->listed.size());
+        this->listed.push_back(s);
+    }
+
+    // status
+    if (!index->IsCompleted())
+    {
+        const auto size = std::max<uint64>(index->GetObjectSize(), 1);
+        tmp.Format("%llu strings (indexing %u%%)", (uint64) count, (uint32) (index->GetScannedSize() * 100 / size));
+    }
+    else if (idx < count)
+        tmp.Format("%llu strings (%llu listed)", (uint64) count, (uint64) this->listed.size());
+    else
+        tmp.Format("%llu strings", (uint64) count);
+    lbStatus->SetText(tmp);
+}
+void StringsPanel::GoToSelectedString()
+{
+    const auto idx = lst->GetCurrentItem().GetData(MAX_LISTED_STRINGS);
+    if (idx >= this->listed.size())
+        return;
+    const auto& s = this->listed[idx];
+    auto v        = win->GetCurrentView();
+    if (v.IsValid())
+    {
+        v->GoTo(s.offset);
+        v->Select(s.offset, s.size);
+        v->SetFocus();
+    }
+}
+bool StringsPanel::OnEvent(Reference<Control> control, Event eventType, int ID)
+{
+    switch (eventType)
+    {
+    case Event::ButtonClicked:
+        if (ID == BTN_ID_REFRESH)
+        {
+            Refresh();
+            return true;
+        }
+        break;
+    case Event::ListViewItemPressed:
+        GoToSelectedString();
+        return true;
+    }
+    return false;
+}
@@ -46,10 +46,17 @@ bool MagicMatcher::Init(std::string_view text)
     // all good
     return count>0;
 }
+bool MagicMatcher::SetBytes(BufferView bytes)
+{
+    CHECK((bytes.GetLength() > 0) && (bytes.GetLength() <= ARRAY_LEN(this->u8)), false, "");
+    memcpy(this->u8, bytes.GetData(), bytes.GetLength());
+    this->count = static_cast<uint8>(bytes.GetLength());
+    return true;
+}
 bool MagicMatcher::Match(AppCUI::Utils::BufferView buf, TextParser& )
 {
-    const auto* p = buf.GetData();
-    CHECK(buf.GetLength() >= count, false, "");
+    CHECK(buf.GetLength() >= static_cast<size_t>(offset) + count, false, "");
+    const auto* p = buf.GetData() + offset;
     switch (count)
     {
     case 0:
@@ -19,6 +19,17 @@ Interface* CreateFromString(std::string_view str)
             i    = new MagicMatcher();
             data = str.substr(6);
         }
+        else if (str.starts_with("magic@"))
+        {
+            // magic@<offset>:HH HH ... (offset can be decimal or hex - 0x...)
+            auto pos = str.find(':');
+            if (pos == std::string_view::npos)
+                return nullptr;
+            auto offset = Number::ToUInt32(str.substr(6, pos - 6), NumberParseFlags::BaseAuto);
+            CHECK(offset.has_value(), nullptr, "Invalid offset in pattern: %.*s", (int) str.size(), str.data());
+            i    = new MagicMatcher(offset.value());
+            data = str.substr(pos + 1);
+        }
         break;
     case 's':
         if (str.starts_with("startswith:"))
@@ -6,6 +6,10 @@ using namespace GView;
 
 constexpr uint64 EXTENSION_EMPTY_HASH = 0xcbf29ce484222325ULL;
 
+// startup trace (plugins are loaded from the UI thread or, in headless mode, before the worker threads are started)
+static std::chrono::steady_clock::duration pluginsLoadingTime{};
+static uint32 pluginsLoadedCount = 0;
+
 uint64 Plugin::ExtensionToHash(std::string_view ext)
 {
     // use FNV algorithm ==> https://en.wikipedia.org/wiki/Fowler%E2%80%93Noll%E2%80%93Vo_hash_function
@@ -175,6 +179,23 @@ bool Plugin::LoadPlugin()
 
     return true;
 }
+bool Plugin::Load()
+{
+    if ((!this->Loaded) && (!this->Invalid))
+    {
+        const auto start = std::chrono::steady_clock::now();
+        this->Invalid    = !LoadPlugin();
+        this->Loaded     = !this->Invalid;
+        pluginsLoadingTime += std::chrono::steady_clock::now() - start;
+        pluginsLoadedCount++;
+    }
+    return this->Loaded;
+}
+void Plugin::GetLoadingStats(double& milliseconds, uint32& count)
+{
+    milliseconds = std::chrono::duration<double, std::milli>(pluginsLoadingTime).count();
+    count        = pluginsLoadedCount;
+}
 bool Plugin::MatchExtension(uint64 extensionHash)
 {
     if (this->Invalid)
@@ -209,15 +230,8 @@ bool Plugin::MatchContent(AppCUI::Utils::BufferView buf, Matcher::TextParser& te
 }
 bool Plugin::IsOfType(AppCUI::Utils::BufferView buf, Matcher::TextParser& textParser)
 {
-    if (this->Invalid)
-        return false;
-    if (!this->Loaded)
-    {
-        this->Invalid = !LoadPlugin();
-        this->Loaded  = !this->Invalid;
-        if (this->Invalid)
-            return false; // something went wrong when loading he plugin
-    }
+    if (!Load())
+        return false; // something went wrong when loading he plugin
     // all good -> code is loaded
     return fnValidate(buf, "");
 }
@@ -0,0 +1,338 @@
+#include "Internal.hpp"
+
+namespace GView::Type
+{
+constexpr uint32 REGISTRY_MAGIC    = 0x43525647; // GVRC
+constexpr uint32 REGISTRY_VERSION  = 2; // 2 => strings have a 32 bits length
+constexpr uint64 REGISTRY_MAX_SIZE = 0x1000000; // 16 MB
+constexpr uint64 FNV_OFFSET_BASIS  = 0xcbf29ce484222325ULL;
+constexpr uint64 FNV_PRIME         = 0x00000100000001B3ULL;
+
+// format (all values are stored in the native byte order):
+//  header : magic(4) version(4) stamp(8) pluginsCount(4)
+//  plugin : name(str) description(str) priority(2) extension(8) extensionsCount(4) [hash(8)]
+//           patternsCount(4) isArray(1) [kind(1) (offset(4) bytes(str) | text(str))]
+//           commandsCount(4) [name(str) key(4)]
+//  str    : length(4) followed by 'length' bytes
+class RegistryWriter
+{
+    std::vector<uint8> data;
+
+  public:
+    template <typename T>
+    void Write(T value)
+    {
+        const auto* p = reinterpret_cast<const uint8*>(&value);
+        data.insert(data.end(), p, p + sizeof(T));
+    }
+    void WriteString(std::string_view text)
+    {
+        // the values are never cut (a description, a pattern or a magic of any size is cached as it is)
+        const auto len = static_cast<uint32>(text.size());
+        Write(len);
+        data.insert(data.end(), reinterpret_cast<const uint8*>(text.data()), reinterpret_cast<const uint8*>(text.data()) + len);
+    }
+    inline BufferView GetData() const
+    {
+        return BufferView(data.data(), data.size());
+    }
+};
+class RegistryReader
+{
+    const uint8* p;
+    const uint8* e;
+
+  public:
+    RegistryReader(BufferView buf) : p(buf.GetData()), e(buf.GetData() + buf.GetLength())
+    {
+    }
+    template <typename T>
+    bool Read(T& value)
+    {
+        if (static_cast<size_t>(e - p) < sizeof(T))
+            return false;
+        memcpy(&value, p, sizeof(T));
+        p += sizeof(T);
+        return true;
+    }
+    bool ReadString(std::string_view& text)
+    {
+        uint32 len;
+        if ((!Read(len)) || (static_cast<size_t>(e - p) < len))
+            return false;
+        text = std::string_view(reinterpret_cast<const char*>(p), len);
+        p += len;
+        return true;
+    }
+    inline bool IsEOF() const
+    {
+        return p == e;
+    }
+};
+
+uint64 UpdateStamp(uint64 hash, const void* data, size_t size)
+{
+    auto* s = reinterpret_cast<const uint8*>(data);
+    auto* e = s + size;
+    for (; s < e; s++)
+    {
+        hash = hash ^ (*s);
+        hash = hash * FNV_PRIME;
+    }
+    return hash;
+}
+void PluginRegistry::DeletePatterns(Plugin& plugin)
+{
+    if (plugin.pattern)
+        delete plugin.pattern;
+    for (auto* p : plugin.patterns)
+        delete p;
+    plugin.pattern = nullptr;
+    plugin.patterns.clear();
+}
+Matcher::Interface* ReadPattern(RegistryReader& r)
+{
+    uint8 kind;
+    std::string_view value;
+    CHECK(r.Read(kind), nullptr, "");
+    switch (static_cast<Matcher::Kind>(kind))
+    {
+    case Matcher::Kind::Magic:
+    {
+        uint32 offset;
+        CHECK(r.Read(offset), nullptr, "");
+        CHECK(r.ReadString(value), nullptr, "");
+        auto* m = new Matcher::MagicMatcher(offset);
+        if (!m->SetBytes(BufferView(value.data(), value.size())))
+        {
+            delete m;
+            RETURNERROR(nullptr, "Invalid magic pattern in plugins registry !");
+        }
+        return m;
+    }
+    case Matcher::Kind::StartsWith:
+    case Matcher::Kind::LineStartsWith:
+    {
+        CHECK(r.ReadString(value), nullptr, "");
+        Matcher::Interface* m = nullptr;
+        if (static_cast<Matcher::Kind>(kind) == Matcher::Kind::StartsWith)
+            m = new Matcher::StartsWithMatcher();
+        else
+            m = new Matcher::LineStartsWithMatcher();
+        if (!m->Init(value))
+        {
+            delete m;
+            RETURNERROR(nullptr, "Invalid text pattern in plugins registry !");
+        }
+        return m;
+    }
+    }
+    RETURNERROR(nullptr, "Unknown pattern kind (%u) in plugins registry !", kind);
+}
+void WritePattern(RegistryWriter& w, Matcher::Interface* pattern)
+{
+    const auto kind = pattern->GetKind();
+    w.Write(static_cast<uint8>(kind));
+    switch (kind)
+    {
+    case Matcher::Kind::Magic:
+    {
+        auto* m     = static_cast<Matcher::MagicMatcher*>(pattern);
+        auto buffer = m->GetBytes();
+        w.Write(m->GetOffset());
+        w.WriteString(std::string_view(reinterpret_cast<const char*>(buffer.GetData()), buffer.GetLength()));
+        break;
+    }
+    case Matcher::Kind::StartsWith:
+        w.WriteString(static_cast<Matcher::StartsWithMatcher*>(pattern)->GetValue());
+        break;
+    case Matcher::Kind::LineStartsWith:
+        w.WriteString(static_cast<Matcher::LineStartsWithMatcher*>(pattern)->GetValue());
+        break;
+    }
+}
+bool PluginRegistry::ReadPlugin(RegistryReader& r, Plugin& plugin)
+{
+    std::string_view text;
+    uint32 count;
+    uint8 isArray;
+
+    CHECK(r.ReadString(text), false, "");
+    plugin.name.Set(text);
+    CHECK(r.ReadString(text), false, "");
+    plugin.description.Set(text);
+    CHECK(r.Read(plugin.priority), false, "");
+    CHECK(r.Read(plugin.extension), false, "");
+    CHECK(r.Read(count), false, "");
+    for (uint32 tr = 0; tr < count; tr++)
+    {
+        uint64 hash;
+        CHECK(r.Read(hash), false, "");
+        plugin.extensions.insert(hash);
+    }
+
+    CHECK(r.Read(count), false, "");
+    CHECK(r.Read(isArray), false, "");
+    CHECK((isArray != 0) || (count <= 1), false, "");
+    if (isArray)
+        plugin.patterns.reserve(count);
+    for (uint32 tr = 0; tr < count; tr++)
+    {
+        auto* p = ReadPattern(r);
+        CHECK(p, false, "");
+        if (isArray)
+            plugin.patterns.push_back(p);
+        else
+            plugin.pattern = p;
+    }
+
+    CHECK(r.Read(count), false, "");
+    plugin.commands.reserve(count);
+    for (uint32 tr = 0; tr < count; tr++)
+    {
+        uint32 key;
+        CHECK(r.ReadString(text), false, "");
+        CHECK(r.Read(key), false, "");
+        auto& cmd = plugin.commands.emplace_back();
+        cmd.name.Set(text);
+        cmd.key = static_cast<Input::Key>(key);
+    }
+    plugin.Loaded  = false;
+    plugin.Invalid = false;
+    return true;
+}
+void PluginRegistry::WritePlugin(RegistryWriter& w, const Plugin& plugin)
+{
+    w.WriteString(plugin.name.ToStringView());
+    w.WriteString(plugin.description.ToStringView());
+    w.Write(plugin.priority);
+    w.Write(plugin.extension);
+    w.Write(static_cast<uint32>(plugin.extensions.size()));
+    for (auto hash : plugin.extensions)
+        w.Write(hash);
+    w.Write(plugin.GetPatternsCount());
+    w.Write(static_cast<uint8>(plugin.patterns.empty() ? 0 : 1));
+    for (uint32 tr = 0; tr < plugin.GetPatternsCount(); tr++)
+        WritePattern(w, plugin.GetPattern(tr));
+    w.Write(static_cast<uint32>(plugin.commands.size()));
+    for (const auto& cmd : plugin.commands)
+    {
+        w.WriteString(cmd.name.ToStringView());
+        w.Write(static_cast<uint32>(cmd.key));
+    }
+}
+
+PluginRegistry::PluginRegistry()
+{
+    this->stamp = 0;
+}
+bool PluginRegistry::Init(const std::filesystem::path& iniPath)
+{
+    // the stamp changes if gview.ini or any of the type plugins (.tpl files) is changed, added or removed
+    std::error_code ec;
+    auto hash    = UpdateStamp(FNV_OFFSET_BASIS, &REGISTRY_VERSION, sizeof(REGISTRY_VERSION));
+    auto iniTime = std::filesystem::last_write_time(iniPath, ec).time_since_epoch().count();
+    CHECK(!ec, false, "Unable to read the last write time of %s", iniPath.u8string().c_str());
+    auto iniSize = static_cast<uint64>(std::filesystem::file_size(iniPath, ec));
+    CHECK(!ec, false, "Unable to read the size of %s", iniPath.u8string().c_str());
+    hash = UpdateStamp(hash, &iniTime, sizeof(iniTime));
+    hash = UpdateStamp(hash, &iniSize, sizeof(iniSize));
+
+    auto typesPath = AppCUI::OS::GetCurrentApplicationPath();
+    typesPath.remove_filename();
+    typesPath += "Types";
+    std::vector<std::pair<std::string, int64>> tplFiles;
+    for (const auto& fileEntry : std::filesystem::directory_iterator(typesPath, ec))
+    {
+        if ((fileEntry.path().extension() == ".tpl") && (fileEntry.path().filename().string().starts_with("lib")))
+        {
+            std::error_code timeError;
+            auto tm = fileEntry.last_write_time(timeError);
+            tplFiles.emplace_back(fileEntry.path().filename().string(), timeError ? 0 : (int64) tm.time_since_epoch().count());
+        }
+    }
+    std::sort(tplFiles.begin(), tplFiles.end());
+    for (const auto& [name, tm] : tplFiles)
+    {
+        hash = UpdateStamp(hash, name.data(), name.size());
+        hash = UpdateStamp(hash, &tm, sizeof(tm));
+    }
+
+    this->stamp = hash;
+    this->path  = iniPath;
+    this->path.replace_extension(".registry");
+    return true;
+}
+bool PluginRegistry::Load(std::vector<Plugin>& plugins)
+{
+    CHECK(!this->path.empty(), false, "Registry was not initialized !");
+    AppCUI::OS::File f;
+    if (!f.OpenRead(this->path))
+        return false; // no registry (yet)
+    const auto size = f.GetSize();
+    if ((size < 20) || (size > REGISTRY_MAX_SIZE))
+    {
+        f.Close();
+        RETURNERROR(false, "Invalid plugins registry size (%llu bytes)", size);
+    }
+    std::vector<uint8> content((size_t) size);
+    uint32 bytesRead = 0;
+    const auto ok    = f.ReadBuffer(content.data(), (uint32) size, bytesRead) && (bytesRead == (uint32) size);
+    f.Close();
+    CHECK(ok, false, "Fail to read the plugins registry");
+
+    RegistryReader r(BufferView(content.data(), content.size()));
+    uint32 magic, version, count;
+    uint64 fileStamp;
+    CHECK(r.Read(magic) && (magic == REGISTRY_MAGIC), false, "Invalid plugins registry (magic)");
+    CHECK(r.Read(version) && (version == REGISTRY_VERSION), false, "Unsupported plugins registry version");
+    CHECK(r.Read(fileStamp), false, "");
+    if (fileStamp != this->stamp)
+        return false; // gview.ini or the plugins were changed => registry must be rebuilt
+    CHECK(r.Read(count), false, "");
+
+    std::vector<Plugin> list;
+    list.reserve(count);
+    auto valid = true;
+    for (uint32 tr = 0; (tr < count) && (valid); tr++)
+        valid = ReadPlugin(r, list.emplace_back());
+    if ((!valid) || (!r.IsEOF()))
+    {
+        for (auto& p : list)
+            DeletePatterns(p);
+        RETURNERROR(false, "Corrupted plugins registry !");
+    }
+    for (auto& p : list)
+        plugins.push_back(p);
+    return true;
+}
+bool PluginRegistry::Save(const std::vector<Plugin>& plugins)
+{
+    CHECK(!this->path.empty(), false, "Registry was not initialized !");
+    RegistryWriter w;
+    w.Write(REGISTRY_MAGIC);
+    w.Write(REGISTRY_VERSION);
+    w.Write(this->stamp);
+    w.Write(static_cast<uint32>(plugins.size()));
+    for (const auto& plugin : plugins)
+        WritePlugin(w, plugin);
+
+    // write a temporary file first and then rename it => a registry is either complete or missing
+    auto tmpPath = this->path;
+    tmpPath += ".tmp";
+    AppCUI::OS::File f;
+    CHECK(f.Create(tmpPath, true), false, "Fail to create %s", tmpPath.u8string().c_str());
+    const auto data = w.GetData();
+    const auto ok   = f.Write(static_cast<const void*>(data.GetData()), static_cast<uint32>(data.GetLength()));
+    f.Close();
+    std::error_code ec;
+    if (ok)
+        std::filesystem::rename(tmpPath, this->path, ec);
+    if ((!ok) || (ec))
+    {
+        std::filesystem::remove(tmpPath, ec);
+        RETURNERROR(false, "Fail to write the plugins registry (%s)", this->path.u8string().c_str());
+    }
+    return true;
+}
+} // namespace GView::Type
@@ -0,0 +1,75 @@
+#include "Internal.hpp"
+
+using namespace GView;
+
+namespace GView::Type::ProcessViewPlugin
+{
+class ProcessType : public TypeInterface, public View::BufferViewer::OffsetTranslateInterface
+{
+  public:
+    uint32 pid;
+    Utils::ProcessRegionsMap map;
+
+    string_view GetTypeName() override
+    {
+        return "Process";
+    }
+    void RunCommand(std::string_view commandName) override
+    {
+    }
+    uint64_t TranslateToFileOffset(uint64 value, uint32 fromTranslationIndex) override
+    {
+        return map.AddressToOffset(value);
+    }
+    uint64_t TranslateFromFileOffset(uint64 value, uint32 toTranslationIndex) override
+    {
+        return map.OffsetToAddress(value);
+    }
+};
+class RegionsPanel : public TabPage
+{
+  public:
+    RegionsPanel(Reference<ProcessType> process) : TabPage("&Regions")
+    {
+        auto lv = Factory::ListView::Create(
+              this, "d:c", { "n:Address,a:r,w:20", "n:Size,a:r,w:16", "n:Access,a:c,w:8", "n:Name,a:l,w:100" }, ListViewFlags::None);
+        NumericFormatter n;
+        for (const auto& r : process->map.GetRegions())
+        {
+            auto item = lv->AddItem(n.ToString(r.address, { NumericFormatFlags::HexPrefix, 16 }));
+            item.SetText(1, n.ToString(r.size, { NumericFormatFlags::HexPrefix, 16 }));
+            item.SetText(2, std::string_view(r.permissions, strnlen(r.permissions, sizeof(r.permissions))));
+            item.SetText(3, r.name);
+            if (!r.readable)
+                item.SetType(ListViewItem::Type::GrayedOut);
+        }
+    }
+};
+
+TypeInterface* CreateInstance(uint32 pid, const Utils::ProcessRegionsMap& map)
+{
+    auto* pt = new ProcessType();
+    pt->pid  = pid;
+    pt->map  = map;
+    return pt;
+}
+bool PopulateWindow(Reference<GView::View::WindowInterface> win)
+{
+    auto pt = win->GetObject()->GetContentType<ProcessType>();
+    win->AddPanel(Pointer<TabPage>(new RegionsPanel(pt)), false);
+
+    View::BufferViewer::Settings settings;
+    const ColorPair colors[] = { ColorPair{ Color::Yellow, Color::DarkBlue }, ColorPair{ Color::Aqua, Color::DarkBlue } };
+    LocalString<64> tmp;
+    auto index = 0U;
+    for (const auto& r : pt->map.GetRegions())
+    {
+        const auto name = r.name.empty() ? std::string_view(tmp.Format("%llX", r.address)) : std::string_view(r.name);
+        settings.AddZone(r.offset, r.size, r.readable ? colors[index & 1] : ColorPair{ Color::Gray, Color::DarkBlue }, name);
+        index++;
+    }
+    settings.SetOffsetTranslationList({ "VA" }, pt.ToBase<View::BufferViewer::OffsetTranslateInterface>());
+    win->CreateViewer("BufferView", settings);
+    return true;
+}
+} // namespace GView::Type::ProcessViewPlugin
@@ -0,0 +1,168 @@
+#include "Internal.hpp"
+
+namespace GView::Type::Matcher
+{
+SignatureTrie::SignatureTrie()
+{
+    for (auto& r : root)
+        r = NONE;
+}
+uint32 SignatureTrie::FindChild(uint32 node, uint16 symbol) const
+{
+    auto idx = nodes[node].child;
+    while ((idx != NONE) && (nodes[idx].symbol != symbol))
+        idx = nodes[idx].sibling;
+    return idx;
+}
+void SignatureTrie::Add(const uint8* pattern, uint32 size, uint32 pluginIndex)
+{
+    if (size == 0)
+        return;
+    auto node = root[*pattern];
+    if (node == NONE)
+    {
+        node           = (uint32) nodes.size();
+        root[*pattern] = node;
+        nodes.push_back({ NONE, NONE, NONE, *pattern });
+    }
+    for (uint32 tr = 1; tr < size; tr++)
+    {
+        auto next = FindChild(node, pattern[tr]);
+        if (next == NONE)
+        {
+            next = (uint32) nodes.size();
+            nodes.push_back({ NONE, nodes[node].child, NONE, pattern[tr] });
+            nodes[node].child = next;
+        }
+        node = next;
+    }
+    matches.push_back({ pluginIndex, nodes[node].matches });
+    nodes[node].matches = (uint32) (matches.size() - 1);
+}
+template <typename T>
+void SignatureTrie::Match(const T* p, const T* e, std::vector<bool>& candidates) const
+{
+    if ((p >= e) || (static_cast<uint32>(*p) >= 256))
+        return;
+    auto node = root[static_cast<uint32>(*p)];
+    while (node != NONE)
+    {
+        // every node on the path that ends a pattern is a match
+        for (auto m = nodes[node].matches; m != NONE; m = matches[m].next)
+            candidates[matches[m].plugin] = true;
+        p++;
+        if (p >= e)
+            break;
+        node = FindChild(node, static_cast<uint16>(*p));
+    }
+}
+
+SignatureMatches::SignatureMatches()
+{
+    this->index         = nullptr;
+    this->text          = nullptr;
+    this->textEvaluated = false;
+}
+bool SignatureMatches::IsCandidate(uint32 pluginIndex)
+{
+    if (pluginIndex >= this->candidates.size())
+        return false;
+    if ((!this->textEvaluated) && (this->index->UsesText(pluginIndex)))
+    {
+        this->index->MatchText(*this->text, this->candidates);
+        this->textEvaluated = true;
+    }
+    return this->candidates[pluginIndex];
+}
+
+SignatureIndex::SignatureIndex()
+{
+    this->pluginsCount = 0;
+}
+void SignatureIndex::Build(const std::vector<Plugin>& plugins)
+{
+    this->magics.clear();
+    this->startsWith     = SignatureTrie();
+    this->lineStartsWith = SignatureTrie();
+    this->pluginsCount   = (uint32) plugins.size();
+    this->usesText.assign(this->pluginsCount, false);
+
+    for (uint32 idx = 0; idx < this->pluginsCount; idx++)
+    {
+        const auto& plg = plugins[idx];
+        const auto cnt  = plg.GetPatternsCount();
+        for (uint32 tr = 0; tr < cnt; tr++)
+        {
+            auto* pattern = plg.GetPattern(tr);
+            if (pattern == nullptr)
+                continue;
+            switch (pattern->GetKind())
+            {
+            case Kind::Magic:
+            {
+                auto* m     = static_cast<MagicMatcher*>(pattern);
+                auto bytes  = m->GetBytes();
+                auto offset = m->GetOffset();
+                auto it     = std::find_if(this->magics.begin(), this->magics.end(), [offset](const auto& g) { return g.first == offset; });
+                if (it == this->magics.end())
+                {
+                    this->magics.emplace_back(offset, SignatureTrie());
+                    it = this->magics.end() - 1;
+                }
+                it->second.Add(bytes.GetData(), (uint32) bytes.GetLength(), idx);
+                break;
+            }
+            case Kind::StartsWith:
+            {
+                auto value = static_cast<StartsWithMatcher*>(pattern)->GetValue();
+                this->startsWith.Add(reinterpret_cast<const uint8*>(value.data()), (uint32) value.size(), idx);
+                this->usesText[idx] = true;
+                break;
+            }
+            case Kind::LineStartsWith:
+            {
+                auto value = static_cast<LineStartsWithMatcher*>(pattern)->GetValue();
+                this->lineStartsWith.Add(reinterpret_cast<const uint8*>(value.data()), (uint32) value.size(), idx);
+                this->usesText[idx] = true;
+                break;
+            }
+            }
+        }
+    }
+}
+void SignatureIndex::Match(AppCUI::Utils::BufferView buf, TextParser& text, SignatureMatches& matches) const
+{
+    matches.index         = this;
+    matches.text          = &text;
+    matches.textEvaluated = false;
+    matches.candidates.assign(this->pluginsCount, false);
+
+    for (const auto& [offset, trie] : this->magics)
+    {
+        if (buf.GetLength() > offset)
+            trie.Match(buf.GetData() + offset, buf.GetData() + buf.GetLength(), matches.candidates);
+    }
+    // text patterns are added to 'candidates' later => the magic ones are kept apart
+    matches.magics = matches.candidates;
+}
+void SignatureIndex::MatchText(TextParser& text, std::vector<bool>& candidates) const
+{
+    if (this->startsWith.Empty() && this->lineStartsWith.Empty())
+        return;
+
+    auto txt = text.GetText();
+    if (txt.empty())
+        return;
+    auto* e = txt.data() + txt.size();
+    if (!this->startsWith.Empty())
+        this->startsWith.Match(txt.data(), e, candidates);
+    if (!this->lineStartsWith.Empty())
+    {
+        for (auto ofs : text.GetLines())
+        {
+            if (ofs < txt.size())
+                this->lineStartsWith.Match(txt.data() + ofs, e, candidates);
+        }
+    }
+}
+} // namespace GView::Type::Matcher
@@ -2,42 +2,44 @@
 
 namespace GView::Type::Matcher
 {
-TextParser::TextParser(const char16* text, uint32 size)
+TextParser::TextParser(AppCUI::Utils::BufferView buf) : buffer(buf)
 {
+    this->Text.text      = nullptr;
+    this->Text.size      = 0;
+    this->Text.computed  = false;
+    this->Lines.count    = 0;
     this->Lines.computed = false;
+}
+TextParser::~TextParser()
+{
+    this->unicode.Destroy();
+}
+void TextParser::ComputeText()
+{
+    this->Text.computed = true;
 
-    if ((text == nullptr) || (size == 0))
-    {
-        this->Raw.text  = nullptr;
-        this->Text.text = nullptr;
-        this->Raw.size  = 0;
-        this->Text.size = 0;
-    }
-    else
-    {
-        this->Raw.text = text;
-        this->Raw.size = size;
+    auto bomLen = 0U;
+    auto enc    = GView::Utils::CharacterEncoding::AnalyzeBufferForEncoding(this->buffer, true, bomLen);
+    if (enc == GView::Utils::CharacterEncoding::Encoding::Binary)
+        return;
+    this->unicode = GView::Utils::CharacterEncoding::ConvertToUnicode16(this->buffer);
+    if ((this->unicode.text == nullptr) || (this->unicode.size == 0))
+        return;
 
-        auto p = text;
-        auto e = text + size;
-        while ((p < e) && (((*p) == ' ') || ((*p) == '\t') || ((*p) == '\n') || ((*p) == '\r')))
-            p++;
-        if (p == e)
-        {
-            this->Raw.text  = nullptr;
-            this->Text.text = nullptr;
-            this->Raw.size  = 0;
-            this->Text.size = 0;
-        }
-        else
-        {
-            this->Text.text = p;
-            this->Text.size = static_cast<uint32>(e - p);
-        }
+    auto p = this->unicode.text;
+    auto e = this->unicode.text + this->unicode.size;
+    while ((p < e) && (((*p) == ' ') || ((*p) == '\t') || ((*p) == '\n') || ((*p) == '\r')))
+        p++;
+    if (p < e)
+    {
+        this->Text.text = p;
+        this->Text.size = static_cast<uint32>(e - p);
     }
 }
 void TextParser::ComputeLineOffsets()
 {
+    if (!this->Text.computed)
+        ComputeText();
     auto p            = this->Text.text;
     auto e            = this->Text.text + this->Text.size;
     auto maxLines     = ARRAY_LEN(this->Lines.offsets);
@@ -1,18 +1,359 @@
 #include "GView.hpp"
 
+#include <atomic>
+#include <mutex>
+
+#if defined(BUILD_FOR_WINDOWS)
+#    include <Windows.h>
+#    undef GetObject
+#elif defined(BUILD_FOR_OSX) || defined(BUILD_FOR_UNIX)
+#    include <cerrno>
+#    include <csignal>
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
 using namespace GView::Utils;
 
 constexpr uint32 MAX_CACHE_SIZE = 0x1000000U; // 16 M
+constexpr uint32 PAGE_SIZE      = 0x10000U;   // 64 K (slot windows are aligned to this value)
+constexpr uint64 PAGE_MASK      = ~((uint64) (PAGE_SIZE - 1));
+
+// an entire file is mapped with room to grow (at least its size) => the bytes appended to it are visible through the same
+// mapping ; a file that outgrows it is mapped again => the number of mappings grows with log2 of the size
+constexpr uint64 MIN_MAPPING_RESERVE = 0x4000000ULL; // 64 M
+
+// the file object of a cache and the lock that serializes the access to it ; it is reference counted because the readers
+// created with CreateRangeReader read through the same file object and can outlive the cache that created them
+struct DataCache::SharedFile
+{
+    AppCUI::OS::DataObject* obj;
+    std::mutex lock;
+    std::atomic<uint32> refs;
+
+    SharedFile(AppCUI::OS::DataObject* fileObj) : obj(fileObj), refs(1)
+    {
+    }
+    void Release()
+    {
+        if (refs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            return;
+        if (obj)
+        {
+            obj->Close();
+            delete obj;
+        }
+        delete this;
+    }
+};
+
+// read-only view over [offset, offset+size) of the file object of a cache
+class DataCache::RangeReader : public AppCUI::OS::DataObject
+{
+    SharedFile* file;
+    uint64 offset, size, pos;
+
+  public:
+    RangeReader(SharedFile* sharedFile, uint64 rangeOffset, uint64 rangeSize)
+        : file(sharedFile), offset(rangeOffset), size(rangeSize), pos(0)
+    {
+        file->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+    ~RangeReader()
+    {
+        file->Release();
+    }
+    bool ReadBuffer(void* buffer, uint32 bufferSize, uint32& bytesRead) override
+    {
+        bytesRead = 0;
+        CHECK(pos <= size, false, "Invalid position: %llu (size is %llu)", pos, size);
+        const auto toRead = (uint32) std::min<uint64>(bufferSize, size - pos);
+        if (toRead > 0)
+        {
+            std::lock_guard<std::mutex> guard(file->lock);
+            CHECK(file->obj->SetCurrentPos(offset + pos), false, "Fail to move to offset %llu", offset + pos);
+            CHECK(file->obj->ReadBuffer(buffer, toRead, bytesRead), false, "Fail to read %u bytes from %llu", toRead, offset + pos);
+        }
+        pos += bytesRead;
+        return true;
+    }
+    bool WriteBuffer(const void* buffer, uint32 bufferSize, uint32& bytesWritten) override
+    {
+        bytesWritten = 0;
+        RETURNERROR(false, "A range reader is read-only !");
+    }
+    uint64 GetSize() override
+    {
+        return size;
+    }
+    uint64 GetCurrentPos() const override
+    {
+        return pos;
+    }
+    bool SetSize(uint64 newSize) override
+    {
+        RETURNERROR(false, "A range reader is read-only !");
+    }
+    bool SetCurrentPos(uint64 newPosition) override
+    {
+        CHECK(newPosition <= size, false, "Invalid position: %llu (size is %llu)", newPosition, size);
+        pos = newPosition;
+        return true;
+    }
+    void Close() override
+    {
+    }
+};
+
+#if defined(BUILD_FOR_OSX) || defined(BUILD_FOR_UNIX)
+// A mapped file can be truncated by another process (for example a log rotated with copytruncate). Reading a page of the
+// mapping that is past the new end of the file raises SIGBUS. The mappings are registered here and the SIGBUS handler
+// replaces the faulting page with a page of zeros => the read is retried and returns zeros instead of killing GView.
+// The size of the object is not changed by this (UpdateSize does that). The first replaced page is recorded so that the
+// pages of zeros are mapped from the file again if it grows back.
+namespace
+{
+constexpr uint32 MAX_GUARDED_MAPPINGS = 1024;
+constexpr uintptr_t NO_PATCHED_PAGE   = ~((uintptr_t) 0);
+struct GuardedMapping
+{
+    std::atomic<uintptr_t> start;
+    std::atomic<uintptr_t> end;
+    std::atomic<uintptr_t> firstPatched; // lowest page replaced with zeros (NO_PATCHED_PAGE if none)
+};
+GuardedMapping guardedMappings[MAX_GUARDED_MAPPINGS];
+struct sigaction previousSigBusAction;
+uintptr_t systemPageSize = 4096;
+std::once_flag sigBusHandlerInstalled;
+
+void OnSigBus(int signal, siginfo_t* info, void* context)
+{
+    const auto address = (uintptr_t) info->si_addr;
+    for (auto& m : guardedMappings)
+    {
+        const auto start = m.start.load(std::memory_order_acquire);
+        if ((start <= 1) || (address < start) || (address >= m.end.load(std::memory_order_acquire)))
+            continue;
+        const auto page = address & ~(systemPageSize - 1);
+        if (mmap((void*) page, systemPageSize, PROT_READ, MAP_FIXED | MAP_PRIVATE | MAP_ANONYMOUS, -1, 0) == MAP_FAILED)
+            break;
+        auto first = m.firstPatched.load(std::memory_order_relaxed);
+        while ((page < first) && (!m.firstPatched.compare_exchange_weak(first, page, std::memory_order_acq_rel)))
+        {
+        }
+        return;
+    }
+    // not a read from a truncated mapping => the previous handler (or the default action) handles it
+    if (previousSigBusAction.sa_flags & SA_SIGINFO)
+    {
+        if (previousSigBusAction.sa_sigaction)
+        {
+            previousSigBusAction.sa_sigaction(signal, info, context);
+            return;
+        }
+    }
+    else if ((previousSigBusAction.sa_handler != SIG_DFL) && (previousSigBusAction.sa_handler != SIG_IGN))
+    {
+        previousSigBusAction.sa_handler(signal);
+        return;
+    }
+    sigaction(SIGBUS, &previousSigBusAction, nullptr); // the faulting instruction runs again with the default action
+}
+void GuardMapping(void* data, uint64 size)
+{
+    std::call_once(
+          sigBusHandlerInstalled,
+          []()
+          {
+              systemPageSize = (uintptr_t) sysconf(_SC_PAGESIZE);
+              struct sigaction action = {};
+              action.sa_sigaction     = OnSigBus;
+              action.sa_flags         = SA_SIGINFO | SA_NODEFER;
+              sigemptyset(&action.sa_mask);
+              sigaction(SIGBUS, &action, &previousSigBusAction);
+          });
+    for (auto& m : guardedMappings)
+    {
+        // an entry is reserved (start = 1), then filled ; 'start' publishes it for the signal handler
+        uintptr_t expected = 0;
+        if (!m.start.compare_exchange_strong(expected, 1, std::memory_order_acq_rel))
+            continue;
+        m.end.store((uintptr_t) data + (uintptr_t) size, std::memory_order_release);
+        m.firstPatched.store(NO_PATCHED_PAGE, std::memory_order_release);
+        m.start.store((uintptr_t) data, std::memory_order_release);
+        return;
+    }
+    LOG_ERROR("Too many mapped files ; a truncation of this one (%llu bytes) is not guarded", size);
+}
+void UnguardMapping(void* data)
+{
+    for (auto& m : guardedMappings)
+    {
+        if (m.start.load(std::memory_order_acquire) == (uintptr_t) data)
+        {
+            m.end.store(0, std::memory_order_release);
+            m.start.store(0, std::memory_order_release);
+            return;
+        }
+    }
+}
+// returns (and forgets) the address of the first page of the mapping that was replaced with zeros
+uintptr_t TakeFirstPatchedPage(void* data)
+{
+    for (auto& m : guardedMappings)
+    {
+        if (m.start.load(std::memory_order_acquire) == (uintptr_t) data)
+            return m.firstPatched.exchange(NO_PATCHED_PAGE, std::memory_order_acq_rel);
+    }
+    return NO_PATCHED_PAGE;
+}
+} // namespace
+#endif
+
+// maps [offset, offset+size) from a file (read-only) in the address space of the current process
+// 'size' = 0 means "up to the end of the file"; on return 'size' is the number of bytes that are available from the returned pointer
+// views start at an offset aligned to PAGE_SIZE (a multiple of the allocation granularity) => 'delta' bytes are mapped before the data
+// the OS handles are closed right away (the view keeps its own reference to the file)
+// Windows does not allow a mapped file to be truncated ; on the other systems the mapping is guarded (see OnSigBus)
+// if 'capacity' is provided, more than the file is mapped (64 bit POSIX builds only ; the pages past the end of the file are
+// filled when the file grows) ; on return it is the number of bytes (after the returned pointer) that UnmapFile must release
+static uint8* MapFile(const std::filesystem::path& path, uint64 offset, uint64& size, uint32& delta, uint64* capacity = nullptr)
+{
+    const auto requestedSize = size;
+    size                     = 0;
+    delta                    = (uint32) (offset & (PAGE_SIZE - 1));
+    const auto alignedOffset = offset - delta;
+#if defined(BUILD_FOR_WINDOWS)
+    auto hFile = CreateFileW(
+          path.c_str(),
+          GENERIC_READ,
+          FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+          nullptr,
+          OPEN_EXISTING,
+          FILE_ATTRIBUTE_NORMAL,
+          nullptr);
+    CHECK(hFile != INVALID_HANDLE_VALUE, nullptr, "Fail to open file for mapping (error: %u)", GetLastError());
+    LARGE_INTEGER li;
+    if ((GetFileSizeEx(hFile, &li) == FALSE) || (li.QuadPart <= 0) || (offset >= (uint64) li.QuadPart))
+    {
+        CloseHandle(hFile);
+        RETURNERROR(nullptr, "Unable to map an empty file (or an offset outside the file) !");
+    }
+    const auto fileSize = (uint64) li.QuadPart;
+    const auto dataSize = requestedSize == 0 ? fileSize - offset : std::min<>(requestedSize, fileSize - offset);
+    if (dataSize + delta > (uint64) SIZE_MAX)
+    {
+        CloseHandle(hFile);
+        RETURNERROR(nullptr, "Unable to map %llu bytes (too large) !", dataSize);
+    }
+    auto hMap = CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(hFile);
+    CHECK(hMap != nullptr, nullptr, "CreateFileMappingW failed (error: %u)", GetLastError());
+    auto p = MapViewOfFile(
+          hMap, FILE_MAP_READ, (DWORD) (alignedOffset >> 32), (DWORD) (alignedOffset & 0xFFFFFFFF), (SIZE_T) (dataSize + delta));
+    CloseHandle(hMap);
+    CHECK(p, nullptr, "MapViewOfFile failed (error: %u)", GetLastError());
+    size = dataSize;
+    if (capacity)
+        *capacity = dataSize;
+    return reinterpret_cast<uint8*>(p) + delta;
+#elif defined(BUILD_FOR_OSX) || defined(BUILD_FOR_UNIX)
+    auto fd = open(path.c_str(), O_RDONLY);
+    CHECK(fd >= 0, nullptr, "Fail to open file for mapping (errno: %d)", errno);
+    struct stat st;
+    // only regular files can be mapped (/proc entries, pipes or devices report a size of 0 or do not support mmap)
+    if ((fstat(fd, &st) != 0) || (!S_ISREG(st.st_mode)) || (st.st_size <= 0) || (offset >= (uint64) st.st_size))
+    {
+        close(fd);
+        RETURNERROR(nullptr, "File can not be mapped (not a regular file, empty or offset outside the file)");
+    }
+    const auto fileSize = (uint64) st.st_size;
+    const auto dataSize = requestedSize == 0 ? fileSize - offset : std::min<>(requestedSize, fileSize - offset);
+    if (dataSize + delta > (uint64) SIZE_MAX)
+    {
+        close(fd);
+        RETURNERROR(nullptr, "Unable to map %llu bytes (too large) !", dataSize);
+    }
+    auto reserved = dataSize;
+    void* p       = MAP_FAILED;
+    if ((capacity) && (sizeof(void*) >= 8))
+    {
+        reserved = dataSize + std::max<>(dataSize, MIN_MAPPING_RESERVE);
+        p        = mmap(nullptr, (size_t) (reserved + delta), PROT_READ, MAP_SHARED, fd, (off_t) alignedOffset);
+    }
+    if (p == MAP_FAILED)
+    {
+        reserved = dataSize;
+        p        = mmap(nullptr, (size_t) (dataSize + delta), PROT_READ, MAP_SHARED, fd, (off_t) alignedOffset);
+    }
+    close(fd);
+    CHECK(p != MAP_FAILED, nullptr, "mmap failed (errno: %d)", errno);
+    GuardMapping(p, reserved + delta);
+    size = dataSize;
+    if (capacity)
+        *capacity = reserved;
+    return reinterpret_cast<uint8*>(p) + delta;
+#else
+    return nullptr;
+#endif
+}
+// called when the file mapped at 'data' (from offset 0, by MapFile) grew inside its mapping : the pages of zeros that replaced
+// pages past the end of the file (see OnSigBus) are mapped from the file again, up to the end of the mapping ('capacity')
+static bool RefreshMapping(const std::filesystem::path& path, uint8* data, uint64 capacity)
+{
+#if defined(BUILD_FOR_OSX) || defined(BUILD_FOR_UNIX)
+    const auto patched = TakeFirstPatchedPage(data);
+    if ((patched == NO_PATCHED_PAGE) || (patched < (uintptr_t) data))
+        return true;
+    const auto from = (uint64) (patched - (uintptr_t) data);
+    if (from >= capacity)
+        return true;
+    auto fd = open(path.c_str(), O_RDONLY);
+    CHECK(fd >= 0, false, "Fail to open file for mapping (errno: %d)", errno);
+    auto p = mmap(data + from, (size_t) (capacity - from), PROT_READ, MAP_SHARED | MAP_FIXED, fd, (off_t) from);
+    close(fd);
+    CHECK(p != MAP_FAILED, false, "mmap failed (errno: %d)", errno);
+    return true;
+#else
+    return true; // a mapped file can not be truncated => no page was replaced
+#endif
+}
+static void UnmapFile(uint8* data, uint64 size, uint32 delta)
+{
+#if defined(BUILD_FOR_WINDOWS)
+    UnmapViewOfFile(data - delta);
+#elif defined(BUILD_FOR_OSX) || defined(BUILD_FOR_UNIX)
+    UnguardMapping(data - delta);
+    munmap(data - delta, (size_t) (size + delta));
+#endif
+}
 
 DataCache::DataCache()
 {
     this->fileObj    = nullptr;
     this->cache      = nullptr;
     this->cacheSize  = 0;
+    this->slotSize   = 0;
+    this->slotsCount = 0;
+    this->mruSlot    = 0;
+    this->tick       = 0;
     this->start      = 0;
     this->end        = 0;
     this->fileSize   = 0;
     this->currentPos = 0;
+    this->isMapped   = false;
+    this->ioLock     = nullptr;
+    this->stats      = {};
+
+    this->mappedFilePath   = nullptr;
+    this->mappedFileOffset = 0;
+    this->mappingDelta     = 0;
+    this->mappingSize      = 0;
+    this->oldMappings      = nullptr;
+    this->sharedFile       = nullptr;
+    memset(this->slots, 0, sizeof(this->slots));
 }
 DataCache::DataCache(DataCache&& obj)
 {
@@ -23,6 +364,20 @@ DataCache::DataCache(DataCache&& obj)
     currentPos     = obj.currentPos;
     cache          = obj.cache;
     cacheSize      = obj.cacheSize;
+    slotSize       = obj.slotSize;
+    slotsCount     = obj.slotsCount;
+    mruSlot        = obj.mruSlot;
+    tick           = obj.tick;
+    stats          = obj.stats;
+    isMapped       = obj.isMapped;
+    ioLock         = obj.ioLock;
+    memcpy(slots, obj.slots, sizeof(slots));
+    mappedFilePath   = obj.mappedFilePath;
+    mappedFileOffset = obj.mappedFileOffset;
+    mappingDelta     = obj.mappingDelta;
+    mappingSize      = obj.mappingSize;
+    oldMappings      = obj.oldMappings;
+    sharedFile       = obj.sharedFile;
     obj.fileObj    = nullptr;
     obj.fileSize   = 0;
     obj.start      = 0;
@@ -30,18 +385,46 @@ DataCache::DataCache(DataCache&& obj)
     obj.currentPos = 0;
     obj.cache      = nullptr;
     obj.cacheSize  = 0;
+    obj.slotSize   = 0;
+    obj.slotsCount = 0;
+    obj.isMapped   = false;
+    obj.ioLock     = nullptr;
+    memset(obj.slots, 0, sizeof(obj.slots));
+    obj.mappedFilePath   = nullptr;
+    obj.mappedFileOffset = 0;
+    obj.mappingDelta     = 0;
+    obj.mappingSize      = 0;
+    obj.oldMappings      = nullptr;
+    obj.sharedFile       = nullptr;
 }
 DataCache::~DataCache()
 {
-    if (this->fileObj)
+    // the file object is closed when the last reader created from this cache is destroyed
+    if (this->sharedFile)
+        this->sharedFile->Release();
+    this->sharedFile = nullptr;
+    this->fileObj    = nullptr;
+    this->ioLock     = nullptr;
+    if ((this->cache) && (this->isMapped))
+        UnmapFile(this->cache, this->mappingSize, this->mappingDelta);
+    for (auto& slot : this->slots)
     {
-        this->fileObj->Close();
-        delete this->fileObj;
+        if (slot.data)
+            delete[] slot.data;
+        slot.data = nullptr;
     }
-    this->fileObj = nullptr;
-    if (this->cache)
-        delete[] this->cache;
-    this->cache = nullptr;
+    this->cache    = nullptr;
+    this->isMapped = false;
+    if (this->mappedFilePath)
+        delete this->mappedFilePath;
+    this->mappedFilePath = nullptr;
+    if (this->oldMappings)
+    {
+        for (const auto& m : *this->oldMappings)
+            UnmapFile(m.data, m.size, m.delta);
+        delete this->oldMappings;
+    }
+    this->oldMappings = nullptr;
 }
 
 bool DataCache::Init(std::unique_ptr<AppCUI::OS::DataObject> file, uint32 _cacheSize)
@@ -55,42 +438,309 @@ bool DataCache::Init(std::unique_ptr<AppCUI::OS::DataObject> file, uint32 _cache
     _cacheSize     = std::min(_cacheSize, MAX_CACHE_SIZE);
     this->fileSize = fileObj->GetSize();
 
-    this->cache = new uint8[_cacheSize];
-    CHECK(this->cache, false, "Fail to allocate: %u bytes", _cacheSize);
+    if (this->fileSize <= _cacheSize)
+    {
+        // the entire file fits in one slot
+        this->slotsCount = 1;
+        this->slotSize   = _cacheSize;
+    }
+    else
+    {
+        this->slotsCount = MAX_SLOTS;
+        this->slotSize   = std::max<uint32>(PAGE_SIZE, (_cacheSize / MAX_SLOTS) & (uint32) PAGE_MASK);
+    }
+    // slot buffers are allocated on first use
+    this->sharedFile = new SharedFile(this->fileObj);
+    this->ioLock     = &this->sharedFile->lock;
     this->cacheSize = _cacheSize;
+    this->cache     = nullptr;
     this->start     = 0;
     this->end       = 0;
 
     return true;
 }
-BufferView DataCache::Get(uint64 offset, uint32 requestedSize, bool failIfRequestedSizeCanNotBeRead)
+bool DataCache::Init(std::unique_ptr<AppCUI::OS::File> file, const std::filesystem::path& path, uint32 _cacheSize)
 {
-    CHECK(this->fileObj, BufferView(), "File was not properly initialized !");
-    CHECK(requestedSize > 0, BufferView(), "'requestedSize' has to be bigger than 0 ");
+    CHECK(this->cacheSize == 0, false, "Cache object already initialized !");
+    CHECK(file, false, "Expecting a valid file object poiner !");
+
+    uint64 mappedSize = 0;
+    uint64 capacity   = 0;
+    uint32 delta      = 0;
+    auto mapped       = MapFile(path, 0, mappedSize, delta, &capacity);
+    if (mapped == nullptr)
+    {
+        // fallback to the regular (windowed) cache
+        return Init(std::unique_ptr<AppCUI::OS::DataObject>(file.release()), _cacheSize);
+    }
+    // the file object is kept (and closed on destruction) so that the ownership rules are the same for both modes
+    this->fileObj  = file.release();
+    this->fileSize = mappedSize;
+    // cacheSize is still reported to callers that process the file in chunks
+    _cacheSize      = (_cacheSize | 0xFFFF) + 1;
+    this->cacheSize = _cacheSize == 0 ? MAX_CACHE_SIZE : std::min(_cacheSize, MAX_CACHE_SIZE);
+    this->slotSize  = this->cacheSize;
+    // the entire file is "in cache" => Get() will always return a view directly into the mapping
+    this->cache    = mapped;
+    this->isMapped   = true;
+    this->sharedFile = new SharedFile(this->fileObj);
+    this->ioLock     = &this->sharedFile->lock;
+    this->start      = 0;
+    this->end        = mappedSize;
 
-    if (offset >= this->start)
+    this->mappedFilePath   = new std::filesystem::path(path);
+    this->mappedFileOffset = 0;
+    this->mappingDelta     = delta;
+    this->mappingSize      = capacity;
+
+    return true;
+}
+bool DataCache::Init(const DataCache& parent, uint64 offset, uint64 size, uint32 _cacheSize)
+{
+    CHECK(this->cacheSize == 0, false, "Cache object already initialized !");
+    CHECK((parent.isMapped) && (parent.mappedFilePath), false, "Parent object is not memory mapped !");
+    CHECK(offset < parent.fileSize, false, "Invalid offset (%llu) , should be less than %llu ", offset, parent.fileSize);
+    CHECK(size > 0, false, "Expecting a non-empty range !");
+    size = std::min<>(size, parent.fileSize - offset);
+
+    // the file is mapped again (the OS shares the physical pages between the two views) so that the new object
+    // does not depend on the lifetime of its parent
+    uint64 mappedSize = size;
+    uint32 delta      = 0;
+    auto mapped       = MapFile(*parent.mappedFilePath, parent.mappedFileOffset + offset, mappedSize, delta);
+    CHECK(mapped, false, "Fail to map %llu bytes from offset %llu", size, offset);
+    // the file could have been truncated in the meantime => only the bytes that still exist are exposed
+    size = mappedSize;
+
+    this->fileObj   = nullptr;
+    this->fileSize  = size;
+    _cacheSize      = (_cacheSize | 0xFFFF) + 1;
+    this->cacheSize = _cacheSize == 0 ? MAX_CACHE_SIZE : std::min(_cacheSize, MAX_CACHE_SIZE);
+    this->slotSize  = this->cacheSize;
+    this->cache     = mapped;
+    this->isMapped   = true;
+    this->sharedFile = new SharedFile(nullptr);
+    this->ioLock     = &this->sharedFile->lock;
+    this->start      = 0;
+    this->end        = size;
+
+    this->mappedFilePath   = new std::filesystem::path(*parent.mappedFilePath);
+    this->mappedFileOffset = parent.mappedFileOffset + offset;
+    this->mappingDelta     = delta;
+    this->mappingSize      = size;
+
+    return true;
+}
+bool DataCache::UpdateSize()
+{
+    if (this->isMapped)
+    {
+        // only a mapping of an entire file (not a slice of it or a reader created from it) follows the file
+        if ((this->fileObj == nullptr) || (this->mappedFilePath == nullptr) || (this->mappedFileOffset != 0))
+            return false;
+        std::error_code err;
+        const auto newSize = (uint64) std::filesystem::file_size(*this->mappedFilePath, err);
+        if ((err) || (newSize == this->fileSize))
+            return false;
+        if (newSize < this->fileSize)
+        {
+            // the mapping is kept (the views into it stay valid and, past the new end of the file, read zeros) ; an empty
+            // file can not be mapped anyway
+            this->fileSize = newSize;
+            this->end      = newSize;
+            return true;
+        }
+        if (newSize <= this->mappingSize)
+        {
+            // the file grew inside its mapping => the appended bytes are already mapped (the views stay valid)
+            CHECK(RefreshMapping(*this->mappedFilePath, this->cache, this->mappingSize), false, "Fail to map the file again");
+            this->fileSize = newSize;
+            this->end      = newSize;
+            return true;
+        }
+        // the file outgrew the reserved address space => it is mapped again (with twice as much reserved) ; the old mapping is
+        // kept because views into it may still be in use
+        uint64 mappedSize = 0;
+        uint64 capacity   = 0;
+        uint32 delta      = 0;
+        auto mapped       = MapFile(*this->mappedFilePath, 0, mappedSize, delta, &capacity);
+        CHECK(mapped, false, "Fail to map the file again (%llu bytes)", newSize);
+        if (mappedSize <= this->fileSize)
+        {
+            UnmapFile(mapped, capacity, delta);
+            return false;
+        }
+        if (this->oldMappings == nullptr)
+            this->oldMappings = new std::vector<Mapping>();
+        this->oldMappings->push_back({ this->cache, this->mappingSize, this->mappingDelta });
+        this->cache        = mapped;
+        this->mappingDelta = delta;
+        this->mappingSize  = capacity;
+        this->fileSize     = mappedSize;
+        this->end          = mappedSize;
+        return true;
+    }
+    CHECK(this->fileObj, false, "File was not properly initialized !");
+    uint64 newSize;
+    {
+        std::lock_guard<std::mutex> guard(*this->ioLock);
+        newSize = this->fileObj->GetSize();
+    }
+    if (newSize == this->fileSize)
+        return false;
+    if (newSize < this->fileSize)
     {
-        // data is cached --> return from here
-        if ((offset + requestedSize) <= this->end)
+        // the file was truncated (and may be written again) => the windows that pass the new end are dropped ; the pinned
+        // ones are kept for their users, but they are not used by Get anymore
+        for (auto index = 0U; index < this->slotsCount; index++)
         {
-            this->currentPos = offset + requestedSize;
-            return BufferView(&this->cache[offset - this->start], requestedSize);
+            auto& slot = this->slots[index];
+            if (slot.end <= newSize)
+                continue;
+            if (slot.pins == 0)
+                slot.start = slot.end = 0;
+            else
+                slot.detached = true;
         }
-        if (this->end == this->fileSize)
+        if (this->end > newSize)
         {
-            // data is not cache (and we are at the end of the file with the case)
-            if (failIfRequestedSizeCanNotBeRead)
-                return BufferView();
-            this->currentPos = this->fileSize;
-            return BufferView(&this->cache[offset - this->start], (uint32) (this->end - offset));
+            this->start = 0;
+            this->end   = 0;
+            this->cache = nullptr;
         }
+        this->currentPos = std::min<>(this->currentPos, newSize);
     }
+    // if the file grew, the windows that were cut at the old end of the file stay valid ; a read that passes the old end
+    // does not fit in them => it reads a new window
+    this->fileSize = newSize;
+    return true;
+}
+bool DataCache::ReadFromObject(uint64 offset, void* buffer, uint32 size)
+{
+    std::lock_guard<std::mutex> guard(*this->ioLock);
+    CHECK(this->fileObj->SetCurrentPos(offset), false, "Fail to move to offset %llu", offset);
+    CHECK(this->fileObj->Read(buffer, size), false, "Fail to read %u bytes from offset %llu", size, offset);
+    this->stats.readBytes += size;
+    return true;
+}
+bool DataCache::ReadDirect(uint64 offset, void* buffer, uint32 size)
+{
+    CHECK((this->fileObj) || (this->isMapped), false, "File was not properly initialized !");
+    CHECK(buffer, false, "Expecting a valid pointer for a buffer !");
+    CHECK(offset + (uint64) size <= this->fileSize, false, "Unable to read %u bytes from %llu", size, offset);
+    if (this->isMapped)
+    {
+        memcpy(buffer, &this->cache[offset], size);
+        return true;
+    }
+    // 'stats' are not updated here (they are owned by the thread that uses Get)
+    std::lock_guard<std::mutex> guard(*this->ioLock);
+    CHECK(this->fileObj->SetCurrentPos(offset), false, "Fail to move to offset %llu", offset);
+    CHECK(this->fileObj->Read(buffer, size), false, "Fail to read %u bytes from offset %llu", size, offset);
+    return true;
+}
+std::unique_ptr<AppCUI::OS::DataObject> DataCache::CreateRangeReader(uint64 offset, uint64 size)
+{
+    CHECK(this->fileObj, nullptr, "This object does not have a file object (memory mapped slice) !");
+    CHECK(offset <= this->fileSize, nullptr, "Invalid offset (%llu) , should be at most %llu ", offset, this->fileSize);
+    return std::make_unique<RangeReader>(this->sharedFile, offset, std::min<>(size, this->fileSize - offset));
+}
+void DataCache::Prefetch(uint64 offset, uint64 size)
+{
+    if ((!this->isMapped) || (offset >= this->fileSize) || (size == 0))
+        return;
+    size = std::min<>(size, this->fileSize - offset);
+#if defined(BUILD_FOR_WINDOWS)
+#    if (_WIN32_WINNT >= 0x0602)
+    WIN32_MEMORY_RANGE_ENTRY range;
+    range.VirtualAddress = &this->cache[offset];
+    range.NumberOfBytes  = (SIZE_T) size;
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#    endif
+#elif defined(BUILD_FOR_OSX) || defined(BUILD_FOR_UNIX)
+    // madvise requires a page aligned address
+    const auto pageSize = (uint64) sysconf(_SC_PAGESIZE);
+    const auto alignedOffset = offset - (offset % pageSize);
+    madvise(&this->cache[alignedOffset], (size_t) (size + offset - alignedOffset), MADV_WILLNEED);
+#endif
+}
+void DataCache::SetMostRecentlyUsedSlot(uint32 index)
+{
+    auto& slot    = this->slots[index];
+    slot.lastUsed = ++this->tick;
+    this->mruSlot = index;
+    this->start   = slot.start;
+    this->end     = slot.end;
+    this->cache   = slot.data;
+}
+int32 DataCache::FindSlot(uint64 offset, uint64 endOffset) const
+{
+    for (auto index = 0U; index < this->slotsCount; index++)
+    {
+        const auto& slot = this->slots[index];
+        if ((offset >= slot.start) && (endOffset <= slot.end) && (!slot.detached))
+            return (int32) index;
+    }
+    return -1;
+}
+int32 DataCache::FindVictimSlot(uint32 windowSize) const
+{
+    // large windows prefer slots that are already large enough (this keeps at most one oversized slot alive)
+    int32 victim = -1, large = -1;
+    for (auto index = 0U; index < this->slotsCount; index++)
+    {
+        const auto& slot = this->slots[index];
+        if (slot.pins > 0)
+            continue;
+        if ((victim < 0) || (slot.lastUsed < this->slots[victim].lastUsed))
+            victim = (int32) index;
+        if ((windowSize > this->slotSize) && (slot.allocated >= windowSize))
+        {
+            if ((large < 0) || (slot.lastUsed < this->slots[large].lastUsed))
+                large = (int32) index;
+        }
+    }
+    return large >= 0 ? large : victim;
+}
+BufferView DataCache::Get(uint64 offset, uint32 requestedSize, bool failIfRequestedSizeCanNotBeRead)
+{
+    CHECK((this->fileObj) || (this->isMapped), BufferView(), "File was not properly initialized !");
+    CHECK(requestedSize > 0, BufferView(), "'requestedSize' has to be bigger than 0 ");
+
     // request outside file
     if (offset >= this->fileSize)
         return BufferView();
-    // data is not available in cache ==> read it
+    auto endOffset = offset + requestedSize;
+    if (endOffset > this->fileSize)
+    {
+        if (failIfRequestedSizeCanNotBeRead)
+            return BufferView();
+        endOffset = this->fileSize;
+    }
+    this->stats.requestedBytes += endOffset - offset;
+
+    // most recently used window (or the memory mapping) --> return from here
+    if ((offset >= this->start) && (endOffset <= this->end))
+    {
+        this->stats.hits++;
+        if (!this->isMapped)
+            this->slots[this->mruSlot].lastUsed = ++this->tick;
+        this->currentPos = endOffset;
+        return BufferView(&this->cache[offset - this->start], (size_t) (endOffset - offset));
+    }
+    // any other slot
+    auto index = FindSlot(offset, endOffset);
+    if (index >= 0)
+    {
+        this->stats.hits++;
+        SetMostRecentlyUsedSlot(index);
+        this->currentPos = endOffset;
+        return BufferView(&this->cache[offset - this->start], (size_t) (endOffset - offset));
+    }
+
+    // data is not available in cache ==> read it in a new window
     uint64 _start, _end;
-    if (this->fileSize <= this->cacheSize)
+    if (this->fileSize <= this->slotSize)
     {
         // read everything
         _start = 0;
@@ -98,48 +748,85 @@ BufferView DataCache::Get(uint64 offset, uint32 requestedSize, bool failIfReques
     }
     else
     {
-        // compute the new buffer to read
-        auto sz = requestedSize;
-        if ((offset + sz) > this->fileSize)
-            sz = (uint32) (this->fileSize - offset);
-        if (sz > this->cacheSize)
-            sz = this->cacheSize;
-        auto diff = this->cacheSize - sz;
-        if (diff <= offset)
-            _start = offset - diff;
-        else
-            _start = 0;
-        _end = _start + this->cacheSize;
+        _start = offset & PAGE_MASK;
+        _end   = std::max<>(((endOffset - 1) | (PAGE_SIZE - 1)) + 1, _start + this->slotSize);
+        if ((_end - _start) > this->cacheSize)
+        {
+            // huge request => read as much as possible starting from the requested offset
+            _start = offset;
+            _end   = offset + this->cacheSize;
+        }
         if (_end > this->fileSize)
             _end = this->fileSize;
     }
-    // read new data in cache
-    if (this->fileObj->SetCurrentPos(_start) == false)
-        return BufferView();
-    if (this->fileObj->Read(this->cache, (uint32) (_end - _start)) == false)
+    const auto windowSize = (uint32) (_end - _start);
+
+    index = FindVictimSlot(windowSize);
+    CHECK(index >= 0, BufferView(), "All cache slots are pinned (unable to read %u bytes from %llu)", requestedSize, offset);
+    auto& slot = this->slots[index];
+    if ((uint32) index == this->mruSlot)
     {
+        // current window is about to be replaced
         this->start = 0;
         this->end   = 0;
-        return BufferView();
+        this->cache = nullptr;
     }
-    // return new pointer
-    this->start = _start;
-    this->end   = _end;
-    if ((offset + requestedSize) <= this->end)
+    slot.start = 0;
+    slot.end   = 0;
+    // reallocate if the buffer is too small (or if it is an oversized buffer that can be trimmed)
+    if ((slot.allocated < windowSize) || ((slot.allocated > this->slotSize) && (windowSize <= this->slotSize)))
     {
-        this->currentPos = offset + requestedSize;
-        return BufferView(&this->cache[offset - this->start], requestedSize);
+        if (slot.data)
+            delete[] slot.data;
+        slot.allocated = this->slotsCount == 1 ? windowSize : std::max<>(windowSize, this->slotSize);
+        slot.data      = new uint8[slot.allocated];
+    }
+    this->stats.misses++;
+    if (ReadFromObject(_start, slot.data, windowSize) == false)
+        return BufferView();
+    slot.start = _start;
+    slot.end   = _end;
+    SetMostRecentlyUsedSlot(index);
+
+    if (endOffset <= this->end)
+    {
+        this->currentPos = endOffset;
+        return BufferView(&this->cache[offset - this->start], (size_t) (endOffset - offset));
     }
     // the entire data is not in our cache
     if (failIfRequestedSizeCanNotBeRead)
         return BufferView();
-    if (this->end == this->fileSize)
+    this->currentPos = this->end;
+    return BufferView(&this->cache[offset - this->start], (size_t) (this->end - offset));
+}
+BufferView DataCache::Pin(uint64 offset, uint32 requestedSize, bool failIfRequestedSizeCanNotBeRead)
+{
+    auto b = Get(offset, requestedSize, failIfRequestedSizeCanNotBeRead);
+    // views into a memory mapped file are always valid
+    if ((b.IsValid()) && (!this->isMapped))
+        this->slots[this->mruSlot].pins++;
+    return b;
+}
+void DataCache::Unpin(BufferView view)
+{
+    if ((this->isMapped) || (!view.IsValid()))
+        return;
+    const auto* p = view.GetData();
+    for (auto index = 0U; index < this->slotsCount; index++)
     {
-        this->currentPos = this->fileSize;
-        return BufferView(&this->cache[offset - this->start], (uint32) (this->end - offset));
+        auto& slot = this->slots[index];
+        if ((slot.pins > 0) && (p >= slot.data) && (p < slot.data + (slot.end - slot.start)))
+        {
+            slot.pins--;
+            if ((slot.pins == 0) && (slot.detached))
+            {
+                slot.start = slot.end = 0;
+                slot.detached         = false;
+            }
+            return;
+        }
     }
-    this->currentPos = this->end;
-    return BufferView(&this->cache[offset - this->start], (uint32) (this->end - offset));
+    LOG_ERROR("Unpin called for a view that is not pinned !");
 }
 bool DataCache::CopyObject(void* buffer, uint64 offset, uint32 requestedSize)
 {
@@ -152,69 +839,59 @@ bool DataCache::CopyObject(void* buffer, uint64 offset, uint32 requestedSize)
 Buffer DataCache::CopyToBuffer(uint64 offset, uint32 requestedSize, bool failIfRequestedSizeCanNotBeRead)
 {
     // sanity checks
+    CHECK((this->fileObj) || (this->isMapped), Buffer(), "File was not properly initialized !");
     CHECK(requestedSize > 0, Buffer(), "Invalid requested size (should be bigger than 0)");
     CHECK(offset <= this->fileSize, Buffer(), "Invalid offset (%llu) , should be less than %llu ", offset, this->fileSize);
     if (failIfRequestedSizeCanNotBeRead)
     {
         CHECK(offset + (uint64) requestedSize <= this->fileSize, Buffer(), "Unable to read %u bytes from %llu", requestedSize, offset);
     }
+    const auto size = (uint32) std::min<uint64>(requestedSize, this->fileSize - offset);
+    if (size == 0)
+        return Buffer();
 
     Buffer b{};
-    b.Resize(requestedSize);
-    uint32 toRead = this->cacheSize >> 1;
-    auto p        = b.GetData();
-    while (requestedSize)
-    {
-        toRead  = std::min(toRead, requestedSize);
-        auto bv = this->Get(offset, toRead, false);
-        if (bv.Empty())
-        {
-            LOG_ERROR("Empty buffer received when reading %u bytes from %llu offset", toRead, offset);
-            if (failIfRequestedSizeCanNotBeRead)
-                return Buffer();
-            // trim the buffer size to the amount of data that was read
-            b.Resize(p - b.GetData());
-            return b;
-        }
-        if (toRead != bv.GetLength())
-        {
-            LOG_ERROR("Only %u bytes received when trying to read %u bytes from %llu offset", bv.GetLength(), toRead, offset);
-            if (failIfRequestedSizeCanNotBeRead)
-                return Buffer();
-            // copy the buffer that was read
-            if (bv.GetLength() > 0)
-            {
-                memcpy(p, bv.GetData(), bv.GetLength());
-            }
-            p += bv.GetLength();
-            // trim the buffer size to the amount of data that was read
-            b.Resize(p - b.GetData());
-            return b;
-        }
-        memcpy(p, bv.GetData(), toRead);
-        p += toRead;
-        offset += toRead;
-        requestedSize -= toRead;
+    b.Resize(size);
+    this->stats.requestedBytes += size;
+    // data is already cached (or mapped) => copy it from there
+    if ((offset >= this->start) && (offset + size <= this->end))
+    {
+        this->stats.hits++;
+        memcpy(b.GetData(), &this->cache[offset - this->start], size);
+        return b;
+    }
+    auto index = FindSlot(offset, offset + size);
+    if (index >= 0)
+    {
+        this->stats.hits++;
+        const auto& slot = this->slots[index];
+        memcpy(b.GetData(), &slot.data[offset - slot.start], size);
+        return b;
+    }
+    // read it directly into the buffer (large copies should not evict the slots used by the viewers)
+    this->stats.misses++;
+    if (ReadFromObject(offset, b.GetData(), size) == false)
+    {
+        LOG_ERROR("Fail to read %u bytes from %llu offset", size, offset);
+        return Buffer();
     }
     return b;
 }
-bool DataCache::WriteTo(Reference<AppCUI::OS::DataObject> output, uint64 offset, uint32 size)
+bool DataCache::WriteTo(Reference<AppCUI::OS::DataObject> output, uint64 offset, uint64 size)
 {
     CHECK(output->SetSize(size), false, "");
     CHECK(output->SetCurrentPos(0), false, "");
 
     if (size == 0)
         return true; // nothing to write
+    CHECK(offset + size <= this->fileSize, false, "Unable to write %llu bytes from %llu", size, offset);
 
-    uint32 toRead = this->cacheSize >> 1;
-    while (size)
-    {
-        toRead  = std::min(toRead, size);
-        auto bv = this->Get(offset, toRead, true);
-        CHECK(bv.IsValid(), false, "");
-        CHECK(output->Write(bv.begin(), toRead), false, "");
-        offset += toRead;
-        size -= toRead;
-    }
-    return true;
+    // the next chunk is read while the current one is written (and the cache slots are not evicted)
+    auto written = true;
+    auto read    = ForEachChunk(
+          offset,
+          size,
+          [output, &written](uint64, BufferView buf) { return written = output->Write(buf.GetData(), (uint32) buf.GetLength()); },
+          this->slotSize);
+    return read && written;
 }
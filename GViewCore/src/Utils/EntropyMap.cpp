@@ -0,0 +1,268 @@
+#include "GView.hpp"
+#include <cmath>
+#include <thread>
+
+using namespace GView::Utils;
+
+constexpr uint32 BLOCKS_PER_TASK    = 64; // a worker reads 256 KB at once
+constexpr uint32 TASK_SIZE          = BLOCKS_PER_TASK * EntropyMap::BLOCK_SIZE;
+constexpr uint32 MAX_WORKERS        = 16;
+constexpr uint32 ENTROPY_SCALE      = 256; // entropy is stored as a fixed point value (8 bits/byte => 2048)
+constexpr uint16 ENTROPY_MASK       = 0x0FFF;
+constexpr uint32 TYPE_SHIFT         = 12;
+constexpr double PACKED_MIN_ENTROPY = 7.2;
+
+// each block is stored on 16 bits: (BlockType << 12) | (entropy * 256) ; 0 means that the block was not computed yet
+struct InternalEntropyMap
+{
+    GView::Object& obj;
+    uint64 size;
+    uint64 blocksCount;
+    uint64 tasksCount;
+    uint64 firstTask;
+    std::unique_ptr<std::atomic<uint16>[]> blocks;
+    std::vector<std::thread> workers;
+    std::atomic<uint64> nextTask;
+    std::atomic<uint32> runningWorkers;
+    std::atomic<bool> stop;
+    bool started;
+
+    InternalEntropyMap(GView::Object& o) : obj(o), size(0), blocksCount(0), tasksCount(0), firstTask(0), started(false)
+    {
+        nextTask       = 0;
+        runningWorkers = 0;
+        stop           = false;
+    }
+};
+
+// c * log2(c) for every possible count of a byte inside a block
+static const float* GetCountLogTable()
+{
+    static const std::unique_ptr<float[]> table = []()
+    {
+        auto t = std::make_unique<float[]>(EntropyMap::BLOCK_SIZE + 1);
+        t[0]   = 0.0f;
+        for (uint32 c = 1; c <= EntropyMap::BLOCK_SIZE; c++)
+            t[c] = (float) (c * std::log2((double) c));
+        return t;
+    }();
+    return table.get();
+}
+static uint16 ComputeBlock(const uint8* p, uint32 size)
+{
+    uint32 counts[256] = {};
+    for (uint32 tr = 0; tr < size; tr++)
+        counts[p[tr]]++;
+
+    if (counts[0] == size)
+        return ((uint16) EntropyMap::BlockType::Zero) << TYPE_SHIFT;
+
+    // H = log2(n) - sum(c * log2(c)) / n
+    const auto* clog = GetCountLogTable();
+    double sum       = 0;
+    uint32 text      = counts['\t'] + counts['\n'] + counts['\r'];
+    for (uint32 tr = 0; tr < 256; tr++)
+        sum += clog[counts[tr]];
+    for (uint32 tr = 32; tr < 127; tr++)
+        text += counts[tr];
+    const auto entropy = std::max<>(0.0, std::log2((double) size) - sum / size);
+
+    EntropyMap::BlockType type;
+    if ((uint64) text * 10 >= (uint64) size * 9)
+        type = EntropyMap::BlockType::Text;
+    else if (entropy >= PACKED_MIN_ENTROPY)
+        type = EntropyMap::BlockType::Packed;
+    else
+        type = EntropyMap::BlockType::Binary;
+    const auto value = std::min<uint32>((uint32) (entropy * ENTROPY_SCALE + 0.5), 8 * ENTROPY_SCALE);
+    return (uint16) ((((uint32) type) << TYPE_SHIFT) | value);
+}
+static bool IsTaskComputed(InternalEntropyMap* m, uint64 offset, uint32 size)
+{
+    for (uint32 pos = 0; pos < size; pos += EntropyMap::BLOCK_SIZE)
+        if (m->blocks[(offset + pos) / EntropyMap::BLOCK_SIZE].load(std::memory_order_relaxed) == 0)
+            return false;
+    return true;
+}
+static void EntropyWorker(InternalEntropyMap* m, std::unique_ptr<DataCache> reader)
+{
+    std::vector<uint8> buf(TASK_SIZE);
+    while (!m->stop.load(std::memory_order_relaxed))
+    {
+        const auto idx = m->nextTask.fetch_add(1);
+        if (idx >= m->tasksCount)
+            break;
+        // tasks are taken in order starting from the one that was requested first (wrapping at the end of the object)
+        const auto task   = (m->firstTask + idx) % m->tasksCount;
+        const auto offset = task * TASK_SIZE;
+        const auto size   = (uint32) std::min<uint64>(TASK_SIZE, m->size - offset);
+        if (IsTaskComputed(m, offset, size))
+            continue; // computed before the workers were stopped (or on the spot)
+        if (!reader->ReadDirect(offset, buf.data(), size))
+            continue; // these blocks will be computed on the spot (if requested)
+        for (uint32 pos = 0; pos < size; pos += EntropyMap::BLOCK_SIZE)
+        {
+            auto& block = m->blocks[(offset + pos) / EntropyMap::BLOCK_SIZE];
+            if (block.load(std::memory_order_relaxed) == 0)
+            {
+                const auto value = ComputeBlock(buf.data() + pos, std::min<uint32>(EntropyMap::BLOCK_SIZE, size - pos));
+                block.store(value, std::memory_order_relaxed);
+            }
+        }
+    }
+    m->runningWorkers--;
+}
+static void StopWorkers(InternalEntropyMap* m)
+{
+    m->stop = true;
+    for (auto& w : m->workers)
+        if (w.joinable())
+            w.join();
+    m->workers.clear();
+}
+// (re)allocates the blocks for an object of 'size' bytes ; the workers must be stopped
+static void Resize(InternalEntropyMap* m, uint64 size)
+{
+    auto blocks = std::make_unique<std::atomic<uint16>[]>((size + EntropyMap::BLOCK_SIZE - 1) / EntropyMap::BLOCK_SIZE);
+    if (m->started)
+    {
+        // only the blocks that are complete both before and after the resize keep their value
+        const auto kept = std::min<>(m->size, size) / EntropyMap::BLOCK_SIZE;
+        for (uint64 idx = 0; idx < kept; idx++)
+            blocks[idx].store(m->blocks[idx].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    m->size        = size;
+    m->blocksCount = (size + EntropyMap::BLOCK_SIZE - 1) / EntropyMap::BLOCK_SIZE;
+    m->blocks      = std::move(blocks);
+    m->started     = true;
+}
+static uint16 GetBlockValue(InternalEntropyMap* m, uint64 offset)
+{
+    if (!m->started)
+        Resize(m, m->obj.GetData().GetSize());
+    if (offset >= m->size)
+        return 0;
+    auto& block = m->blocks[offset / EntropyMap::BLOCK_SIZE];
+    auto value  = block.load(std::memory_order_relaxed);
+    if (value != 0)
+        return value;
+
+    uint8 buf[EntropyMap::BLOCK_SIZE];
+    const auto start = offset - offset % EntropyMap::BLOCK_SIZE;
+    const auto size  = (uint32) std::min<uint64>(EntropyMap::BLOCK_SIZE, m->size - start);
+    if (!m->obj.GetData().ReadDirect(start, buf, size))
+        return 0;
+    value = ComputeBlock(buf, size);
+    block.store(value, std::memory_order_relaxed);
+    return value;
+}
+
+EntropyMap::EntropyMap(Object& obj)
+{
+    data = new InternalEntropyMap(obj);
+}
+EntropyMap::~EntropyMap()
+{
+    Stop();
+    delete reinterpret_cast<InternalEntropyMap*>(data);
+    data = nullptr;
+}
+void EntropyMap::Start(uint64 offset)
+{
+    auto m = reinterpret_cast<InternalEntropyMap*>(data);
+    // an object that grows (or shrinks) is computed again, except for the blocks that did not change their size
+    const auto size = m->obj.GetData().GetSize();
+    if ((m->started) && (size != m->size))
+    {
+        StopWorkers(m);
+        Resize(m, size);
+    }
+    if (!m->workers.empty())
+        return;
+    if (!m->started)
+        Resize(m, size); // only allocates the blocks, every one of them is computed by the workers
+    if (m->blocksCount == 0)
+        return;
+
+    m->tasksCount = (m->size + TASK_SIZE - 1) / TASK_SIZE;
+    m->firstTask  = std::min<uint64>(offset / TASK_SIZE, m->tasksCount - 1);
+    m->nextTask   = 0;
+    m->stop       = false;
+
+    const auto count = (uint32) std::min<uint64>(std::clamp<uint32>(std::thread::hardware_concurrency(), 1, MAX_WORKERS), m->tasksCount);
+    for (uint32 tr = 0; tr < count; tr++)
+    {
+        auto reader = m->obj.CreateReader();
+        if (!reader)
+            break;
+        m->runningWorkers++;
+        m->workers.emplace_back(EntropyWorker, m, std::move(reader));
+    }
+}
+void EntropyMap::Stop()
+{
+    // the computed blocks are kept ; a later Start() continues with the remaining ones
+    StopWorkers(reinterpret_cast<InternalEntropyMap*>(data));
+}
+bool EntropyMap::IsCompleted() const
+{
+    auto m = reinterpret_cast<InternalEntropyMap*>(data);
+    return (!m->workers.empty()) && (m->runningWorkers == 0) && (m->nextTask >= m->tasksCount);
+}
+uint64 EntropyMap::GetBlocksCount() const
+{
+    auto m = reinterpret_cast<InternalEntropyMap*>(data);
+    return m->started ? m->blocksCount : (m->obj.GetData().GetSize() + BLOCK_SIZE - 1) / BLOCK_SIZE;
+}
+double EntropyMap::GetEntropy(uint64 offset)
+{
+    Start(offset);
+    const auto value = GetBlockValue(reinterpret_cast<InternalEntropyMap*>(data), offset);
+    return ((double) (value & ENTROPY_MASK)) / ENTROPY_SCALE;
+}
+double EntropyMap::GetEntropy(uint64 offset, uint64 size)
+{
+    Start(offset);
+    auto m = reinterpret_cast<InternalEntropyMap*>(data);
+    if ((offset >= m->size) || (size == 0))
+        return 0.0;
+    const auto end = std::min<uint64>(m->size - offset, size) + offset;
+    uint64 sum = 0, count = 0;
+    for (auto ofs = offset - offset % BLOCK_SIZE; ofs < end; ofs += BLOCK_SIZE, count++)
+        sum += GetBlockValue(m, ofs) & ENTROPY_MASK;
+    return ((double) sum) / ((double) count * ENTROPY_SCALE);
+}
+EntropyMap::BlockType EntropyMap::GetBlockType(uint64 offset)
+{
+    Start(offset);
+    return static_cast<BlockType>(GetBlockValue(reinterpret_cast<InternalEntropyMap*>(data), offset) >> TYPE_SHIFT);
+}
+bool EntropyMap::TryGet(uint64 offset, uint64 size, double& entropy) const
+{
+    auto m = reinterpret_cast<InternalEntropyMap*>(data);
+    if ((!m->started) || (offset >= m->size) || (size == 0))
+        return false;
+    const auto end = std::min<uint64>(m->size - offset, size) + offset;
+    uint64 sum = 0, count = 0;
+    for (auto ofs = offset - offset % BLOCK_SIZE; ofs < end; ofs += BLOCK_SIZE, count++)
+    {
+        const auto value = m->blocks[ofs / BLOCK_SIZE].load(std::memory_order_relaxed);
+        if (value == 0)
+            return false;
+        sum += value & ENTROPY_MASK;
+    }
+    entropy = ((double) sum) / ((double) count * ENTROPY_SCALE);
+    return true;
+}
+bool EntropyMap::TryGet(uint64 offset, double& entropy, BlockType& type) const
+{
+    auto m = reinterpret_cast<InternalEntropyMap*>(data);
+    if ((!m->started) || (offset >= m->size))
+        return false;
+    const auto value = m->blocks[offset / BLOCK_SIZE].load(std::memory_order_relaxed);
+    if (value == 0)
+        return false;
+    entropy = ((double) (value & ENTROPY_MASK)) / ENTROPY_SCALE;
+    type    = static_cast<BlockType>(value >> TYPE_SHIFT);
+    return true;
+}
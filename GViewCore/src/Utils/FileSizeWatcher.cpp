@@ -0,0 +1,51 @@
+#include "Internal.hpp"
+
+using namespace GView::Utils;
+
+static uint64 ReadFileSize(const std::filesystem::path& path)
+{
+    std::error_code err;
+    const auto size = std::filesystem::file_size(path, err);
+    return err ? INVALID_OFFSET : (uint64) size;
+}
+
+FileSizeWatcher::FileSizeWatcher()
+{
+    this->size = INVALID_OFFSET;
+    this->stop = false;
+}
+FileSizeWatcher::~FileSizeWatcher()
+{
+    Stop();
+}
+bool FileSizeWatcher::Start(std::u16string_view filePath)
+{
+    CHECK(!this->thread.joinable(), false, "The watcher was already started !");
+    CHECK(!filePath.empty(), false, "Only the objects that have a path can be watched !");
+    this->path   = filePath;
+    this->size   = ReadFileSize(this->path);
+    this->stop   = false;
+    this->thread = std::thread(&FileSizeWatcher::Run, this);
+    return true;
+}
+void FileSizeWatcher::Stop()
+{
+    {
+        std::lock_guard<std::mutex> guard(this->lock);
+        this->stop = true;
+    }
+    this->stopRequested.notify_all();
+    if (this->thread.joinable())
+        this->thread.join();
+}
+void FileSizeWatcher::Run()
+{
+    std::unique_lock<std::mutex> guard(this->lock);
+    while (!this->stopRequested.wait_for(guard, POLL_INTERVAL, [this] { return this->stop; }))
+    {
+        // the file is not read under the lock => Stop does not wait for a slow file system
+        guard.unlock();
+        this->size.store(ReadFileSize(this->path), std::memory_order_relaxed);
+        guard.lock();
+    }
+}
@@ -0,0 +1,385 @@
+#include "Internal.hpp"
+
+#include <bit>
+
+#if defined(__AVX2__)
+#    include <immintrin.h>
+#    define LINES_USE_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#    include <emmintrin.h>
+#    define LINES_USE_SSE2
+#endif
+
+using namespace GView::Utils;
+
+constexpr uint64 MAX_LINE_SIZE = 0x80000000; // longer lines are split (the size of a line is stored on 32 bits)
+
+#if defined(LINES_USE_AVX2)
+constexpr uint32 BLOCK_SIZE = 32;
+#    define LINES_USE_SIMD
+#elif defined(LINES_USE_SSE2)
+constexpr uint32 BLOCK_SIZE = 16;
+#    define LINES_USE_SIMD
+#endif
+
+namespace
+{
+struct InternalLineScanner
+{
+    LineScanner::Encoding encoding;
+    uint32 maxChars;
+    uint32 unitSize;
+    uint64 offset; // offset of the next character
+    uint64 lineStart;
+    uint32 charsCount;
+    uint16 newLine;            // '\n' or '\r' => the line that it ended is reported once the next character is known
+    LineScanner::Line pending; // the line ended by 'newLine'
+    uint8 carry;               // UTF-16: the first byte of a character that was split between two chunks
+    bool hasCarry;
+    bool useSimd; // false => every byte is checked one at a time (the reference for SelfCheck)
+
+    InternalLineScanner(LineScanner::Encoding enc, uint64 start, uint32 maxCharsPerLine)
+        : encoding(enc), maxChars(maxCharsPerLine), offset(start), lineStart(start), charsCount(0), newLine(0), pending{}, carry(0),
+          hasCarry(false), useSimd(true)
+    {
+        unitSize = ((enc == LineScanner::Encoding::UTF16LE) || (enc == LineScanner::Encoding::UTF16BE)) ? 2 : 1;
+    }
+    void EndLine(std::vector<LineScanner::Line>& lines)
+    {
+        lines.push_back({ lineStart, (uint32) (offset - lineStart), charsCount, 0 });
+        lineStart  = offset;
+        charsCount = 0;
+    }
+    // one byte (or one UTF-16 character) ; 'first' is false for the UTF-8 continuation bytes
+    void Step(uint16 ch, bool first, std::vector<LineScanner::Line>& lines)
+    {
+        if (newLine != 0)
+        {
+            const auto pairEnd = ((ch == '\n') && (newLine == '\r')) || ((ch == '\r') && (newLine == '\n'));
+            newLine            = 0;
+            if (pairEnd)
+            {
+                pending.newLineSize += unitSize;
+                lines.push_back(pending);
+                offset += unitSize;
+                lineStart = offset;
+                return;
+            }
+            lines.push_back(pending);
+        }
+        if ((ch == '\n') || (ch == '\r'))
+        {
+            if ((maxChars > 0) && (charsCount >= maxChars))
+                EndLine(lines);
+            pending = { lineStart, (uint32) (offset - lineStart), charsCount, unitSize };
+            newLine = ch;
+            offset += unitSize;
+            lineStart  = offset;
+            charsCount = 0;
+            return;
+        }
+        if (first)
+        {
+            // the split is done when the next character starts => the last character keeps all of its bytes
+            if ((charsCount > 0) && (((maxChars > 0) && (charsCount >= maxChars)) || (offset - lineStart >= MAX_LINE_SIZE)))
+                EndLine(lines);
+            charsCount++;
+        }
+        offset += unitSize;
+    }
+#if defined(LINES_USE_SIMD)
+    // one bit per byte for the new line characters and for the bytes that start a character
+    inline void Classify(const uint8* p, uint32& newLines, uint32& starts) const
+    {
+#    if defined(LINES_USE_AVX2)
+        const auto d = _mm256_loadu_si256((const __m256i*) p);
+        switch (encoding)
+        {
+        case LineScanner::Encoding::UTF16LE:
+        case LineScanner::Encoding::UTF16BE:
+        {
+            const auto be = encoding == LineScanner::Encoding::UTF16BE;
+            const auto lf = _mm256_cmpeq_epi16(d, _mm256_set1_epi16(be ? 0x0A00 : 0x000A));
+            const auto cr = _mm256_cmpeq_epi16(d, _mm256_set1_epi16(be ? 0x0D00 : 0x000D));
+            newLines      = (uint32) _mm256_movemask_epi8(_mm256_or_si256(lf, cr));
+            starts        = 0x55555555;
+            return;
+        }
+        default:
+            break;
+        }
+        const auto lf = _mm256_cmpeq_epi8(d, _mm256_set1_epi8('\n'));
+        const auto cr = _mm256_cmpeq_epi8(d, _mm256_set1_epi8('\r'));
+        newLines      = (uint32) _mm256_movemask_epi8(_mm256_or_si256(lf, cr));
+        if (encoding == LineScanner::Encoding::UTF8)
+        {
+            const auto cont = _mm256_cmpeq_epi8(_mm256_and_si256(d, _mm256_set1_epi8((char) 0xC0)), _mm256_set1_epi8((char) 0x80));
+            starts          = ~(uint32) _mm256_movemask_epi8(cont);
+        }
+        else
+            starts = 0xFFFFFFFF;
+#    else
+        const auto d = _mm_loadu_si128((const __m128i*) p);
+        switch (encoding)
+        {
+        case LineScanner::Encoding::UTF16LE:
+        case LineScanner::Encoding::UTF16BE:
+        {
+            const auto be = encoding == LineScanner::Encoding::UTF16BE;
+            const auto lf = _mm_cmpeq_epi16(d, _mm_set1_epi16(be ? 0x0A00 : 0x000A));
+            const auto cr = _mm_cmpeq_epi16(d, _mm_set1_epi16(be ? 0x0D00 : 0x000D));
+            newLines      = (uint32) _mm_movemask_epi8(_mm_or_si128(lf, cr));
+            starts        = 0x5555;
+            return;
+        }
+        default:
+            break;
+        }
+        const auto lf = _mm_cmpeq_epi8(d, _mm_set1_epi8('\n'));
+        const auto cr = _mm_cmpeq_epi8(d, _mm_set1_epi8('\r'));
+        newLines      = (uint32) _mm_movemask_epi8(_mm_or_si128(lf, cr));
+        if (encoding == LineScanner::Encoding::UTF8)
+        {
+            const auto cont = _mm_cmpeq_epi8(_mm_and_si128(d, _mm_set1_epi8((char) 0xC0)), _mm_set1_epi8((char) 0x80));
+            starts          = (~(uint32) _mm_movemask_epi8(cont)) & 0xFFFF;
+        }
+        else
+            starts = 0xFFFF;
+#    endif
+    }
+#endif
+    void Scan(const uint8* p, const uint8* e, std::vector<LineScanner::Line>& lines)
+    {
+        if ((hasCarry) && (p < e))
+        {
+            const auto ch = encoding == LineScanner::Encoding::UTF16LE ? (uint16) (carry | (*p << 8)) : (uint16) ((carry << 8) | *p);
+            hasCarry      = false;
+            p++;
+            Step(ch, true, lines);
+        }
+        while (p < e)
+        {
+#if defined(LINES_USE_SIMD)
+            if ((useSimd) && (newLine == 0) && (p + BLOCK_SIZE <= e))
+            {
+                // skip the characters before the first new line of the block (if the line does not have to be split)
+                uint32 newLines, starts;
+                Classify(p, newLines, starts);
+                const auto n     = newLines ? (uint32) std::countr_zero(newLines) : BLOCK_SIZE;
+                const auto count = (uint32) std::popcount(n < 32 ? (starts & ((1U << n) - 1)) : starts);
+                if (((maxChars == 0) || (charsCount + count <= maxChars)) && (offset + n - lineStart < MAX_LINE_SIZE))
+                {
+                    charsCount += count;
+                    offset += n;
+                    p += n;
+                    if (n == BLOCK_SIZE)
+                        continue;
+                }
+            }
+#endif
+            switch (encoding)
+            {
+            case LineScanner::Encoding::Ascii:
+                Step(*p, true, lines);
+                p++;
+                break;
+            case LineScanner::Encoding::UTF8:
+                Step(*p, (*p & 0xC0) != 0x80, lines);
+                p++;
+                break;
+            default:
+                if (p + 1 == e)
+                {
+                    carry    = *p;
+                    hasCarry = true;
+                    return;
+                }
+                Step(encoding == LineScanner::Encoding::UTF16LE ? (uint16) (p[0] | (p[1] << 8)) : (uint16) ((p[0] << 8) | p[1]),
+                     true,
+                     lines);
+                p += 2;
+                break;
+            }
+        }
+    }
+    void Finish(std::vector<LineScanner::Line>& lines)
+    {
+        if (hasCarry)
+        {
+            // a truncated UTF-16 character counts as a one byte character
+            hasCarry = false;
+            unitSize = 1;
+            Step(0, true, lines);
+        }
+        if (newLine != 0)
+        {
+            lines.push_back(pending);
+            newLine = 0;
+        }
+        if (charsCount > 0)
+            EndLine(lines);
+    }
+};
+
+// texts made mostly of new lines (CR, LF, CRLF and LFCR pairs) and of lines close to the split limit, with multi-byte and
+// invalid UTF-8 sequences ; the same text is encoded as UTF-16 when needed
+struct SelfCheckText
+{
+    uint32 seed;
+
+    uint32 Next()
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        return seed;
+    }
+    void Create(LineScanner::Encoding encoding, uint32 maxChars, std::vector<uint8>& text)
+    {
+        static const char16 utf16Chars[] = { 'a', ' ', 0x00E9, 0x0A0D, 0x0D0A, 0x20AC, 0xD83D, 0xDE00 };
+        static const char* utf8Chars[]   = { "a", " ", "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80", "\x80", "\xC3", "\xFF" };
+        text.clear();
+        const auto linesCount = 1 + Next() % 24;
+        for (uint32 line = 0; line < linesCount; line++)
+        {
+            // short lines or lines with the split size (+/- 2 characters)
+            auto count = Next() % 4 == 0 ? Next() % 40 : maxChars - 2 + Next() % 5;
+            for (; count > 0; count--)
+            {
+                const auto idx = Next() % 8;
+                if ((encoding == LineScanner::Encoding::UTF16LE) || (encoding == LineScanner::Encoding::UTF16BE))
+                    AddUTF16(encoding, utf16Chars[idx], text);
+                else if (encoding == LineScanner::Encoding::UTF8)
+                    text.insert(text.end(), (const uint8*) utf8Chars[idx], (const uint8*) utf8Chars[idx] + strlen(utf8Chars[idx]));
+                else
+                    text.push_back((uint8) (Next() & 0x7F) | 0x20);
+            }
+            static const char* newLines[] = { "\n", "\r", "\r\n", "\n\r", "\n\n", "\r\r", "\n\r\n", "" };
+            for (auto ch = newLines[Next() % 8]; *ch; ch++)
+            {
+                if ((encoding == LineScanner::Encoding::UTF16LE) || (encoding == LineScanner::Encoding::UTF16BE))
+                    AddUTF16(encoding, *ch, text);
+                else
+                    text.push_back(*ch);
+            }
+        }
+        // a truncated UTF-16 character at the end
+        if (((encoding == LineScanner::Encoding::UTF16LE) || (encoding == LineScanner::Encoding::UTF16BE)) && (Next() % 4 == 0))
+            text.push_back('\n');
+    }
+    static void AddUTF16(LineScanner::Encoding encoding, char16 ch, std::vector<uint8>& text)
+    {
+        if (encoding == LineScanner::Encoding::UTF16LE)
+            text.insert(text.end(), { (uint8) ch, (uint8) (ch >> 8) });
+        else
+            text.insert(text.end(), { (uint8) (ch >> 8), (uint8) ch });
+    }
+};
+// 'chunk' = 0 => the whole text is scanned at once ; otherwise the chunks have 1 to 'chunk' bytes
+void SelfCheckScan(
+      LineScanner::Encoding encoding,
+      uint32 maxChars,
+      bool useSimd,
+      const std::vector<uint8>& text,
+      uint32 chunk,
+      SelfCheckText& rnd,
+      std::vector<LineScanner::Line>& lines)
+{
+    InternalLineScanner s(encoding, 0, maxChars);
+    s.useSimd = useSimd;
+    lines.clear();
+    for (size_t pos = 0; pos < text.size();)
+    {
+        const auto size = chunk == 0 ? text.size() : std::min<size_t>(1 + rnd.Next() % chunk, text.size() - pos);
+        s.Scan(text.data() + pos, text.data() + pos + size, lines);
+        pos += size;
+    }
+    s.Finish(lines);
+}
+} // namespace
+
+bool LineScanner::SelfCheck(String& error)
+{
+    const Encoding encodings[]    = { Encoding::Ascii, Encoding::UTF8, Encoding::UTF16LE, Encoding::UTF16BE };
+    const char* encodingNames[]   = { "ASCII", "UTF-8", "UTF-16LE", "UTF-16BE" };
+    const uint32 maxCharsValues[] = { 2001, 0, 7 };
+    SelfCheckText rnd{ 0x12345678 };
+    std::vector<uint8> text;
+    std::vector<Line> expected, lines;
+
+    for (uint32 tr = 0; tr < 4; tr++)
+    {
+        for (auto maxChars : maxCharsValues)
+        {
+            for (uint32 test = 0; test < 64; test++)
+            {
+                rnd.Create(encodings[tr], maxChars == 0 ? 2001 : maxChars, text);
+                SelfCheckScan(encodings[tr], maxChars, false, text, 0, rnd, expected);
+                // the vectorized scan (whole text, or split in small chunks => pairs and UTF-16 characters split between
+                // chunks) must find the same lines as the byte by byte one
+                const uint32 chunks[] = { 0, 3, 64, 4099 };
+                for (auto chunk : chunks)
+                {
+                    SelfCheckScan(encodings[tr], maxChars, true, text, chunk, rnd, lines);
+                    if (lines.size() != expected.size())
+                    {
+                        error.Format(
+                              "%s (split after %u chars, chunks of %u bytes): %u lines instead of %u",
+                              encodingNames[tr],
+                              maxChars,
+                              chunk,
+                              (uint32) lines.size(),
+                              (uint32) expected.size());
+                        return false;
+                    }
+                    for (size_t idx = 0; idx < lines.size(); idx++)
+                    {
+                        const auto& a = lines[idx];
+                        const auto& b = expected[idx];
+                        if ((a.offset != b.offset) || (a.size != b.size) || (a.charsCount != b.charsCount) ||
+                            (a.newLineSize != b.newLineSize))
+                        {
+                            error.Format(
+                                  "%s (split after %u chars, chunks of %u bytes): line %u = %llu:%u (%u chars), not %llu:%u (%u chars)",
+                                  encodingNames[tr],
+                                  maxChars,
+                                  chunk,
+                                  (uint32) idx,
+                                  a.offset,
+                                  a.size,
+                                  a.charsCount,
+                                  b.offset,
+                                  b.size,
+                                  b.charsCount);
+                            return false;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+LineScanner::LineScanner(Encoding encoding, uint64 offset, uint32 maxCharsPerLine)
+{
+    data = new InternalLineScanner(encoding, offset, maxCharsPerLine);
+}
+LineScanner::~LineScanner()
+{
+    delete reinterpret_cast<InternalLineScanner*>(data);
+    data = nullptr;
+}
+void LineScanner::Scan(BufferView chunk, std::vector<Line>& lines)
+{
+    reinterpret_cast<InternalLineScanner*>(data)->Scan(chunk.begin(), chunk.end(), lines);
+}
+void LineScanner::Finish(std::vector<Line>& lines)
+{
+    reinterpret_cast<InternalLineScanner*>(data)->Finish(lines);
+}
+uint64 LineScanner::GetOffset() const
+{
+    const auto s = reinterpret_cast<const InternalLineScanner*>(data);
+    return s->offset + (s->hasCarry ? 1 : 0);
+}
@@ -0,0 +1,196 @@
+#include "Internal.hpp"
+
+#if defined(BUILD_FOR_UNIX)
+#    include <cerrno>
+#    include <cstdio>
+#    include <fcntl.h>
+#    include <unistd.h>
+#endif
+
+using namespace GView::Utils;
+
+constexpr uint64 MAX_USER_ADDRESS = 0x7FFFFFFFFFFFFFFFULL; // pread can not use offsets above this value
+
+ProcessRegionsMap::ProcessRegionsMap()
+{
+    this->size = 0;
+}
+bool ProcessRegionsMap::Load(uint32 pid)
+{
+    this->regions.clear();
+    this->size = 0;
+#if defined(BUILD_FOR_UNIX)
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%u/maps", pid);
+    auto f = fopen(path, "r");
+    CHECK(f, false, "Fail to open %s (errno: %d)", path, errno);
+
+    // each line has the following format: <start>-<end> <permissions> <offset> <device> <inode> [name]
+    char line[4096];
+    while (fgets(line, sizeof(line), f))
+    {
+        unsigned long long start, end;
+        char perms[5];
+        int nameOffset = 0;
+        if (sscanf(line, "%llx-%llx %4s %*s %*s %*s %n", &start, &end, perms, &nameOffset) < 3)
+            continue;
+        if (end <= start)
+            continue;
+        auto& r    = this->regions.emplace_back();
+        r.address  = start;
+        r.size     = end - start;
+        r.offset   = this->size;
+        r.readable = (perms[0] == 'r') && (end - 1 <= MAX_USER_ADDRESS);
+        memcpy(r.permissions, perms, sizeof(r.permissions));
+        if (nameOffset > 0)
+        {
+            std::string_view name(line + nameOffset);
+            while ((!name.empty()) && ((name.back() == '\n') || (name.back() == '\r') || (name.back() == ' ')))
+                name.remove_suffix(1);
+            r.name = name;
+        }
+        this->size += r.size;
+    }
+    fclose(f);
+    CHECK(this->regions.size() > 0, false, "No memory regions found for process %u", pid);
+    return true;
+#else
+    RETURNERROR(false, "Reading the memory of a process is not supported on this platform !");
+#endif
+}
+int32 ProcessRegionsMap::OffsetToRegion(uint64 offset) const
+{
+    if (offset >= this->size)
+        return -1;
+    // regions are sorted (both by offset and by address)
+    auto it = std::upper_bound(
+          this->regions.begin(), this->regions.end(), offset, [](uint64 value, const ProcessRegion& r) { return value < r.offset; });
+    return (int32) (it - this->regions.begin()) - 1;
+}
+uint64 ProcessRegionsMap::AddressToOffset(uint64 address) const
+{
+    auto it = std::upper_bound(
+          this->regions.begin(), this->regions.end(), address, [](uint64 value, const ProcessRegion& r) { return value < r.address; });
+    if (it == this->regions.begin())
+        return GView::Utils::INVALID_OFFSET;
+    --it;
+    if (address - it->address >= it->size)
+        return GView::Utils::INVALID_OFFSET; // address is in a gap between two regions
+    return it->offset + (address - it->address);
+}
+uint64 ProcessRegionsMap::OffsetToAddress(uint64 offset) const
+{
+    auto index = OffsetToRegion(offset);
+    if (index < 0)
+        return GView::Utils::INVALID_OFFSET;
+    const auto& r = this->regions[index];
+    return r.address + (offset - r.offset);
+}
+
+ProcessDataObject::ProcessDataObject()
+{
+    this->pos    = 0;
+    this->handle = -1;
+}
+ProcessDataObject::~ProcessDataObject()
+{
+    Close();
+}
+bool ProcessDataObject::Open(uint32 pid)
+{
+    CHECK(this->handle < 0, false, "Process object already opened !");
+    CHECK(this->map.Load(pid), false, "Fail to read the memory map of process %u", pid);
+#if defined(BUILD_FOR_UNIX)
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%u/mem", pid);
+    this->handle = open(path, O_RDONLY);
+    CHECK(this->handle >= 0, false, "Fail to open %s (errno: %d)", path, errno);
+    this->pos = 0;
+    return true;
+#else
+    RETURNERROR(false, "Reading the memory of a process is not supported on this platform !");
+#endif
+}
+void ProcessDataObject::ReadRegion(uint64 address, uint8* buffer, uint64 size)
+{
+#if defined(BUILD_FOR_UNIX)
+    const auto pageSize = (uint64) sysconf(_SC_PAGESIZE);
+    while (size > 0)
+    {
+        auto result = pread(this->handle, buffer, (size_t) size, (off_t) address);
+        if (result > 0)
+        {
+            address += (uint64) result;
+            buffer += result;
+            size -= (uint64) result;
+            continue;
+        }
+        // the page can not be read (guard page, device mapping, region unmapped in the meantime) => zero-fill it and move on
+        const auto skip = std::min<>(size, pageSize - (address % pageSize));
+        memset(buffer, 0, (size_t) skip);
+        address += skip;
+        buffer += skip;
+        size -= skip;
+    }
+#else
+    memset(buffer, 0, (size_t) size);
+#endif
+}
+bool ProcessDataObject::ReadBuffer(void* buffer, uint32 bufferSize, uint32& bytesRead)
+{
+    bytesRead = 0;
+    CHECK(this->handle >= 0, false, "Process object is not opened !");
+    CHECK(this->pos + bufferSize <= this->map.GetSize(), false, "Unable to read %u bytes from %llu", bufferSize, this->pos);
+    auto index = this->map.OffsetToRegion(this->pos);
+    auto p     = reinterpret_cast<uint8*>(buffer);
+    auto left  = (uint64) bufferSize;
+    while (left > 0)
+    {
+        CHECK(index >= 0 && index < (int32) this->map.GetRegions().size(), false, "Invalid region for offset %llu", this->pos);
+        const auto& r    = this->map.GetRegions()[index];
+        const auto delta = this->pos - r.offset;
+        const auto count = std::min<>(left, r.size - delta);
+        // regions without read access are zero-filled (no I/O)
+        if (r.readable)
+            ReadRegion(r.address + delta, p, count);
+        else
+            memset(p, 0, (size_t) count);
+        p += count;
+        left -= count;
+        this->pos += count;
+        index++;
+    }
+    bytesRead = bufferSize;
+    return true;
+}
+bool ProcessDataObject::WriteBuffer(const void* buffer, uint32 bufferSize, uint32& bytesWritten)
+{
+    bytesWritten = 0;
+    RETURNERROR(false, "Process objects are read-only !");
+}
+uint64 ProcessDataObject::GetSize()
+{
+    return this->map.GetSize();
+}
+uint64 ProcessDataObject::GetCurrentPos() const
+{
+    return this->pos;
+}
+bool ProcessDataObject::SetSize(uint64 newSize)
+{
+    RETURNERROR(false, "Process objects are read-only !");
+}
+bool ProcessDataObject::SetCurrentPos(uint64 newPosition)
+{
+    CHECK(newPosition <= this->map.GetSize(), false, "Invalid position: %llu", newPosition);
+    this->pos = newPosition;
+    return true;
+}
+void ProcessDataObject::Close()
+{
+#if defined(BUILD_FOR_UNIX)
+    if (this->handle >= 0)
+        close(this->handle);
+#endif
+    this->handle = -1;
+}
@@ -0,0 +1,776 @@
+#include "Internal.hpp"
+
+#include <map>
+
+using namespace GView::Utils;
+
+constexpr uint32 MAX_REPEAT_COUNT = 1000;
+constexpr uint32 MAX_NFA_STATES   = 100000;
+constexpr uint32 MAX_GROUP_DEPTH  = 256;
+constexpr uint32 MAX_DFA_STATES   = 4096; // 4 MB of transitions ; the cache is flushed when it gets bigger
+constexpr uint32 UNKNOWN_STATE    = 0xFFFFFFFF;
+constexpr uint32 DEAD_STATE       = 0;
+constexpr uint32 INFINITE_REPEAT  = 0xFFFFFFFF;
+constexpr uint32 STARTS_WINDOW    = RegexEngine::MAX_MATCH_SIZE * 8; // bytes marked by one reverse pass (see MatchStarts)
+
+using NfaStateType = RegexEngine::NfaStateType;
+
+namespace
+{
+enum class RegexNodeType : uint8
+{
+    Bytes,
+    Concat,
+    Alternate,
+    Repeat,
+    Empty
+};
+struct RegexNode
+{
+    std::bitset<256> bytes;
+    std::vector<uint32> children;
+    uint32 min, max;
+    RegexNodeType type;
+};
+
+class RegexParser
+{
+    std::string_view text;
+    size_t pos;
+    uint32 depth;
+    bool ignoreCase;
+    String& error;
+
+    uint32 AddNode(RegexNodeType type)
+    {
+        auto& n = nodes.emplace_back();
+        n.type  = type;
+        n.min   = 0;
+        n.max   = 0;
+        return (uint32) (nodes.size() - 1);
+    }
+    uint32 AddBytes(const std::bitset<256>& bytes)
+    {
+        const auto id   = AddNode(RegexNodeType::Bytes);
+        nodes[id].bytes = bytes;
+        if (ignoreCase)
+        {
+            for (uint32 ch = 'a'; ch <= 'z'; ch++)
+            {
+                if (bytes[ch] || bytes[ch - 0x20])
+                {
+                    nodes[id].bytes.set(ch);
+                    nodes[id].bytes.set(ch - 0x20);
+                }
+            }
+        }
+        return id;
+    }
+    bool Fail(std::string_view message)
+    {
+        error.Format("%.*s (at position %u)", (int) message.size(), message.data(), (uint32) pos);
+        return false;
+    }
+    bool ParseHexByte(uint8& value)
+    {
+        value = 0;
+        for (uint32 tr = 0; tr < 2; tr++, pos++)
+        {
+            if (pos >= text.size())
+                return Fail("Expecting two hex digits after \\x");
+            const auto ch = text[pos];
+            value <<= 4;
+            if ((ch >= '0') && (ch <= '9'))
+                value |= ch - '0';
+            else if ((ch >= 'a') && (ch <= 'f'))
+                value |= ch - 'a' + 10;
+            else if ((ch >= 'A') && (ch <= 'F'))
+                value |= ch - 'A' + 10;
+            else
+                return Fail("Expecting two hex digits after \\x");
+        }
+        return true;
+    }
+    // parses the escape sequence after '\' ; single bytes are also returned in 'value' (they can be used as range limits)
+    bool ParseEscape(std::bitset<256>& bytes, int32& value)
+    {
+        if (pos >= text.size())
+            return Fail("Incomplete escape sequence");
+        const auto ch = text[pos++];
+        value         = -1;
+        bytes.reset();
+        switch (ch)
+        {
+        case 'd':
+        case 'D':
+            for (uint32 c = '0'; c <= '9'; c++)
+                bytes.set(c);
+            break;
+        case 'w':
+        case 'W':
+            for (uint32 c = 0; c < 256; c++)
+                if (((c >= '0') && (c <= '9')) || ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) || (c == '_'))
+                    bytes.set(c);
+            break;
+        case 's':
+        case 'S':
+            for (auto c : { ' ', '\t', '\n', '\r', '\v', '\f' })
+                bytes.set((uint8) c);
+            break;
+        case 'x':
+        {
+            uint8 b;
+            if (!ParseHexByte(b))
+                return false;
+            value = b;
+            break;
+        }
+        case 'n':
+            value = '\n';
+            break;
+        case 'r':
+            value = '\r';
+            break;
+        case 't':
+            value = '\t';
+            break;
+        case '0':
+            value = 0;
+            break;
+        default:
+            if ((ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9'))
+            {
+                pos--;
+                return Fail("Unknown escape sequence");
+            }
+            value = (uint8) ch; // escaped special character
+            break;
+        }
+        if ((ch == 'D') || (ch == 'W') || (ch == 'S'))
+            bytes.flip();
+        if (value >= 0)
+            bytes.set(value);
+        return true;
+    }
+    bool ParseClass(uint32& id)
+    {
+        // '[' was already consumed
+        std::bitset<256> bytes, tmp;
+        bool negate = false;
+        if ((pos < text.size()) && (text[pos] == '^'))
+        {
+            negate = true;
+            pos++;
+        }
+        for (bool first = true;; first = false)
+        {
+            if (pos >= text.size())
+                return Fail("Missing ] for a character class");
+            if ((text[pos] == ']') && (!first))
+            {
+                pos++;
+                break;
+            }
+            int32 from;
+            if (text[pos] == '\\')
+            {
+                pos++;
+                if (!ParseEscape(tmp, from))
+                    return false;
+                bytes |= tmp;
+            }
+            else
+                from = (uint8) text[pos++];
+            // range (a-z) ; a '-' before ']' is a literal
+            if ((from >= 0) && (pos + 1 < text.size()) && (text[pos] == '-') && (text[pos + 1] != ']'))
+            {
+                pos++;
+                int32 to;
+                if (text[pos] == '\\')
+                {
+                    pos++;
+                    if (!ParseEscape(tmp, to))
+                        return false;
+                    if (to < 0)
+                        return Fail("Invalid range limit");
+                }
+                else
+                    to = (uint8) text[pos++];
+                if (from > to)
+                    return Fail("Invalid range (the first value is bigger than the last one)");
+                for (auto c = from; c <= to; c++)
+                    bytes.set(c);
+            }
+            else if (from >= 0)
+                bytes.set(from);
+        }
+        if (negate)
+        {
+            // negation is applied after the case folding (so that [^a] does not match 'A' either)
+            id = AddBytes(bytes);
+            nodes[id].bytes.flip();
+        }
+        else
+            id = AddBytes(bytes);
+        return true;
+    }
+    bool ParseNumber(uint32& value)
+    {
+        if ((pos >= text.size()) || (text[pos] < '0') || (text[pos] > '9'))
+            return Fail("Expecting a number");
+        value = 0;
+        while ((pos < text.size()) && (text[pos] >= '0') && (text[pos] <= '9'))
+        {
+            value = value * 10 + (text[pos++] - '0');
+            if (value > MAX_REPEAT_COUNT)
+                return Fail("Repeat count is too big (max 1000)");
+        }
+        return true;
+    }
+    bool ParseAtom(uint32& id)
+    {
+        const auto ch = text[pos++];
+        std::bitset<256> bytes;
+        int32 value;
+        switch (ch)
+        {
+        case '(':
+            if (depth >= MAX_GROUP_DEPTH)
+                return Fail("Too many nested groups");
+            if ((pos + 1 < text.size()) && (text[pos] == '?') && (text[pos + 1] == ':'))
+                pos += 2;
+            depth++;
+            if (!ParseAlternate(id))
+                return false;
+            depth--;
+            if ((pos >= text.size()) || (text[pos] != ')'))
+                return Fail("Missing )");
+            pos++;
+            return true;
+        case '[':
+            return ParseClass(id);
+        case '.':
+            bytes.set();
+            id = AddBytes(bytes);
+            return true;
+        case '\\':
+            if (!ParseEscape(bytes, value))
+                return false;
+            id = AddBytes(bytes);
+            return true;
+        case '*':
+        case '+':
+        case '?':
+        case '{':
+            pos--;
+            return Fail("Nothing to repeat");
+        case '^':
+        case '$':
+            pos--;
+            return Fail("Anchors (^ and $) are not supported");
+        default:
+            bytes.set((uint8) ch);
+            id = AddBytes(bytes);
+            return true;
+        }
+    }
+    bool ParseRepeat(uint32& id)
+    {
+        if (!ParseAtom(id))
+            return false;
+        while (pos < text.size())
+        {
+            uint32 min, max;
+            switch (text[pos])
+            {
+            case '*':
+                min = 0;
+                max = INFINITE_REPEAT;
+                pos++;
+                break;
+            case '+':
+                min = 1;
+                max = INFINITE_REPEAT;
+                pos++;
+                break;
+            case '?':
+                min = 0;
+                max = 1;
+                pos++;
+                break;
+            case '{':
+                pos++;
+                if (!ParseNumber(min))
+                    return false;
+                max = min;
+                if ((pos < text.size()) && (text[pos] == ','))
+                {
+                    pos++;
+                    max = INFINITE_REPEAT;
+                    if ((pos < text.size()) && (text[pos] != '}'))
+                        if (!ParseNumber(max))
+                            return false;
+                }
+                if ((pos >= text.size()) || (text[pos] != '}'))
+                    return Fail("Missing } for a repeat count");
+                if (min > max)
+                    return Fail("Invalid repeat count (min is bigger than max)");
+                pos++;
+                break;
+            default:
+                return true;
+            }
+            const auto rep = AddNode(RegexNodeType::Repeat);
+            nodes[rep].min = min;
+            nodes[rep].max = max;
+            nodes[rep].children.push_back(id);
+            id = rep;
+        }
+        return true;
+    }
+    bool ParseConcat(uint32& id)
+    {
+        id = AddNode(RegexNodeType::Concat);
+        while ((pos < text.size()) && (text[pos] != '|') && (text[pos] != ')'))
+        {
+            uint32 child;
+            if (!ParseRepeat(child))
+                return false;
+            nodes[id].children.push_back(child);
+        }
+        if (nodes[id].children.empty())
+            nodes[id].type = RegexNodeType::Empty;
+        return true;
+    }
+    bool ParseAlternate(uint32& id)
+    {
+        if (!ParseConcat(id))
+            return false;
+        if ((pos >= text.size()) || (text[pos] != '|'))
+            return true;
+        const auto alt = AddNode(RegexNodeType::Alternate);
+        nodes[alt].children.push_back(id);
+        while ((pos < text.size()) && (text[pos] == '|'))
+        {
+            pos++;
+            uint32 child;
+            if (!ParseConcat(child))
+                return false;
+            nodes[alt].children.push_back(child);
+        }
+        id = alt;
+        return true;
+    }
+
+  public:
+    std::vector<RegexNode> nodes;
+
+    RegexParser(std::string_view _text, bool _ignoreCase, String& _error)
+        : text(_text), pos(0), depth(0), ignoreCase(_ignoreCase), error(_error)
+    {
+    }
+    bool Parse(uint32& root)
+    {
+        if (!ParseAlternate(root))
+            return false;
+        if (pos != text.size())
+            return Fail("Unbalanced )");
+        return true;
+    }
+};
+
+// Thompson construction: every node is compiled backwards from its continuation ('next') and returns its entry state
+// 'reversed' builds the NFA of the reversed expression (it matches the reversed strings ; used to find where a match starts)
+class NfaBuilder
+{
+    const std::vector<RegexNode>& nodes;
+    RegexEngine::Nfa& nfa;
+    bool reversed;
+
+    uint32 AddState(NfaStateType type, uint32 out, uint32 out1)
+    {
+        auto& s = nfa.states.emplace_back();
+        s.type  = type;
+        s.out   = out;
+        s.out1  = out1;
+        return (uint32) (nfa.states.size() - 1);
+    }
+
+  public:
+    NfaBuilder(const std::vector<RegexNode>& _nodes, RegexEngine::Nfa& _nfa, bool _reversed)
+        : nodes(_nodes), nfa(_nfa), reversed(_reversed)
+    {
+    }
+    bool Build(uint32 nodeID, uint32 next, uint32& entry)
+    {
+        if (nfa.states.size() >= MAX_NFA_STATES)
+            return false;
+        const auto& n = nodes[nodeID];
+        switch (n.type)
+        {
+        case RegexNodeType::Bytes:
+            entry                   = AddState(NfaStateType::Bytes, next, next);
+            nfa.states[entry].bytes = n.bytes;
+            return true;
+        case RegexNodeType::Empty:
+            entry = next;
+            return true;
+        case RegexNodeType::Concat:
+            for (size_t idx = 0; idx < n.children.size(); idx++)
+            {
+                if (!Build(n.children[reversed ? idx : n.children.size() - 1 - idx], next, next))
+                    return false;
+            }
+            entry = next;
+            return true;
+        case RegexNodeType::Alternate:
+            if (!Build(n.children.back(), next, entry))
+                return false;
+            for (auto idx = n.children.size() - 1; idx > 0; idx--)
+            {
+                uint32 child;
+                if (!Build(n.children[idx - 1], next, child))
+                    return false;
+                entry = AddState(NfaStateType::Split, child, entry);
+            }
+            return true;
+        case RegexNodeType::Repeat:
+        {
+            auto cur = next;
+            if (n.max == INFINITE_REPEAT)
+            {
+                // loop: split -> (child -> split) | next
+                const auto loop = AddState(NfaStateType::Split, next, next);
+                uint32 child;
+                if (!Build(n.children[0], loop, child))
+                    return false;
+                nfa.states[loop].out = child;
+                cur                  = loop;
+            }
+            else
+            {
+                // x{0,3} => (x(x(x)?)?)?
+                for (auto tr = n.min; tr < n.max; tr++)
+                {
+                    uint32 child;
+                    if (!Build(n.children[0], cur, child))
+                        return false;
+                    cur = AddState(NfaStateType::Split, child, next);
+                }
+            }
+            for (uint32 tr = 0; tr < n.min; tr++)
+            {
+                if (!Build(n.children[0], cur, cur))
+                    return false;
+            }
+            entry = cur;
+            return true;
+        }
+        }
+        return false;
+    }
+};
+
+// DFA states are built on demand (only for the NFA state sets that are actually reached by the scanned data)
+// 'unanchored' adds the start state at every position => the DFA accepts as soon as a match ends (wherever it started)
+class LazyDfa
+{
+    const RegexEngine::Nfa& nfa;
+    std::vector<uint32> transitions; // 256 per state
+    std::vector<bool> accepting;
+    std::vector<std::vector<uint32>> sets;
+    std::map<std::vector<uint32>, uint32> ids;
+    std::vector<uint32> startSet;
+    std::vector<uint32> current;
+    std::vector<uint32> stack;
+    std::vector<uint32> marks;
+    uint32 generation;
+    uint32 start;
+    bool unanchored;
+
+    void AddClosure(uint32 state)
+    {
+        stack.push_back(state);
+        while (!stack.empty())
+        {
+            const auto id = stack.back();
+            stack.pop_back();
+            if (marks[id] == generation)
+                continue;
+            marks[id]     = generation;
+            const auto& s = nfa.states[id];
+            switch (s.type)
+            {
+            case NfaStateType::Split:
+                stack.push_back(s.out1);
+                stack.push_back(s.out);
+                break;
+            case NfaStateType::Epsilon:
+                stack.push_back(s.out);
+                break;
+            default:
+                current.push_back(id); // only the states that consume bytes (or match) identify a DFA state
+                break;
+            }
+        }
+    }
+    void NewGeneration()
+    {
+        current.clear();
+        if (++generation == 0)
+        {
+            std::fill(marks.begin(), marks.end(), 0);
+            generation = 1;
+        }
+    }
+    uint32 AddState(const std::vector<uint32>& set)
+    {
+        const auto it = ids.find(set);
+        if (it != ids.end())
+            return it->second;
+        const auto id = (uint32) sets.size();
+        sets.push_back(set);
+        ids[set] = id;
+        bool match = false;
+        for (auto s : set)
+            match |= nfa.states[s].type == NfaStateType::Match;
+        accepting.push_back(match);
+        transitions.resize(transitions.size() + 256, set.empty() ? DEAD_STATE : UNKNOWN_STATE);
+        return id;
+    }
+    void Reset()
+    {
+        transitions.clear();
+        accepting.clear();
+        sets.clear();
+        ids.clear();
+        AddState({}); // DEAD_STATE
+        start = AddState(startSet);
+    }
+    uint32 Compute(uint32 state, uint8 value)
+    {
+        NewGeneration();
+        for (auto id : sets[state])
+        {
+            const auto& s = nfa.states[id];
+            if ((s.type == NfaStateType::Bytes) && (s.bytes[value]))
+                AddClosure(s.out);
+        }
+        if (unanchored)
+            AddClosure(nfa.start);
+        std::sort(current.begin(), current.end());
+        if (sets.size() >= MAX_DFA_STATES)
+        {
+            // the pattern/data combination creates too many states => start over (only the new state is kept)
+            Reset();
+            return AddState(current);
+        }
+        const auto next                            = AddState(current);
+        transitions[((size_t) state << 8) | value] = next;
+        return next;
+    }
+
+  public:
+    LazyDfa(const RegexEngine::Nfa& _nfa, bool _unanchored) : nfa(_nfa), generation(0), unanchored(_unanchored)
+    {
+        marks.resize(nfa.states.size(), 0);
+        NewGeneration();
+        AddClosure(nfa.start);
+        std::sort(current.begin(), current.end());
+        startSet = current;
+        Reset();
+    }
+    inline uint32 GetStart() const
+    {
+        return start;
+    }
+    inline uint32 Next(uint32 state, uint8 value)
+    {
+        const auto next = transitions[((size_t) state << 8) | value];
+        return next != UNKNOWN_STATE ? next : Compute(state, value);
+    }
+    inline bool IsAccepting(uint32 state) const
+    {
+        return accepting[state];
+    }
+};
+
+// the positions of [lo, hi) where a match starts ; a single backward pass from 'hi' with the unanchored DFA of the reversed
+// expression marks every position from where a match ends before 'hi' => it is valid for the next matches as long as the
+// ones that start before them (at most MAX_MATCH_SIZE bytes long) end before 'hi'
+struct MatchStarts
+{
+    std::vector<uint8> data;
+    std::vector<bool> marks;
+    uint64 lo = 0, hi = 0;
+
+    bool Update(DataCache& cache, LazyDfa& reverse, uint64 start, uint64 rangeEnd)
+    {
+        lo = start;
+        hi = std::min<>(rangeEnd, start + STARTS_WINDOW);
+        data.resize((size_t) (hi - lo));
+        marks.assign((size_t) (hi - lo), false);
+        CHECK(cache.ReadDirect(lo, data.data(), (uint32) (hi - lo)), false, "Fail to read %llu bytes from %llu", hi - lo, lo);
+        auto state = reverse.GetStart();
+        for (auto idx = data.size(); idx > 0; idx--)
+        {
+            state          = reverse.Next(state, data[idx - 1]);
+            marks[idx - 1] = reverse.IsAccepting(state);
+        }
+        return true;
+    }
+};
+
+// a match ends at 'firstEnd' and no match ends before it => finds the leftmost start (>= 'resume') and the longest match from it
+// the starts are read from 'starts' (computed again only when the window does not cover the match) and the end is found with
+// one pass of the anchored DFA => at most MAX_MATCH_SIZE bytes are read for every match (plus the reverse pass of a window)
+bool FindMatch(
+      DataCache& cache,
+      LazyDfa& dfa,
+      LazyDfa& reverse,
+      uint64 resume,
+      uint64 firstEnd,
+      uint64 rangeEnd,
+      MatchStarts& starts,
+      SearchMatch& match)
+{
+    const auto lo = std::max<>(resume, firstEnd > RegexEngine::MAX_MATCH_SIZE ? firstEnd - RegexEngine::MAX_MATCH_SIZE : 0);
+    const auto hi = std::min<>(rangeEnd, firstEnd + RegexEngine::MAX_MATCH_SIZE);
+    if ((lo < starts.lo) || (hi > starts.hi))
+    {
+        if (!starts.Update(cache, reverse, lo, rangeEnd))
+            return false;
+    }
+
+    match.patternIndex = 0;
+    for (auto start = lo; start < firstEnd; start++)
+    {
+        if (!starts.marks[(size_t) (start - starts.lo)])
+            continue;
+        const auto limit = std::min<>(hi, start + RegexEngine::MAX_MATCH_SIZE);
+        auto state       = dfa.GetStart();
+        uint64 end       = 0;
+        for (auto pos = start; (pos < limit) && (state != DEAD_STATE); pos++)
+        {
+            state = dfa.Next(state, starts.data[(size_t) (pos - starts.lo)]);
+            if (dfa.IsAccepting(state))
+                end = pos + 1;
+        }
+        // a start of a match that is longer than MAX_MATCH_SIZE is skipped
+        if (end > start)
+        {
+            match.offset = start;
+            match.size   = (uint32) (end - start);
+            return true;
+        }
+    }
+    // the match is longer than MAX_MATCH_SIZE => only its last part is reported
+    match.offset = lo;
+    match.size   = (uint32) (firstEnd - lo);
+    return true;
+}
+} // namespace
+
+RegexEngine::RegexEngine()
+{
+    this->nfa.start = 0;
+}
+void RegexEngine::Clear()
+{
+    this->nfa.states.clear();
+    this->nfa.start = 0;
+    this->reverseNfa.states.clear();
+    this->reverseNfa.start = 0;
+}
+bool RegexEngine::Compile(std::string_view pattern, bool ignoreCase, String& error)
+{
+    Clear();
+    if (pattern.empty())
+    {
+        error.Set("Empty regular expression");
+        return false;
+    }
+    RegexParser parser(pattern, ignoreCase, error);
+    uint32 root;
+    if (!parser.Parse(root))
+        return false;
+
+    Nfa result, reverse;
+    for (auto* n : { &result, &reverse })
+    {
+        n->states.reserve(parser.nodes.size() * 2);
+        auto& m = n->states.emplace_back();
+        m.type  = NfaStateType::Match;
+        m.out   = 0;
+        m.out1  = 0;
+        NfaBuilder builder(parser.nodes, *n, n == &reverse);
+        if (!builder.Build(root, 0, n->start))
+        {
+            error.Format("The regular expression is too complex (more than %u NFA states)", MAX_NFA_STATES);
+            return false;
+        }
+    }
+
+    // empty matches can not be highlighted or navigated => they are not allowed
+    LazyDfa dfa(result, false);
+    if (dfa.IsAccepting(dfa.GetStart()))
+    {
+        error.Set("The regular expression matches an empty string");
+        return false;
+    }
+    this->nfa        = std::move(result);
+    this->reverseNfa = std::move(reverse);
+    return true;
+}
+uint32 RegexEngine::GetMaxMatchSize() const
+{
+    return MAX_MATCH_SIZE;
+}
+bool RegexEngine::Search(
+      DataCache& cache,
+      uint64 offset,
+      uint64 size,
+      const std::function<bool(const SearchMatch&)>& onMatch,
+      const std::atomic<bool>* cancel,
+      std::atomic<uint64>* progress) const
+{
+    CHECK(IsCompiled(), false, "No regular expression !");
+    CHECK((offset <= cache.GetSize()) && (size <= cache.GetSize() - offset), false, "Invalid range: %llu bytes from %llu", size, offset);
+
+    // a single pass with the unanchored DFA finds where matches end (its state is kept from one chunk to the next)
+    // the (small) window around a match end is then read again to find where that match starts and how long it is
+    LazyDfa scanner(this->nfa, true);
+    LazyDfa matcher(this->nfa, false);
+    LazyDfa reverse(this->reverseNfa, true);
+    MatchStarts starts;
+    SequentialReader reader(cache, offset, size);
+    const auto rangeEnd = offset + size;
+    auto resume         = offset; // a match can not start before the end of the previous one
+    auto state          = scanner.GetStart();
+    for (auto buf = reader.Next(); buf.IsValid(); buf = reader.Next())
+    {
+        if ((cancel) && (cancel->load(std::memory_order_relaxed)))
+            return false;
+        const auto chunkOffset = reader.GetChunkOffset();
+        const auto len         = (uint64) buf.GetLength();
+        const auto data        = buf.GetData();
+        for (auto idx = resume > chunkOffset ? std::min<>(resume - chunkOffset, len) : 0; idx < len; idx++)
+        {
+            state = scanner.Next(state, data[idx]);
+            if (!scanner.IsAccepting(state))
+                continue;
+            SearchMatch m;
+            if (!FindMatch(cache, matcher, reverse, resume, chunkOffset + idx + 1, rangeEnd, starts, m))
+                return false;
+            if (!onMatch(m))
+                return true;
+            // the match may continue in the next chunks => scanning resumes after it
+            resume = m.offset + m.size;
+            state  = scanner.GetStart();
+            idx    = resume - chunkOffset - 1;
+        }
+        if (progress)
+            progress->store(chunkOffset + len, std::memory_order_relaxed);
+    }
+    return !reader.HasErrors();
+}
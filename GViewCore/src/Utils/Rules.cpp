@@ -0,0 +1,1035 @@
+#include "Internal.hpp"
+
+#include <queue>
+
+using namespace GView::Utils;
+
+using ConditionType    = RuleEngine::ConditionType;
+using CompareOperation = RuleEngine::CompareOperation;
+
+constexpr uint32 MAX_CONDITION_DEPTH = 256;
+constexpr uint32 NO_STATE            = 0xFFFFFFFF;
+
+namespace
+{
+struct LowerCaseTable
+{
+    uint8 values[256];
+    LowerCaseTable()
+    {
+        for (uint32 tr = 0; tr < 256; tr++)
+            values[tr] = ((tr >= 'A') && (tr <= 'Z')) ? (uint8) (tr | 0x20) : (uint8) tr;
+    }
+};
+const LowerCaseTable lowerCase;
+
+enum class TokenType : uint8
+{
+    End,
+    Identifier,
+    StringID, // $name (the text does not contain the '$')
+    CountID,  // #name
+    Number,
+    Text, // "..." (the text is not decoded and does not contain the quotes)
+    Symbol
+};
+struct Token
+{
+    std::string_view text;
+    uint64 number;
+    uint32 line;
+    TokenType type;
+};
+
+class RulesParser
+{
+    std::string_view text;
+    size_t pos;
+    uint32 line;
+    uint32 depth;
+    Token token;
+    String& error;
+
+    bool Fail(std::string_view message)
+    {
+        error.Format("Line %u: %.*s", token.line, (int) message.size(), message.data());
+        return false;
+    }
+    static bool IsIdentifierChar(char ch)
+    {
+        return ((ch >= 'a') && (ch <= 'z')) || ((ch >= 'A') && (ch <= 'Z')) || ((ch >= '0') && (ch <= '9')) || (ch == '_');
+    }
+    static int32 HexValue(char ch)
+    {
+        if ((ch >= '0') && (ch <= '9'))
+            return ch - '0';
+        if ((ch >= 'a') && (ch <= 'f'))
+            return ch - 'a' + 10;
+        if ((ch >= 'A') && (ch <= 'F'))
+            return ch - 'A' + 10;
+        return -1;
+    }
+    bool SkipSpacesAndComments()
+    {
+        while (pos < text.size())
+        {
+            const auto ch = text[pos];
+            if ((ch == ' ') || (ch == '\t') || (ch == '\r') || (ch == '\n'))
+            {
+                line += ch == '\n';
+                pos++;
+            }
+            else if ((ch == '/') && (pos + 1 < text.size()) && (text[pos + 1] == '/'))
+            {
+                while ((pos < text.size()) && (text[pos] != '\n'))
+                    pos++;
+            }
+            else if ((ch == '/') && (pos + 1 < text.size()) && (text[pos + 1] == '*'))
+            {
+                const auto end = text.find("*/", pos + 2);
+                if (end == std::string_view::npos)
+                {
+                    token.line = line;
+                    return Fail("Unterminated comment");
+                }
+                for (; pos < end; pos++)
+                    line += text[pos] == '\n';
+                pos = end + 2;
+            }
+            else
+                break;
+        }
+        return true;
+    }
+    bool ScanNumber()
+    {
+        uint64 value = 0;
+        if ((text[pos] == '0') && (pos + 1 < text.size()) && ((text[pos + 1] == 'x') || (text[pos + 1] == 'X')))
+        {
+            pos += 2;
+            const auto start = pos;
+            for (; (pos < text.size()) && (HexValue(text[pos]) >= 0); pos++)
+            {
+                if (value >> 60)
+                    return Fail("Number is too big");
+                value = (value << 4) | (uint64) HexValue(text[pos]);
+            }
+            if (pos == start)
+                return Fail("Expecting hex digits after 0x");
+        }
+        else
+        {
+            for (; (pos < text.size()) && (text[pos] >= '0') && (text[pos] <= '9'); pos++)
+            {
+                if (value > 0xFFFFFFFFFFFFFFFFULL / 10 - 1)
+                    return Fail("Number is too big");
+                value = value * 10 + (uint64) (text[pos] - '0');
+            }
+        }
+        if ((pos + 1 < text.size()) && ((text[pos] == 'K') || (text[pos] == 'M')) && (text[pos + 1] == 'B'))
+        {
+            const auto shift = text[pos] == 'K' ? 10U : 20U;
+            if (value >> (64 - shift))
+                return Fail("Number is too big");
+            value <<= shift;
+            pos += 2;
+        }
+        if ((pos < text.size()) && (IsIdentifierChar(text[pos])))
+            return Fail("Invalid number");
+        token.number = value;
+        return true;
+    }
+    bool Next()
+    {
+        if (!SkipSpacesAndComments())
+            return false;
+        token.line   = line;
+        token.number = 0;
+        if (pos >= text.size())
+        {
+            token.type = TokenType::End;
+            token.text = std::string_view();
+            return true;
+        }
+        const auto start = pos;
+        const auto ch    = text[pos];
+        const auto next  = pos + 1 < text.size() ? text[pos + 1] : 0;
+        if (((ch >= 'a') && (ch <= 'z')) || ((ch >= 'A') && (ch <= 'Z')) || (ch == '_'))
+        {
+            while ((pos < text.size()) && (IsIdentifierChar(text[pos])))
+                pos++;
+            token.type = TokenType::Identifier;
+        }
+        else if ((ch == '$') || (ch == '#'))
+        {
+            for (pos++; (pos < text.size()) && (IsIdentifierChar(text[pos])); pos++)
+                ;
+            if ((ch == '$') && (pos < text.size()) && (text[pos] == '*'))
+                pos++; // $a* (all the strings whose names start with 'a') or $* (all the strings)
+            if (pos == start + 1)
+                return Fail("Expecting an identifier after $ or #");
+            token.type = ch == '$' ? TokenType::StringID : TokenType::CountID;
+            token.text = text.substr(start + 1, pos - (start + 1));
+            return true;
+        }
+        else if ((ch >= '0') && (ch <= '9'))
+        {
+            if (!ScanNumber())
+                return false;
+            token.type = TokenType::Number;
+        }
+        else if (ch == '"')
+        {
+            for (pos++; (pos < text.size()) && (text[pos] != '"') && (text[pos] != '\n'); pos++)
+            {
+                if ((text[pos] == '\\') && (pos + 1 < text.size()))
+                    pos++;
+            }
+            if ((pos >= text.size()) || (text[pos] != '"'))
+                return Fail("Unterminated text string");
+            pos++;
+            token.type = TokenType::Text;
+            token.text = text.substr(start + 1, pos - (start + 2));
+            return true;
+        }
+        else if (((ch == '.') && (next == '.')) || (((ch == '=') || (ch == '!') || (ch == '<') || (ch == '>')) && (next == '=')))
+        {
+            pos += 2;
+            token.type = TokenType::Symbol;
+        }
+        else if (std::string_view("{}()=,:<>/").find(ch) != std::string_view::npos)
+        {
+            pos++;
+            token.type = TokenType::Symbol;
+        }
+        else
+            return Fail("Unexpected character");
+        token.text = text.substr(start, pos - start);
+        return true;
+    }
+    inline bool Is(std::string_view value) const
+    {
+        return ((token.type == TokenType::Symbol) || (token.type == TokenType::Identifier)) && (token.text == value);
+    }
+    bool Expect(std::string_view value)
+    {
+        if (!Is(value))
+        {
+            LocalString<64> tmp;
+            return Fail(tmp.Format("Expecting '%.*s'", (int) value.size(), value.data()));
+        }
+        return Next();
+    }
+    bool ReadNumber(uint64& value)
+    {
+        if (token.type != TokenType::Number)
+            return Fail("Expecting a number");
+        value = token.number;
+        return Next();
+    }
+
+    // strings
+    bool DecodeText(std::string_view raw, std::vector<uint8>& value)
+    {
+        for (size_t idx = 0; idx < raw.size(); idx++)
+        {
+            if (raw[idx] != '\\')
+            {
+                value.push_back((uint8) raw[idx]);
+                continue;
+            }
+            idx++;
+            switch (raw[idx])
+            {
+            case 'n':
+                value.push_back('\n');
+                break;
+            case 'r':
+                value.push_back('\r');
+                break;
+            case 't':
+                value.push_back('\t');
+                break;
+            case '"':
+            case '\\':
+                value.push_back((uint8) raw[idx]);
+                break;
+            case 'x':
+                if ((idx + 2 >= raw.size()) || (HexValue(raw[idx + 1]) < 0) || (HexValue(raw[idx + 2]) < 0))
+                    return Fail("Expecting two hex digits after \\x");
+                value.push_back((uint8) ((HexValue(raw[idx + 1]) << 4) | HexValue(raw[idx + 2])));
+                idx += 2;
+                break;
+            default:
+                return Fail("Unknown escape sequence");
+            }
+        }
+        return true;
+    }
+    // 'pos' is right after the '{'
+    bool ReadHexString(std::vector<uint8>& value, std::vector<uint8>& mask)
+    {
+        while (true)
+        {
+            if (!SkipSpacesAndComments())
+                return false;
+            token.line = line;
+            if (pos >= text.size())
+                return Fail("Missing } for a hex string");
+            const auto ch = text[pos];
+            if (ch == '}')
+            {
+                pos++;
+                break;
+            }
+            if (ch == '[')
+            {
+                // fixed size jump: [N] => N wildcards
+                uint32 count = 0;
+                for (pos++; (pos < text.size()) && (text[pos] >= '0') && (text[pos] <= '9'); pos++)
+                    count = std::min<uint32>(count * 10 + (text[pos] - '0'), RuleEngine::MAX_STRING_SIZE + 1);
+                if ((pos >= text.size()) || (text[pos] != ']') || (count == 0))
+                    return Fail("Only fixed size jumps ([N]) are supported in hex strings");
+                if (count > RuleEngine::MAX_STRING_SIZE)
+                    return Fail("Jump is too big");
+                pos++;
+                value.insert(value.end(), count, 0);
+                mask.insert(mask.end(), count, 0);
+                continue;
+            }
+            if ((ch == '(') || (ch == '|'))
+                return Fail("Alternatives are not supported in hex strings");
+            // a byte: two hex digits, where any of them can be '?'
+            if (pos + 1 >= text.size())
+                return Fail("Incomplete hex byte");
+            uint8 b = 0, m = 0;
+            for (uint32 tr = 0; tr < 2; tr++)
+            {
+                const auto digit = text[pos + tr];
+                b <<= 4;
+                m <<= 4;
+                if (digit != '?')
+                {
+                    if (HexValue(digit) < 0)
+                        return Fail("Expecting hex digits or ? in a hex string");
+                    b |= (uint8) HexValue(digit);
+                    m |= 0x0F;
+                }
+            }
+            value.push_back(b);
+            mask.push_back(m);
+            pos += 2;
+        }
+        return Next();
+    }
+    void AddPattern(const std::vector<uint8>& value, const std::vector<uint8>& mask, bool ignoreCase, uint32 stringIndex)
+    {
+        auto& p       = program.patterns.emplace_back();
+        p.value       = value;
+        p.mask        = mask;
+        p.ignoreCase  = ignoreCase;
+        p.stringIndex = stringIndex;
+        p.atomOffset  = 0;
+        p.atomSize    = 0;
+        if (ignoreCase)
+        {
+            for (auto& b : p.value)
+                b = lowerCase.values[b];
+        }
+    }
+    bool ReadString()
+    {
+        auto& rule      = program.rules.back();
+        const auto name = token.text;
+        if (name.back() == '*')
+            return Fail("Invalid string identifier");
+        for (auto idx = rule.firstString; idx < program.strings.size(); idx++)
+        {
+            if (program.strings[idx].name == name)
+                return Fail("Duplicate string identifier");
+        }
+        if (!Next() || !Expect("="))
+            return false;
+
+        std::vector<uint8> value, mask;
+        bool ascii = false, wide = false, ignoreCase = false;
+        if (Is("{"))
+        {
+            if (!ReadHexString(value, mask))
+                return false;
+        }
+        else if (token.type == TokenType::Text)
+        {
+            if (!DecodeText(token.text, value))
+                return false;
+            mask.assign(value.size(), 0xFF);
+            if (!Next())
+                return false;
+            while ((token.type == TokenType::Identifier) && (!Is("condition")))
+            {
+                if (Is("ascii"))
+                    ascii = true;
+                else if (Is("wide"))
+                    wide = true;
+                else if (Is("nocase"))
+                    ignoreCase = true;
+                else
+                {
+                    LocalString<128> tmp;
+                    return Fail(tmp.Format("The '%.*s' modifier is not supported", (int) token.text.size(), token.text.data()));
+                }
+                if (!Next())
+                    return false;
+            }
+        }
+        else if (Is("/"))
+            return Fail("Regular expression strings are not supported");
+        else
+            return Fail("Expecting a text or a hex string");
+
+        if (value.empty())
+            return Fail("Empty string");
+        if (value.size() * (wide ? 2 : 1) > RuleEngine::MAX_STRING_SIZE)
+        {
+            LocalString<128> tmp;
+            return Fail(tmp.Format("A string can have at most %u bytes", RuleEngine::MAX_STRING_SIZE));
+        }
+
+        const auto stringIndex = (uint32) program.strings.size();
+        auto& s                = program.strings.emplace_back();
+        s.name                 = name;
+        s.rule                 = (uint32) (program.rules.size() - 1);
+        rule.stringsCount++;
+        if ((ascii) || (!wide))
+            AddPattern(value, mask, ignoreCase, stringIndex);
+        if (wide)
+        {
+            // UTF-16LE form of the text
+            std::vector<uint8> wValue, wMask;
+            for (size_t idx = 0; idx < value.size(); idx++)
+            {
+                wValue.push_back(value[idx]);
+                wValue.push_back(0);
+                wMask.push_back(mask[idx]);
+                wMask.push_back(0xFF);
+            }
+            AddPattern(wValue, wMask, ignoreCase, stringIndex);
+        }
+        return true;
+    }
+
+    // conditions
+    uint32 AddCondition(ConditionType type, uint32 left = 0, uint32 right = 0, uint64 value = 0)
+    {
+        auto& c     = program.conditions.emplace_back();
+        c.type      = type;
+        c.left      = left;
+        c.right     = right;
+        c.value     = value;
+        c.operation = CompareOperation::Equal;
+        return (uint32) (program.conditions.size() - 1);
+    }
+    bool FindStrings(std::string_view name, std::vector<uint32>& result)
+    {
+        const auto& rule     = program.rules.back();
+        const auto isPattern = name.back() == '*';
+        const auto prefix    = isPattern ? name.substr(0, name.size() - 1) : name;
+        for (auto idx = rule.firstString; idx < rule.firstString + rule.stringsCount; idx++)
+        {
+            const auto& s = program.strings[idx].name;
+            if ((isPattern) ? (std::string_view(s).substr(0, prefix.size()) == prefix) : (s == name))
+                result.push_back(idx);
+        }
+        if (result.empty())
+        {
+            LocalString<128> tmp;
+            return Fail(tmp.Format("Undefined string identifier: $%.*s", (int) name.size(), name.data()));
+        }
+        return true;
+    }
+    bool FindString(uint32& result)
+    {
+        std::vector<uint32> found;
+        if (token.text.back() == '*')
+            return Fail("Wildcards can only be used in a list of strings");
+        if (!FindStrings(token.text, found))
+            return false;
+        result = found[0];
+        return Next();
+    }
+    bool ReadCompareOperation(CompareOperation& op)
+    {
+        if (Is("=="))
+            op = CompareOperation::Equal;
+        else if (Is("!="))
+            op = CompareOperation::Different;
+        else if (Is("<"))
+            op = CompareOperation::Less;
+        else if (Is("<="))
+            op = CompareOperation::LessOrEqual;
+        else if (Is(">"))
+            op = CompareOperation::Greater;
+        else if (Is(">="))
+            op = CompareOperation::GreaterOrEqual;
+        else
+            return Fail("Expecting a comparison operator (==, !=, <, <=, >, >=)");
+        return Next();
+    }
+    bool AddRange(uint32 stringIndex, uint64 start, uint64 end, uint32& result)
+    {
+        if (start > end)
+            return Fail("Invalid range (the first value is bigger than the last one)");
+        program.ranges.push_back({ start, end, stringIndex });
+        program.strings[stringIndex].ranges.push_back((uint32) (program.ranges.size() - 1));
+        result = AddCondition(ConditionType::StringInRange, stringIndex, 0, program.ranges.size() - 1);
+        return true;
+    }
+    bool ReadPrimary(uint32& result)
+    {
+        if (Is("("))
+        {
+            return Next() && ReadOr(result) && Expect(")");
+        }
+        if ((Is("true")) || (Is("false")))
+        {
+            result = AddCondition(Is("true") ? ConditionType::True : ConditionType::False);
+            return Next();
+        }
+        if (token.type == TokenType::StringID)
+        {
+            uint32 idx;
+            uint64 start, end;
+            if (!FindString(idx))
+                return false;
+            if (Is("at"))
+                return Next() && ReadNumber(start) && AddRange(idx, start, start, result);
+            if (Is("in"))
+            {
+                return Next() && Expect("(") && ReadNumber(start) && Expect("..") && ReadNumber(end) && Expect(")") &&
+                       AddRange(idx, start, end, result);
+            }
+            result = AddCondition(ConditionType::StringFound, idx);
+            return true;
+        }
+        if (token.type == TokenType::CountID)
+        {
+            uint32 idx;
+            uint64 value;
+            CompareOperation op;
+            if (!FindString(idx) || !ReadCompareOperation(op) || !ReadNumber(value))
+                return false;
+            result                                = AddCondition(ConditionType::StringCount, idx, 0, value);
+            program.conditions[result].operation = op;
+            return true;
+        }
+        if (Is("filesize"))
+        {
+            uint64 value;
+            CompareOperation op;
+            if (!Next() || !ReadCompareOperation(op) || !ReadNumber(value))
+                return false;
+            result                                = AddCondition(ConditionType::FileSize, 0, 0, value);
+            program.conditions[result].operation = op;
+            return true;
+        }
+        if ((Is("any")) || (Is("all")) || (token.type == TokenType::Number))
+        {
+            const auto all    = Is("all");
+            const auto needed = Is("any") ? 1ULL : token.number;
+            std::vector<uint32> list;
+            if (!Next() || !Expect("of"))
+                return false;
+            if (Is("them"))
+            {
+                if (!FindStrings("*", list) || !Next())
+                    return false;
+            }
+            else
+            {
+                if (!Expect("("))
+                    return false;
+                while (true)
+                {
+                    if (token.type != TokenType::StringID)
+                        return Fail("Expecting a string identifier");
+                    if (!FindStrings(token.text, list) || !Next())
+                        return false;
+                    if (Is(")"))
+                        break;
+                    if (!Expect(","))
+                        return false;
+                }
+                if (!Next())
+                    return false;
+                std::sort(list.begin(), list.end());
+                list.erase(std::unique(list.begin(), list.end()), list.end());
+            }
+            result                              = AddCondition(ConditionType::OfStrings, 0, 0, all ? list.size() : needed);
+            program.conditions[result].strings = std::move(list);
+            return true;
+        }
+        return Fail("Expecting a condition");
+    }
+    bool ReadNot(uint32& result)
+    {
+        if (!Is("not"))
+            return ReadPrimary(result);
+        uint32 operand;
+        if (++depth > MAX_CONDITION_DEPTH)
+            return Fail("The condition is too complex");
+        if (!Next() || !ReadNot(operand))
+            return false;
+        depth--;
+        result = AddCondition(ConditionType::Not, operand);
+        return true;
+    }
+    bool ReadAnd(uint32& result)
+    {
+        if (!ReadNot(result))
+            return false;
+        while (Is("and"))
+        {
+            uint32 right;
+            if (!Next() || !ReadNot(right))
+                return false;
+            result = AddCondition(ConditionType::And, result, right);
+        }
+        return true;
+    }
+    bool ReadOr(uint32& result)
+    {
+        if (++depth > MAX_CONDITION_DEPTH)
+            return Fail("The condition is too complex");
+        if (!ReadAnd(result))
+            return false;
+        while (Is("or"))
+        {
+            uint32 right;
+            if (!Next() || !ReadAnd(right))
+                return false;
+            result = AddCondition(ConditionType::Or, result, right);
+        }
+        depth--;
+        return true;
+    }
+
+    bool ReadRule()
+    {
+        while ((Is("private")) || (Is("global")))
+        {
+            if (!Next())
+                return false;
+        }
+        if ((Is("import")) || (Is("include")))
+            return Fail("Modules and includes are not supported");
+        if (!Expect("rule"))
+            return false;
+        if (token.type != TokenType::Identifier)
+            return Fail("Expecting a rule name");
+        for (const auto& r : program.rules)
+        {
+            if (r.name == token.text)
+                return Fail("Duplicate rule name");
+        }
+        auto& rule        = program.rules.emplace_back();
+        rule.name         = token.text;
+        rule.firstString  = (uint32) program.strings.size();
+        rule.stringsCount = 0;
+        rule.condition    = 0;
+        if (!Next())
+            return false;
+        if (Is(":"))
+        {
+            // tags are ignored
+            if (!Next())
+                return false;
+            while ((token.type == TokenType::Identifier) && (token.text != "condition"))
+            {
+                if (!Next())
+                    return false;
+            }
+        }
+        if (!Expect("{"))
+            return false;
+        if (Is("meta"))
+        {
+            // meta data is ignored
+            if (!Next() || !Expect(":"))
+                return false;
+            while ((token.type == TokenType::Identifier) && (!Is("strings")) && (!Is("condition")))
+            {
+                if (!Next() || !Expect("="))
+                    return false;
+                if ((token.type != TokenType::Text) && (token.type != TokenType::Number) && (!Is("true")) && (!Is("false")))
+                    return Fail("Expecting a text, a number or a boolean value");
+                if (!Next())
+                    return false;
+            }
+        }
+        if (Is("strings"))
+        {
+            if (!Next() || !Expect(":"))
+                return false;
+            while (token.type == TokenType::StringID)
+            {
+                if (!ReadString())
+                    return false;
+            }
+        }
+        uint32 condition;
+        if (!Expect("condition") || !Expect(":") || !ReadOr(condition) || !Expect("}"))
+            return false;
+        program.rules.back().condition = condition;
+        return true;
+    }
+
+  public:
+    RuleEngine::Program program;
+
+    RulesParser(std::string_view _text, String& _error) : text(_text), pos(0), line(1), depth(0), error(_error)
+    {
+        token.type   = TokenType::End;
+        token.line   = 1;
+        token.number = 0;
+    }
+    bool Parse()
+    {
+        if (!Next())
+            return false;
+        while (token.type != TokenType::End)
+        {
+            if (!ReadRule())
+                return false;
+        }
+        if (program.rules.empty())
+            return Fail("No rules defined");
+        return true;
+    }
+};
+
+// the best window of up to MAX_ATOM_SIZE consecutive fixed bytes (common bytes like 00, FF or spaces are avoided)
+bool SelectAtom(RuleEngine::Pattern& p)
+{
+    int32 bestQuality = -1;
+    const auto size   = (uint32) p.value.size();
+    for (uint32 start = 0; start < size; start++)
+    {
+        int32 quality = 0;
+        uint32 len    = 0;
+        for (; (start + len < size) && (len < RuleEngine::MAX_ATOM_SIZE) && (p.mask[start + len] == 0xFF); len++)
+        {
+            const auto b = p.value[start + len];
+            quality += ((b == 0) || (b == 0xFF) || (b == ' ') || (b == 0xCC) || (b == 0x90)) ? 1 : 4;
+        }
+        if ((len > 0) && (quality > bestQuality))
+        {
+            bestQuality  = quality;
+            p.atomOffset = start;
+            p.atomSize   = len;
+        }
+    }
+    return bestQuality >= 0;
+}
+inline bool Compare(uint64 value, CompareOperation op, uint64 expected)
+{
+    switch (op)
+    {
+    case CompareOperation::Equal:
+        return value == expected;
+    case CompareOperation::Different:
+        return value != expected;
+    case CompareOperation::Less:
+        return value < expected;
+    case CompareOperation::LessOrEqual:
+        return value <= expected;
+    case CompareOperation::Greater:
+        return value > expected;
+    case CompareOperation::GreaterOrEqual:
+        return value >= expected;
+    }
+    return false;
+}
+inline bool MatchLess(const SearchMatch& a, const SearchMatch& b)
+{
+    return (a.offset < b.offset) || ((a.offset == b.offset) && (a.patternIndex < b.patternIndex));
+}
+} // namespace
+
+RuleEngine::RuleEngine()
+{
+    this->maxPatternSize = 0;
+}
+void RuleEngine::Clear()
+{
+    this->program = Program();
+    this->transitions.clear();
+    this->outputStart.clear();
+    this->outputs.clear();
+    this->maxPatternSize = 0;
+}
+bool RuleEngine::Compile(std::string_view text, String& error)
+{
+    Clear();
+    RulesParser parser(text, error);
+    if (!parser.Parse())
+        return false;
+    this->program = std::move(parser.program);
+    for (auto& p : this->program.patterns)
+    {
+        if (!SelectAtom(p))
+        {
+            error.Format(
+                  "String $%s (rule %s) must have at least one fixed byte",
+                  this->program.strings[p.stringIndex].name.c_str(),
+                  this->program.rules[this->program.strings[p.stringIndex].rule].name.c_str());
+            Clear();
+            return false;
+        }
+        this->maxPatternSize = std::max<>(this->maxPatternSize, (uint32) p.value.size());
+    }
+    if (!BuildAutomaton(error))
+    {
+        Clear();
+        return false;
+    }
+    return true;
+}
+bool RuleEngine::BuildAutomaton(String& error)
+{
+    // trie of the atoms (the data is converted to lower case before it is matched => the atoms are converted too)
+    std::vector<std::vector<uint32>> found(1);
+    transitions.assign(256, NO_STATE);
+    for (uint32 idx = 0; idx < (uint32) program.patterns.size(); idx++)
+    {
+        const auto& p = program.patterns[idx];
+        uint32 state  = 0;
+        for (uint32 tr = 0; tr < p.atomSize; tr++)
+        {
+            const auto b = lowerCase.values[p.value[p.atomOffset + tr]];
+            auto next    = transitions[(state << 8) | b];
+            if (next == NO_STATE)
+            {
+                if (found.size() >= MAX_STATES)
+                {
+                    error.Format("Too many strings (the search automaton can have at most %u states)", MAX_STATES);
+                    return false;
+                }
+                next = (uint32) found.size();
+                found.emplace_back();
+                transitions.resize(transitions.size() + 256, NO_STATE);
+                transitions[(state << 8) | b] = next;
+            }
+            state = next;
+        }
+        found[state].push_back(idx);
+    }
+
+    // failure links (breadth first) => every missing transition goes where the longest suffix would go
+    std::vector<uint32> fail(found.size(), 0);
+    std::queue<uint32> queue;
+    for (uint32 b = 0; b < 256; b++)
+    {
+        if (transitions[b] == NO_STATE)
+            transitions[b] = 0;
+        else
+            queue.push(transitions[b]);
+    }
+    while (!queue.empty())
+    {
+        const auto state = queue.front();
+        queue.pop();
+        const auto& suffix = found[fail[state]];
+        found[state].insert(found[state].end(), suffix.begin(), suffix.end());
+        for (uint32 b = 0; b < 256; b++)
+        {
+            auto& next         = transitions[(state << 8) | b];
+            const auto viaFail = transitions[(fail[state] << 8) | b];
+            if (next == NO_STATE)
+                next = viaFail;
+            else
+            {
+                fail[next] = viaFail;
+                queue.push(next);
+            }
+        }
+    }
+
+    outputStart.clear();
+    outputs.clear();
+    for (const auto& list : found)
+    {
+        outputStart.push_back((uint32) outputs.size());
+        outputs.insert(outputs.end(), list.begin(), list.end());
+    }
+    outputStart.push_back((uint32) outputs.size());
+    return true;
+}
+
+void RuleEngine::InitResult(RuleScanResult& result, uint64 objectSize) const
+{
+    result.counts.assign(program.strings.size(), 0);
+    result.ranges.assign(program.ranges.size(), false);
+    result.matches.clear();
+    result.objectSize = objectSize;
+}
+void RuleEngine::AddMatch(RuleScanResult& result, const SearchMatch& match) const
+{
+    result.counts[match.patternIndex]++;
+    for (auto idx : program.strings[match.patternIndex].ranges)
+    {
+        const auto& r = program.ranges[idx];
+        if ((match.offset >= r.start) && (match.offset <= r.end))
+            result.ranges[idx] = true;
+    }
+    if (result.matches.size() < MAX_STORED_MATCHES)
+        result.matches.push_back(match);
+}
+bool RuleEngine::Evaluate(uint32 index, const RuleScanResult& result) const
+{
+    const auto& c = program.conditions[index];
+    switch (c.type)
+    {
+    case ConditionType::True:
+        return true;
+    case ConditionType::False:
+        return false;
+    case ConditionType::And:
+        return Evaluate(c.left, result) && Evaluate(c.right, result);
+    case ConditionType::Or:
+        return Evaluate(c.left, result) || Evaluate(c.right, result);
+    case ConditionType::Not:
+        return !Evaluate(c.left, result);
+    case ConditionType::StringFound:
+        return result.counts[c.left] > 0;
+    case ConditionType::StringInRange:
+        return result.ranges[c.value];
+    case ConditionType::StringCount:
+        return Compare(result.counts[c.left], c.operation, c.value);
+    case ConditionType::FileSize:
+        return Compare(result.objectSize, c.operation, c.value);
+    case ConditionType::OfStrings:
+    {
+        uint64 count = 0;
+        for (auto idx : c.strings)
+            count += result.counts[idx] > 0;
+        return count >= c.value;
+    }
+    }
+    return false;
+}
+bool RuleEngine::IsMatching(uint32 rule, const RuleScanResult& result) const
+{
+    CHECK(rule < program.rules.size(), false, "Invalid rule index: %u", rule);
+    CHECK(result.counts.size() == program.strings.size(), false, "The result was not initialized for these rules !");
+    return Evaluate(program.rules[rule].condition, result);
+}
+bool RuleEngine::Scan(DataCache& cache, RuleScanResult& result, const std::atomic<bool>* cancel) const
+{
+    InitResult(result, cache.GetSize());
+    return Search(
+          cache,
+          0,
+          cache.GetSize(),
+          [this, &result](const SearchMatch& m)
+          {
+              AddMatch(result, m);
+              return true;
+          },
+          cancel);
+}
+
+uint32 RuleEngine::GetMaxMatchSize() const
+{
+    return maxPatternSize;
+}
+bool RuleEngine::Search(
+      DataCache& cache,
+      uint64 offset,
+      uint64 size,
+      const std::function<bool(const SearchMatch&)>& onMatch,
+      const std::atomic<bool>* cancel,
+      std::atomic<uint64>* progress) const
+{
+    CHECK(IsCompiled(), false, "No rules !");
+    CHECK((offset <= cache.GetSize()) && (size <= cache.GetSize() - offset), false, "Invalid range: %llu bytes from %llu", size, offset);
+    if (program.patterns.empty())
+        return true; // only conditions like 'filesize' or 'true'
+
+    SequentialReader reader(cache, offset, size);
+    // the automaton state is carried from a chunk to the next one (a single pass over the data) ; a string is verified
+    // when its atom ends => it starts at most (maxPatternSize - 1) bytes before, in the bytes kept from the previous chunk
+    std::vector<SearchMatch> matches;
+    uint8 tail[MAX_STRING_SIZE];
+    const auto keep     = this->maxPatternSize - 1;
+    const auto rangeEnd = offset + size;
+    const auto* trans   = this->transitions.data();
+    auto end            = offset; // end of the previous chunk
+    uint32 state        = 0;
+    for (auto buf = reader.Next(keep); buf.IsValid(); buf = reader.Next(keep))
+    {
+        if ((cancel) && (cancel->load(std::memory_order_relaxed)))
+            return false;
+        const auto chunkOffset = reader.GetChunkOffset();
+        const auto* data       = buf.GetData();
+        const auto len         = (uint32) buf.GetLength();
+        const auto pending     = matches.size();
+        for (auto pos = (uint32) (end - chunkOffset); pos < len; pos++)
+        {
+            state = trans[(state << 8) | lowerCase.values[data[pos]]];
+            if (outputStart[state] == outputStart[state + 1])
+                continue;
+            const auto atomEnd = chunkOffset + pos + 1;
+            for (auto idx = outputStart[state]; idx < outputStart[state + 1]; idx++)
+            {
+                const auto& p = program.patterns[outputs[idx]];
+                if (atomEnd < offset + p.atomOffset + p.atomSize)
+                    continue;
+                const auto start = atomEnd - (p.atomOffset + p.atomSize);
+                const auto psize = (uint32) p.value.size();
+                if (start + psize > rangeEnd)
+                    continue;
+                // the end of the string may be in the next chunk
+                const uint8* s = data + (start - chunkOffset);
+                if (start + psize > chunkOffset + len)
+                {
+                    if (!cache.ReadDirect(start, tail, psize))
+                        continue;
+                    s = tail;
+                }
+                uint32 tr = 0;
+                if (p.ignoreCase)
+                {
+                    for (; (tr < psize) && ((lowerCase.values[s[tr]] & p.mask[tr]) == p.value[tr]); tr++)
+                        ;
+                }
+                else
+                {
+                    for (; (tr < psize) && ((s[tr] & p.mask[tr]) == p.value[tr]); tr++)
+                        ;
+                }
+                if (tr == psize)
+                    matches.push_back({ start, psize, p.stringIndex });
+            }
+        }
+        // same ordering rules as SearchEngine::Search
+        std::sort(matches.begin() + pending, matches.end(), MatchLess);
+        std::inplace_merge(matches.begin(), matches.begin() + pending, matches.end(), MatchLess);
+        end              = chunkOffset + len;
+        const auto limit = end > keep ? end - keep : 0;
+        size_t count     = 0;
+        for (; (count < matches.size()) && (matches[count].offset < limit); count++)
+        {
+            if (!onMatch(matches[count]))
+                return true;
+        }
+        matches.erase(matches.begin(), matches.begin() + count);
+        if (progress)
+            progress->store(end, std::memory_order_relaxed);
+    }
+    for (const auto& m : matches)
+    {
+        if (!onMatch(m))
+            return true;
+    }
+    return !reader.HasErrors();
+}
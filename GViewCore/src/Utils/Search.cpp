@@ -0,0 +1,371 @@
+#include "Internal.hpp"
+
+#include <bit>
+#include <condition_variable>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#    include <emmintrin.h>
+#    define SEARCH_USE_SSE2
+#endif
+
+using namespace GView::Utils;
+using namespace GView::Utils::CharacterEncoding;
+
+constexpr uint32 NOT_USABLE = 0xFFFF;
+
+// approximative frequency of a byte in a regular binary file (the rarest bytes are the best anchors)
+static uint32 ByteWeight(uint8 value, uint8 andMask, uint8 orMask)
+{
+    if (andMask != 0xFF)
+        return NOT_USABLE; // wildcard
+    if (value == 0)
+        return 16;
+    if (value == 0xFF)
+        return 8;
+    if ((orMask != 0) || (value == ' '))
+        return 6; // case insensitive letters match two values
+    if (((value >= 'a') && (value <= 'z')) || ((value >= 'A') && (value <= 'Z')) || ((value >= '0') && (value <= '9')))
+        return 4;
+    if (value < 0x20)
+        return 3;
+    return 2;
+}
+static inline int32 HexDigitValue(char ch)
+{
+    if ((ch >= '0') && (ch <= '9'))
+        return ch - '0';
+    if ((ch >= 'a') && (ch <= 'f'))
+        return ch - 'a' + 10;
+    if ((ch >= 'A') && (ch <= 'F'))
+        return ch - 'A' + 10;
+    return -1;
+}
+static inline bool IsAsciiLetter(char16 ch)
+{
+    return ((ch >= 'a') && (ch <= 'z')) || ((ch >= 'A') && (ch <= 'Z'));
+}
+static inline bool MatchLess(const SearchMatch& a, const SearchMatch& b)
+{
+    return a.offset != b.offset ? a.offset < b.offset : a.patternIndex < b.patternIndex;
+}
+
+SearchEngine::SearchEngine()
+{
+    this->maxPatternSize = 0;
+}
+void SearchEngine::Clear()
+{
+    this->patterns.clear();
+    this->maxPatternSize = 0;
+}
+bool SearchEngine::AddPattern(Pattern& p)
+{
+    const auto size = (uint32) p.value.size();
+    CHECK(size > 0, false, "Empty search pattern !");
+    CHECK(size <= MAX_PATTERN_SIZE, false, "Search patterns are limited to %u bytes (current one has %u bytes)", MAX_PATTERN_SIZE, size);
+
+    // candidates are filtered by the rarest pair of consecutive fixed bytes (or by the rarest fixed byte if there is no such pair)
+    auto best        = NOT_USABLE;
+    p.anchor         = 0;
+    p.twoBytesAnchor = false;
+    for (uint32 tr = 0; tr + 1 < size; tr++)
+    {
+        const auto w1 = ByteWeight(p.value[tr], p.andMask[tr], p.orMask[tr]);
+        const auto w2 = ByteWeight(p.value[tr + 1], p.andMask[tr + 1], p.orMask[tr + 1]);
+        if ((w1 == NOT_USABLE) || (w2 == NOT_USABLE) || (w1 + w2 >= best))
+            continue;
+        best             = w1 + w2;
+        p.anchor         = tr;
+        p.twoBytesAnchor = true;
+    }
+    if (!p.twoBytesAnchor)
+    {
+        for (uint32 tr = 0; tr < size; tr++)
+        {
+            const auto w = ByteWeight(p.value[tr], p.andMask[tr], p.orMask[tr]);
+            if (w < best)
+            {
+                best     = w;
+                p.anchor = tr;
+            }
+        }
+        CHECK(best != NOT_USABLE, false, "A search pattern must have at least one byte that is not a wildcard !");
+    }
+    this->maxPatternSize = std::max<>(this->maxPatternSize, size);
+    this->patterns.push_back(std::move(p));
+    return true;
+}
+bool SearchEngine::AddHexPattern(std::string_view text)
+{
+    Pattern p;
+    size_t idx = 0;
+    while (idx < text.size())
+    {
+        const auto ch = text[idx];
+        if ((ch == ' ') || (ch == '\t') || (ch == ','))
+        {
+            idx++;
+            continue;
+        }
+        CHECK(idx + 1 < text.size(), false, "Incomplete byte at the end of the hex pattern !");
+        const auto next = text[idx + 1];
+        if ((ch == '?') && (next == '?'))
+        {
+            p.value.push_back(0);
+            p.andMask.push_back(0);
+        }
+        else
+        {
+            const auto hi = HexDigitValue(ch);
+            const auto lo = HexDigitValue(next);
+            CHECK((hi >= 0) && (lo >= 0), false, "Invalid byte `%c%c` in hex pattern (expecting two hex digits or ?\?)", ch, next);
+            p.value.push_back((uint8) ((hi << 4) | lo));
+            p.andMask.push_back(0xFF);
+        }
+        p.orMask.push_back(0);
+        idx += 2;
+    }
+    return AddPattern(p);
+}
+bool SearchEngine::AddBytesPattern(BufferView bytes)
+{
+    Pattern p;
+    p.value.assign(bytes.begin(), bytes.end());
+    p.andMask.assign(bytes.GetLength(), 0xFF);
+    p.orMask.assign(bytes.GetLength(), 0);
+    return AddPattern(p);
+}
+bool SearchEngine::AddTextPattern(std::u16string_view text, Encoding encoding, bool ignoreCase)
+{
+    CHECK(encoding != Encoding::Binary, false, "Text patterns need a character encoding !");
+    Pattern p;
+    EncodedCharacter ec;
+    for (auto ch : text)
+    {
+        CHECK((encoding != Encoding::Ascii) || (ch < 256), false, "Character 0x%04X can not be represented in ASCII !", (uint32) ch);
+        const auto bytes    = ec.Encode(ch, encoding);
+        const auto foldCase = ignoreCase && IsAsciiLetter(ch);
+        for (uint32 tr = 0; tr < (uint32) bytes.GetLength(); tr++)
+        {
+            // only the byte that holds the letter is case folded (for UTF-16 the other byte is 0)
+            const auto b    = bytes.GetData()[tr];
+            const auto fold = (uint8) ((foldCase && (b != 0)) ? 0x20 : 0);
+            p.value.push_back(b | fold);
+            p.andMask.push_back(0xFF);
+            p.orMask.push_back(fold);
+        }
+    }
+    return AddPattern(p);
+}
+void SearchEngine::SearchPattern(uint32 index, BufferView buf, uint64 bufOffset, uint32 skip, std::vector<SearchMatch>& matches) const
+{
+    const auto& p    = this->patterns[index];
+    const auto size  = (uint32) p.value.size();
+    const auto len   = (size_t) buf.GetLength();
+    const auto* data = buf.GetData();
+    if (len < size)
+        return;
+    // a match starts in [first, last] ; the ones that end inside the first 'skip' bytes were already reported
+    const size_t first = skip >= size ? skip - size + 1 : 0;
+    const size_t last  = len - size;
+    if (first > last)
+        return;
+
+    const auto* value   = p.value.data();
+    const auto* andMask = p.andMask.data();
+    const auto* orMask  = p.orMask.data();
+    auto check          = [&](size_t start)
+    {
+        const auto* d = data + start;
+        for (uint32 tr = 0; tr < size; tr++)
+        {
+            if (((d[tr] & andMask[tr]) | orMask[tr]) != value[tr])
+                return;
+        }
+        matches.push_back({ bufOffset + start, size, index });
+    };
+
+    // 'pos' iterates through the positions of the anchor (the second anchor byte, if any, is at pos+1 <= len-1)
+    const auto a0v = value[p.anchor];
+    const auto a0o = orMask[p.anchor];
+    const auto a1v = p.twoBytesAnchor ? value[p.anchor + 1] : 0;
+    const auto a1o = p.twoBytesAnchor ? orMask[p.anchor + 1] : 0;
+    const auto end = last + p.anchor;
+    auto pos       = first + p.anchor;
+#if defined(SEARCH_USE_SSE2)
+    // 16 positions at once: (data | orMask) == value for the first anchor byte (and for the second one at +1)
+    const auto v0 = _mm_set1_epi8((char) a0v);
+    const auto o0 = _mm_set1_epi8((char) a0o);
+    if (p.twoBytesAnchor)
+    {
+        const auto v1 = _mm_set1_epi8((char) a1v);
+        const auto o1 = _mm_set1_epi8((char) a1o);
+        for (; pos + 16 <= end + 1; pos += 16)
+        {
+            const auto d0 = _mm_or_si128(_mm_loadu_si128((const __m128i*) (data + pos)), o0);
+            const auto d1 = _mm_or_si128(_mm_loadu_si128((const __m128i*) (data + pos + 1)), o1);
+            auto mask     = (uint32) _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(d0, v0), _mm_cmpeq_epi8(d1, v1)));
+            for (; mask != 0; mask &= mask - 1)
+                check(pos + std::countr_zero(mask) - p.anchor);
+        }
+    }
+    else
+    {
+        for (; pos + 16 <= end + 1; pos += 16)
+        {
+            const auto d0 = _mm_or_si128(_mm_loadu_si128((const __m128i*) (data + pos)), o0);
+            auto mask     = (uint32) _mm_movemask_epi8(_mm_cmpeq_epi8(d0, v0));
+            for (; mask != 0; mask &= mask - 1)
+                check(pos + std::countr_zero(mask) - p.anchor);
+        }
+    }
+#else
+    if (a0o == 0)
+    {
+        // memchr is vectorized by the C runtime
+        while (pos <= end)
+        {
+            const auto* q = reinterpret_cast<const uint8*>(memchr(data + pos, a0v, end + 1 - pos));
+            if (q == nullptr)
+                return;
+            pos = (size_t) (q - data);
+            if ((!p.twoBytesAnchor) || ((data[pos + 1] | a1o) == a1v))
+                check(pos - p.anchor);
+            pos++;
+        }
+        return;
+    }
+#endif
+    for (; pos <= end; pos++)
+    {
+        if ((data[pos] | a0o) != a0v)
+            continue;
+        if ((p.twoBytesAnchor) && ((data[pos + 1] | a1o) != a1v))
+            continue;
+        check(pos - p.anchor);
+    }
+}
+uint32 SearchEngine::GetMaxMatchSize() const
+{
+    return this->maxPatternSize;
+}
+void SearchEngine::SearchBuffer(BufferView buf, uint64 bufOffset, uint32 skip, std::vector<SearchMatch>& matches) const
+{
+    const auto start = matches.size();
+    for (uint32 idx = 0; idx < (uint32) this->patterns.size(); idx++)
+        SearchPattern(idx, buf, bufOffset, skip, matches);
+    // every pattern is searched separately => matches from different patterns are interleaved
+    if (this->patterns.size() > 1)
+        std::sort(matches.begin() + start, matches.end(), MatchLess);
+}
+bool SearchEngine::Search(
+      DataCache& cache,
+      uint64 offset,
+      uint64 size,
+      const std::function<bool(const SearchMatch&)>& onMatch,
+      const std::atomic<bool>* cancel,
+      std::atomic<uint64>* progress) const
+{
+    CHECK(this->patterns.size() > 0, false, "No search patterns !");
+    CHECK((offset <= cache.GetSize()) && (size <= cache.GetSize() - offset), false, "Invalid range: %llu bytes from %llu", size, offset);
+
+    SequentialReader reader(cache, offset, size);
+    // a match that starts in the bytes kept for the next chunk may be preceded by a longer one found only in that chunk
+    // => such matches are reported after the next chunk is searched (this keeps all matches in offset order)
+    std::vector<SearchMatch> matches;
+    const auto keep = this->maxPatternSize - 1;
+    auto end        = offset; // end of the previous chunk
+    for (auto buf = reader.Next(keep); buf.IsValid(); buf = reader.Next(keep))
+    {
+        if ((cancel) && (cancel->load(std::memory_order_relaxed)))
+            return false;
+        const auto chunkOffset = reader.GetChunkOffset();
+        const auto pending     = matches.size();
+        SearchBuffer(buf, chunkOffset, (uint32) (end - chunkOffset), matches);
+        std::inplace_merge(matches.begin(), matches.begin() + pending, matches.end(), MatchLess);
+        end              = chunkOffset + buf.GetLength();
+        const auto limit = end > keep ? end - keep : 0;
+        size_t count     = 0;
+        for (; (count < matches.size()) && (matches[count].offset < limit); count++)
+        {
+            if (!onMatch(matches[count]))
+                return true;
+        }
+        matches.erase(matches.begin(), matches.begin() + count);
+        if (progress)
+            progress->store(end, std::memory_order_relaxed);
+    }
+    for (const auto& m : matches)
+    {
+        if (!onMatch(m))
+            return true;
+    }
+    return !reader.HasErrors();
+}
+bool Searcher::SearchWithProgress(
+      Reference<GView::Object> obj,
+      uint64 offset,
+      uint64 size,
+      std::string_view title,
+      const std::function<bool(const SearchMatch&)>& onMatch) const
+{
+    CHECK(obj.IsValid(), false, "Invalid object !");
+    auto reader = obj->CreateReader();
+    CHECK(reader, false, "Fail to create a reader for the current object !");
+
+    std::atomic<bool> cancel     = false;
+    std::atomic<uint64> progress = offset;
+    std::mutex lock;
+    std::condition_variable cv;
+    bool done   = false;
+    bool result = false;
+    std::thread worker(
+          [&]()
+          {
+              const auto res = Search(*reader, offset, size, onMatch, &cancel, &progress);
+              {
+                  std::lock_guard<std::mutex> guard(lock);
+                  result = res;
+                  done   = true;
+              }
+              cv.notify_all();
+          });
+
+    ProgressStatus::Init(title, size);
+    LocalString<128> text;
+    std::unique_lock<std::mutex> guard(lock);
+    while (!cv.wait_for(guard, std::chrono::milliseconds(100), [&done] { return done; }))
+    {
+        guard.unlock();
+        const auto pos = progress.load(std::memory_order_relaxed) - offset;
+        if (ProgressStatus::Update(pos, text.Format("Searched %llu MB out of %llu MB", pos >> 20, size >> 20)))
+            cancel = true;
+        guard.lock();
+    }
+    guard.unlock();
+    worker.join();
+    return result;
+}
+
+SearchResults::SearchResults()
+{
+    this->maxSize = 0;
+}
+void SearchResults::Clear()
+{
+    // release the memory as well (a search may have millions of results)
+    std::vector<uint64>().swap(this->offsets);
+    std::vector<uint32>().swap(this->sizes);
+    this->maxSize = 0;
+}
+void SearchResults::Add(uint64 offset, uint32 size)
+{
+    this->offsets.push_back(offset);
+    this->sizes.push_back(size);
+    this->maxSize = std::max<>(this->maxSize, size);
+}
+size_t SearchResults::LowerBound(uint64 offset) const
+{
+    return (size_t) (std::lower_bound(this->offsets.begin(), this->offsets.end(), offset) - this->offsets.begin());
+}
@@ -0,0 +1,192 @@
+#include "GView.hpp"
+
+#include <condition_variable>
+#include <thread>
+
+using namespace GView::Utils;
+
+constexpr uint32 MAX_CHUNK_SIZE = 0x1000000U; // 16 M
+constexpr uint32 MIN_CHUNK_SIZE = 0x1000U;    // 4 K
+constexpr uint32 NO_BUFFER      = 0xFFFFFFFFU;
+
+enum class ReaderBufferState : uint8
+{
+    Free,
+    Ready,
+    InUse,
+    Error
+};
+struct ReaderBuffer
+{
+    uint8* data; // SequentialReader::MAX_KEEP_BYTES bytes (room for the kept bytes) + chunkSize
+    uint64 offset;
+    uint32 size;
+    ReaderBufferState state;
+};
+struct SequentialReaderData
+{
+    DataCache& cache;
+    uint64 start, end;
+    uint64 nextOffset; // next offset to be returned to the caller
+    uint64 readOffset; // next offset to be read by the worker thread
+    uint64 chunkOffset;
+    uint32 chunkSize;
+    uint32 current; // index of the buffer that the caller is using
+    BufferView currentView;
+    ReaderBuffer buffers[2];
+    std::thread worker;
+    std::mutex lock;
+    std::condition_variable cv;
+    bool stop, error;
+
+    SequentialReaderData(DataCache& _cache) : cache(_cache)
+    {
+    }
+    void Run()
+    {
+        uint32 index = 0;
+        while (true)
+        {
+            uint64 offset;
+            uint32 size;
+            auto& b = buffers[index];
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                cv.wait(guard, [this, &b] { return stop || (readOffset >= end) || (b.state == ReaderBufferState::Free); });
+                if ((stop) || (readOffset >= end))
+                    return;
+                offset = readOffset;
+                size   = (uint32) std::min<uint64>(chunkSize, end - offset);
+                readOffset += size;
+            }
+            // read outside the lock (the caller keeps processing the other buffer)
+            auto result = cache.ReadDirect(offset, b.data + SequentialReader::MAX_KEEP_BYTES, size);
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                b.offset = offset;
+                b.size   = size;
+                b.state  = result ? ReaderBufferState::Ready : ReaderBufferState::Error;
+            }
+            cv.notify_all();
+            if (!result)
+                return;
+            index ^= 1;
+        }
+    }
+};
+
+SequentialReader::SequentialReader(DataCache& cache, uint64 offset, uint64 size, uint32 chunkSize)
+{
+    auto* d = new SequentialReaderData(cache);
+    data    = d;
+
+    if (chunkSize == 0)
+        chunkSize = cache.GetCacheSize();
+    d->chunkSize   = std::min<>(std::max<>(chunkSize, MIN_CHUNK_SIZE), MAX_CHUNK_SIZE);
+    d->start       = std::min<>(offset, cache.GetSize());
+    d->end         = std::min<>(cache.GetSize() - d->start, size) + d->start;
+    d->nextOffset  = d->start;
+    d->readOffset  = d->start;
+    d->chunkOffset = d->start;
+    d->current     = NO_BUFFER;
+    d->stop        = false;
+    d->error       = false;
+    for (auto& b : d->buffers)
+    {
+        b.data   = nullptr;
+        b.offset = 0;
+        b.size   = 0;
+        b.state  = ReaderBufferState::Free;
+    }
+
+    // memory mapped files and ranges that fit in one chunk do not need a background thread
+    if ((cache.IsMemoryMapped()) || ((d->end - d->start) <= std::min<>(d->chunkSize, cache.GetCacheSize())))
+        return;
+
+    for (auto& b : d->buffers)
+        b.data = new uint8[MAX_KEEP_BYTES + d->chunkSize];
+    d->worker = std::thread(&SequentialReaderData::Run, d);
+}
+SequentialReader::~SequentialReader()
+{
+    auto* d = reinterpret_cast<SequentialReaderData*>(data);
+    if (d->worker.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> guard(d->lock);
+            d->stop = true;
+        }
+        d->cv.notify_all();
+        d->worker.join();
+    }
+    for (auto& b : d->buffers)
+    {
+        if (b.data)
+            delete[] b.data;
+        b.data = nullptr;
+    }
+    delete d;
+    data = nullptr;
+}
+BufferView SequentialReader::Next(uint32 keepBytes)
+{
+    auto* d = reinterpret_cast<SequentialReaderData*>(data);
+    if ((d->nextOffset >= d->end) || (d->error))
+        return BufferView();
+
+    keepBytes = std::min<>({ keepBytes, MAX_KEEP_BYTES, (uint32) d->currentView.GetLength() });
+
+    if (d->cache.IsMemoryMapped())
+    {
+        const auto size = std::min<uint64>(d->chunkSize, d->end - d->nextOffset);
+        // ask the OS to start reading the next chunk while this one is processed
+        d->cache.Prefetch(d->nextOffset + size, d->chunkSize);
+        d->chunkOffset  = d->nextOffset - keepBytes;
+        d->nextOffset  += size;
+        d->currentView  = BufferView(d->cache.GetEntireFile().GetData() + d->chunkOffset, (size_t) (size + keepBytes));
+        return d->currentView;
+    }
+    if (d->worker.joinable() == false)
+    {
+        // the entire range fits in one chunk
+        d->currentView = d->cache.Get(d->start, (uint32) (d->end - d->start), true);
+        d->nextOffset  = d->end;
+        d->chunkOffset = d->start;
+        d->error       = !d->currentView.IsValid();
+        return d->currentView;
+    }
+
+    const auto index = d->current == NO_BUFFER ? 0U : d->current ^ 1;
+    auto& b          = d->buffers[index];
+    std::unique_lock<std::mutex> guard(d->lock);
+    d->cv.wait(guard, [&b] { return b.state != ReaderBufferState::Free; });
+    if (b.state != ReaderBufferState::Ready)
+    {
+        d->error       = true;
+        d->currentView = BufferView();
+        return BufferView();
+    }
+    // copy the kept bytes (from the end of the previous chunk) right before the new data
+    auto* p = b.data + MAX_KEEP_BYTES - keepBytes;
+    if (keepBytes > 0)
+        memcpy(p, d->currentView.GetData() + d->currentView.GetLength() - keepBytes, keepBytes);
+    // the previous buffer can now be reused by the worker thread
+    if (d->current != NO_BUFFER)
+        d->buffers[d->current].state = ReaderBufferState::Free;
+    b.state        = ReaderBufferState::InUse;
+    d->current     = index;
+    d->chunkOffset = b.offset - keepBytes;
+    d->nextOffset  = b.offset + b.size;
+    d->currentView = BufferView(p, (size_t) (b.size + keepBytes));
+    guard.unlock();
+    d->cv.notify_all();
+    return d->currentView;
+}
+uint64 SequentialReader::GetChunkOffset() const
+{
+    return reinterpret_cast<SequentialReaderData*>(data)->chunkOffset;
+}
+bool SequentialReader::HasErrors() const
+{
+    return reinterpret_cast<SequentialReaderData*>(data)->error;
+}
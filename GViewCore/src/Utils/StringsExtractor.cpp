@@ -0,0 +1,456 @@
+#include "Internal.hpp"
+
+#include <bit>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#    include <emmintrin.h>
+#    define STRINGS_USE_SSE2
+#endif
+
+using namespace GView::Utils;
+
+constexpr uint32 MAX_MASK_RANGES = 4;          // masks made of more byte ranges are classified one byte at a time
+constexpr uint64 MAX_STRING_SIZE = 0x80000000; // longer strings are split
+constexpr size_t MAX_EXTRACTORS  = 4;          // past this, the last extractor that was added is restarted with the new settings
+
+// tab and the printable ASCII characters except for '`'
+const bool StringsExtractor::DefaultAsciiMask[256] = {
+    false, false, false, false, false, false, false, false, false, true,  false, false, false, false, false, false, false, false, false,
+    false, false, false, false, false, false, false, false, false, false, false, false, false, true,  true,  true,  true,  true,  true,
+    true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,
+    true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,
+    true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,
+    true,  false, true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,
+    true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  false, false, false, false, false, false,
+    false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false,
+    false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false,
+    false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false,
+    false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false,
+    false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false,
+    false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false,
+    false, false, false, false, false, false, false, false, false
+};
+
+namespace
+{
+// finds, in a single pass, the ASCII strings and the UTF-16LE strings that start on even or odd offsets (two "tracks")
+// strings are reported when they end => the caller sorts them
+class StringScanner
+{
+    struct Run
+    {
+        uint64 start;
+        uint64 count;  // characters
+        bool pending;  // the low byte of a UTF-16 character was found, its high byte is the next one
+    };
+    const bool* mask;
+    uint64 minCount;
+    Run ascii;
+    Run tracks[2];
+    uint32 rangesCount;
+#ifdef STRINGS_USE_SSE2
+    __m128i rangeStart[MAX_MASK_RANGES];
+    __m128i rangeSize[MAX_MASK_RANGES];
+#endif
+
+    void Emit(uint64 start, uint64 size, bool unicode)
+    {
+        while (size > 0)
+        {
+            const auto part = std::min<>(size, MAX_STRING_SIZE);
+            found.push_back({ start, (uint32) part, unicode });
+            start += part;
+            size -= part;
+        }
+    }
+    inline void EndAscii()
+    {
+        if (ascii.count >= minCount)
+            Emit(ascii.start, ascii.count, false);
+        ascii.count = 0;
+    }
+    inline void EndTrack(Run& r)
+    {
+        if (r.count >= minCount)
+            Emit(r.start, r.count * 2, true);
+        r.count   = 0;
+        r.pending = false;
+    }
+    inline void ProcessByte(uint64 pos, uint8 value)
+    {
+        const auto printable = mask[value];
+        if (printable)
+        {
+            if (ascii.count++ == 0)
+                ascii.start = pos;
+        }
+        else if (ascii.count)
+            EndAscii();
+
+        // 'value' is the high byte of the UTF-16 character that started at pos-1 ...
+        auto& high = tracks[(pos & 1) ^ 1];
+        if (high.pending)
+        {
+            high.pending = false;
+            if (value == 0)
+                high.count++;
+            else
+                EndTrack(high);
+        }
+        // ... and the low byte of a character that starts at pos
+        auto& low = tracks[pos & 1];
+        if (printable)
+        {
+            if (low.count == 0)
+                low.start = pos;
+            low.pending = true;
+        }
+        else if (low.count)
+            EndTrack(low);
+    }
+
+    inline bool IsIdle() const
+    {
+        return (ascii.count | tracks[0].count | tracks[1].count) == 0 && (!tracks[0].pending) && (!tracks[1].pending);
+    }
+    // one bit for every byte from p[0..63] that is in the mask
+    inline uint64 GetPrintableMask(const uint8* p) const
+    {
+#ifdef STRINGS_USE_SSE2
+        if (rangesCount <= MAX_MASK_RANGES)
+        {
+            uint64 result = 0;
+            for (uint32 block = 0; block < 4; block++)
+            {
+                const auto data = _mm_loadu_si128((const __m128i*) (p + block * 16));
+                auto printable  = _mm_setzero_si128();
+                for (uint32 tr = 0; tr < rangesCount; tr++)
+                {
+                    // (value - start) <= size (unsigned) <=> value is in [start, start + size]
+                    const auto delta = _mm_sub_epi8(data, rangeStart[tr]);
+                    printable        = _mm_or_si128(printable, _mm_cmpeq_epi8(_mm_min_epu8(delta, rangeSize[tr]), delta));
+                }
+                result |= ((uint64) (uint32) _mm_movemask_epi8(printable)) << (block * 16);
+            }
+            return result;
+        }
+#endif
+        uint64 result = 0;
+        for (uint32 tr = 0; tr < 64; tr++)
+            result |= ((uint64) mask[p[tr]]) << tr;
+        return result;
+    }
+    inline uint64 GetZeroMask(const uint8* p) const
+    {
+#ifdef STRINGS_USE_SSE2
+        uint64 result   = 0;
+        const auto zero = _mm_setzero_si128();
+        for (uint32 block = 0; block < 4; block++)
+        {
+            const auto data = _mm_loadu_si128((const __m128i*) (p + block * 16));
+            result |= ((uint64) (uint32) _mm_movemask_epi8(_mm_cmpeq_epi8(data, zero))) << (block * 16);
+        }
+        return result;
+#else
+        uint64 result = 0;
+        for (uint32 tr = 0; tr < 64; tr++)
+            result |= ((uint64) (p[tr] == 0)) << tr;
+        return result;
+#endif
+    }
+    // bit i is set if position i could start a string of at least minCount characters ; the bytes after the 64 byte group
+    // are not known => they are considered to be part of the string (the result may have a few false positives)
+    inline uint64 GetCandidates(uint64 printable, uint64 zero) const
+    {
+        if (printable == 0)
+            return 0;
+        const auto utf16 = printable & ((zero >> 1) | (1ULL << 63)); // printable byte followed by a 0
+        auto ascii       = printable;
+        auto unicode     = utf16;
+        for (uint64 tr = 1; (tr < minCount) && ((ascii | unicode) != 0); tr++)
+        {
+            ascii &= tr < 64 ? ((printable >> tr) | (~0ULL << (64 - tr))) : ~0ULL;
+            unicode &= tr < 32 ? ((utf16 >> (tr * 2)) | (~0ULL << (64 - tr * 2))) : ~0ULL;
+        }
+        return ascii | unicode;
+    }
+
+  public:
+    std::vector<StringRange> found;
+
+    StringScanner(const bool* _mask, uint32 _minCount) : mask(_mask), minCount(std::max<>(_minCount, 1U)), rangesCount(0)
+    {
+        ascii     = { 0, 0, false };
+        tracks[0] = { 0, 0, false };
+        tracks[1] = { 0, 0, false };
+
+        // the mask is usually made of a few byte ranges (tab, space..'_', 'a'..'~') => they can be checked 16 bytes at a time
+        for (uint32 value = 0; value < 256;)
+        {
+            if (!mask[value])
+            {
+                value++;
+                continue;
+            }
+            auto end = value;
+            while ((end < 256) && (mask[end]))
+                end++;
+            if (rangesCount >= MAX_MASK_RANGES)
+            {
+                rangesCount = MAX_MASK_RANGES + 1; // too many ranges
+                break;
+            }
+#ifdef STRINGS_USE_SSE2
+            rangeStart[rangesCount] = _mm_set1_epi8((char) value);
+            rangeSize[rangesCount]  = _mm_set1_epi8((char) (end - 1 - value));
+#endif
+            rangesCount++;
+            value = end;
+        }
+    }
+    void Process(BufferView buf, uint64 offset)
+    {
+        const auto* p = buf.GetData();
+        const auto* e = p + buf.GetLength();
+        // while no string is in progress, the bytes that can not start a string are skipped (64 bytes at a time)
+        for (; p + 64 <= e; p += 64, offset += 64)
+        {
+            const auto printable  = GetPrintableMask(p);
+            const auto zero       = printable != 0 ? GetZeroMask(p) : 0;
+            const auto text       = printable & (~zero);
+            const auto candidates = GetCandidates(printable, zero);
+            uint32 idx            = 0;
+            while (idx < 64)
+            {
+                if (IsIdle())
+                {
+                    const auto next = candidates & (~0ULL << idx);
+                    if (next == 0)
+                        break;
+                    idx = (uint32) std::countr_zero(next);
+                }
+                else
+                {
+                    // inside an ASCII run: the UTF-16 characters that start in it are broken by the next (non zero) byte
+                    const auto run = std::min<>((uint32) std::countr_zero((~text) >> idx), 64 - idx);
+                    if (run >= 8)
+                    {
+                        ProcessByte(offset + idx, p[idx]);
+                        ProcessByte(offset + idx + 1, p[idx + 1]);
+                        ascii.count += run - 4;
+                        tracks[0] = { 0, 0, false };
+                        tracks[1] = { 0, 0, false };
+                        ProcessByte(offset + idx + run - 2, p[idx + run - 2]);
+                        ProcessByte(offset + idx + run - 1, p[idx + run - 1]);
+                        idx += run;
+                        continue;
+                    }
+                }
+                ProcessByte(offset + idx, p[idx]);
+                idx++;
+            }
+        }
+        for (; p < e; p++, offset++)
+            ProcessByte(offset, *p);
+    }
+    void Finish()
+    {
+        EndAscii();
+        tracks[0].pending = false;
+        tracks[1].pending = false;
+        EndTrack(tracks[0]);
+        EndTrack(tracks[1]);
+    }
+    // every string that will be found from now on starts after this offset
+    uint64 GetStableOffset(uint64 scanned) const
+    {
+        auto result = scanned;
+        if (ascii.count)
+            result = std::min<>(result, ascii.start);
+        for (const auto& t : tracks)
+        {
+            if (t.count || t.pending)
+                result = std::min<>(result, t.start);
+        }
+        return result;
+    }
+};
+} // namespace
+
+StringsExtractor::StringsExtractor()
+{
+    this->stop        = false;
+    this->completed   = false;
+    this->indexedSize = 0;
+    this->scannedSize = 0;
+    this->objectSize  = 0;
+    this->minCount    = DEFAULT_MIN_COUNT;
+    memcpy(this->asciiMask, DefaultAsciiMask, sizeof(this->asciiMask));
+}
+StringsExtractor::~StringsExtractor()
+{
+    Stop();
+}
+void StringsExtractor::Stop()
+{
+    this->stop = true;
+    if (this->worker.joinable())
+        this->worker.join();
+    this->stop = false;
+}
+bool StringsExtractor::Start(Reference<GView::Object> obj, const bool mask[256], uint32 _minCount)
+{
+    Stop();
+    {
+        std::lock_guard<std::mutex> guard(this->lock);
+        std::deque<StringRange>().swap(this->strings);
+        this->indexedSize = 0;
+    }
+    this->completed   = false;
+    this->scannedSize = 0;
+    this->minCount    = _minCount;
+    memcpy(this->asciiMask, mask, sizeof(this->asciiMask));
+
+    CHECK(obj.IsValid(), false, "Invalid object !");
+    this->objectSize = obj->GetData().GetSize();
+    auto reader      = obj->CreateReader();
+    CHECK(reader, false, "Fail to create a reader for the current object !");
+    this->worker = std::thread(&StringsExtractor::Run, this, std::move(reader));
+    return true;
+}
+bool StringsExtractor::HasSettings(const bool mask[256], uint32 _minCount) const
+{
+    return (this->minCount == _minCount) && (memcmp(this->asciiMask, mask, sizeof(this->asciiMask)) == 0);
+}
+bool StringsExtractor::Publish(std::vector<StringRange>& found, uint64 stableOffset)
+{
+    // strings are found when they end => the ones that start before 'stableOffset' are sorted and moved into the index
+    std::sort(
+          found.begin(),
+          found.end(),
+          [](const StringRange& a, const StringRange& b)
+          { return (a.offset < b.offset) || ((a.offset == b.offset) && (a.unicode < b.unicode)); });
+    size_t count = 0;
+    std::lock_guard<std::mutex> guard(this->lock);
+    for (; (count < found.size()) && (found[count].offset < stableOffset); count++)
+    {
+        auto s = found[count];
+        if (!this->strings.empty())
+        {
+            // an ASCII string may end with the first character of an UTF-16 one => the first one wins
+            const auto& last = this->strings.back();
+            const auto end   = last.offset + last.size;
+            if (end > s.offset)
+            {
+                auto skip = end - s.offset;
+                if (s.unicode)
+                    skip = (skip + 1) & (~1ULL);
+                if (skip >= s.size)
+                    continue;
+                s.offset += skip;
+                s.size -= (uint32) skip;
+                if (s.size < (s.unicode ? this->minCount * 2 : this->minCount))
+                    continue;
+            }
+        }
+        if (this->strings.size() >= MAX_STRINGS)
+        {
+            // the index is full => it is final up to the end of its last string
+            const auto& last = this->strings.back();
+            this->indexedSize.store(std::min<>(last.offset + last.size, stableOffset), std::memory_order_release);
+            return false;
+        }
+        this->strings.push_back(s);
+    }
+    found.erase(found.begin(), found.begin() + count);
+    this->indexedSize.store(std::min<>(stableOffset, this->objectSize), std::memory_order_release);
+    return true;
+}
+void StringsExtractor::Run(std::unique_ptr<DataCache> reader)
+{
+    StringScanner scanner(this->asciiMask, this->minCount);
+    SequentialReader sr(*reader, 0, this->objectSize);
+    uint64 end = 0;
+    for (auto buf = sr.Next(); buf.IsValid(); buf = sr.Next())
+    {
+        if (this->stop.load(std::memory_order_relaxed))
+            return;
+        scanner.Process(buf, sr.GetChunkOffset());
+        end = sr.GetChunkOffset() + buf.GetLength();
+        this->scannedSize.store(end, std::memory_order_relaxed);
+        if (!Publish(scanner.found, scanner.GetStableOffset(end)))
+        {
+            this->completed.store(true, std::memory_order_release);
+            return;
+        }
+    }
+    if (this->stop.load(std::memory_order_relaxed))
+        return;
+    scanner.Finish();
+    if (Publish(scanner.found, end + 1))
+        this->indexedSize.store(end, std::memory_order_release);
+    this->completed.store(true, std::memory_order_release);
+}
+size_t StringsExtractor::GetCount() const
+{
+    std::lock_guard<std::mutex> guard(this->lock);
+    return this->strings.size();
+}
+bool StringsExtractor::GetString(size_t index, StringRange& result) const
+{
+    std::lock_guard<std::mutex> guard(this->lock);
+    CHECK(index < this->strings.size(), false, "Invalid string index: %llu", (uint64) index);
+    result = this->strings[index];
+    return true;
+}
+bool StringsExtractor::Find(uint64 offset, StringRange& result, uint64& gapEnd) const
+{
+    std::lock_guard<std::mutex> guard(this->lock);
+    const auto indexed = this->indexedSize.load(std::memory_order_acquire);
+    if (offset >= indexed)
+        return false;
+    auto it = std::upper_bound(
+          this->strings.begin(), this->strings.end(), offset, [](uint64 value, const StringRange& s) { return value < s.offset; });
+    if (it != this->strings.begin())
+    {
+        const auto& prev = *(it - 1);
+        if (offset < prev.offset + prev.size)
+        {
+            result = prev;
+            return true;
+        }
+    }
+    result = { offset, 0, false };
+    gapEnd = (it != this->strings.end()) ? std::min<>(it->offset, indexed) : indexed;
+    return true;
+}
+
+void StringsExtractorList::Init(Reference<GView::Object> object)
+{
+    this->extractors.clear();
+    this->obj = nullptr;
+    if ((object.IsValid()) && (object->GetObjectType() != GView::Object::Type::Folder) &&
+        (object->GetObjectType() != GView::Object::Type::Process))
+        this->obj = object;
+}
+Reference<StringsExtractor> StringsExtractorList::Get(const bool mask[256], uint32 minCount)
+{
+    if (this->obj.IsValid() == false)
+        return nullptr;
+    for (auto& e : this->extractors)
+    {
+        if (e->HasSettings(mask, minCount))
+            return e.get();
+    }
+    // the first extractor (usually the one with the default settings, used by the Strings panel) is never restarted
+    if (this->extractors.size() >= MAX_EXTRACTORS)
+    {
+        auto& e = this->extractors.back();
+        CHECK(e->Start(this->obj, mask, minCount), nullptr, "Fail to restart the strings extraction !");
+        return e.get();
+    }
+    auto e = std::make_unique<StringsExtractor>();
+    CHECK(e->Start(this->obj, mask, minCount), nullptr, "Fail to start the strings extraction !");
+    this->extractors.push_back(std::move(e));
+    return this->extractors.back().get();
+}
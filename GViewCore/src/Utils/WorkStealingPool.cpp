@@ -0,0 +1,125 @@
+#include "Internal.hpp"
+
+using namespace GView::Utils;
+
+WorkStealingPool::WorkStealingPool()
+{
+    this->queued    = 0;
+    this->pending   = 0;
+    this->nextQueue = 0;
+    this->stop      = false;
+    this->count     = 0;
+}
+WorkStealingPool::~WorkStealingPool()
+{
+    Stop();
+}
+bool WorkStealingPool::Start(uint32 workers)
+{
+    CHECK(this->threads.empty(), false, "The pool was already started !");
+    if (workers == 0)
+        workers = std::thread::hardware_concurrency();
+    this->count     = std::clamp<uint32>(workers, 1, MAX_WORKERS);
+    this->queues    = std::make_unique<Queue[]>(this->count);
+    this->queued    = 0;
+    this->pending   = 0;
+    this->nextQueue = 0;
+    this->stop      = false;
+    for (uint32 tr = 0; tr < this->count; tr++)
+        this->threads.emplace_back(&WorkStealingPool::Run, this, tr);
+    return true;
+}
+void WorkStealingPool::Stop()
+{
+    {
+        std::lock_guard<std::mutex> guard(this->lock);
+        this->stop = true;
+    }
+    this->workAvailable.notify_all();
+    for (auto& t : this->threads)
+        if (t.joinable())
+            t.join();
+    this->threads.clear();
+    this->queues.reset(); // the dropped tasks
+    this->count  = 0;
+    this->queued = 0;
+    {
+        // a Wait that is in progress returns (the dropped tasks will never complete)
+        std::lock_guard<std::mutex> guard(this->lock);
+        this->pending = 0;
+    }
+    this->allDone.notify_all();
+}
+void WorkStealingPool::Push(Task task, uint32 worker)
+{
+    // tasks from outside the pool are spread over all the queues
+    if (worker >= this->count)
+        worker = this->nextQueue.fetch_add(1, std::memory_order_relaxed) % this->count;
+    this->pending++;
+    {
+        auto& q = this->queues[worker];
+        std::lock_guard<std::mutex> guard(q.lock);
+        q.tasks.push_back(std::move(task));
+    }
+    {
+        // the counter is updated under the lock => a worker that is about to sleep can not miss it
+        std::lock_guard<std::mutex> guard(this->lock);
+        this->queued++;
+    }
+    this->workAvailable.notify_one();
+}
+bool WorkStealingPool::Pop(uint32 worker, Task& task)
+{
+    // own queue => the newest task (LIFO keeps the data of the worker hot)
+    {
+        auto& q = this->queues[worker];
+        std::lock_guard<std::mutex> guard(q.lock);
+        if (!q.tasks.empty())
+        {
+            task = std::move(q.tasks.back());
+            q.tasks.pop_back();
+            this->queued--;
+            return true;
+        }
+    }
+    // the other queues => the oldest task (usually the largest amount of work that is left)
+    for (uint32 tr = 1; tr < this->count; tr++)
+    {
+        auto& q = this->queues[(worker + tr) % this->count];
+        std::lock_guard<std::mutex> guard(q.lock);
+        if (!q.tasks.empty())
+        {
+            task = std::move(q.tasks.front());
+            q.tasks.pop_front();
+            this->queued--;
+            return true;
+        }
+    }
+    return false;
+}
+void WorkStealingPool::Run(uint32 worker)
+{
+    Task task;
+    // 'stop' is checked before every task => the tasks that are still queued when Stop is called are dropped
+    while (!this->stop.load(std::memory_order_relaxed))
+    {
+        if (Pop(worker, task))
+        {
+            task(worker);
+            task = nullptr;
+            if (this->pending.fetch_sub(1) == 1)
+            {
+                std::lock_guard<std::mutex> guard(this->lock);
+                this->allDone.notify_all();
+            }
+            continue;
+        }
+        std::unique_lock<std::mutex> guard(this->lock);
+        this->workAvailable.wait(guard, [this] { return this->stop || this->queued > 0; });
+    }
+}
+bool WorkStealingPool::Wait(std::chrono::milliseconds timeout)
+{
+    std::unique_lock<std::mutex> guard(this->lock);
+    return this->allDone.wait_for(guard, timeout, [this] { return this->pending == 0; });
+}
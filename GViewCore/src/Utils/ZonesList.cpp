@@ -3,7 +3,8 @@
 using namespace GView::Utils;
 using namespace AppCUI::Graphics;
 
-constexpr uint32 MAX_ZONES = 0x100000U;
+constexpr uint32 MAX_ZONES = 0x40000000U;
+constexpr uint32 NO_ZONE   = 0xFFFFFFFFU;
 
 ZonesList::ZonesList()
 {
@@ -13,6 +14,7 @@ ZonesList::ZonesList()
     lastZone   = nullptr;
     cacheEnd   = INVALID_OFFSET;
     cacheStart = INVALID_OFFSET;
+    indexed    = false;
 }
 ZonesList::~ZonesList()
 {
@@ -24,93 +26,144 @@ ZonesList::~ZonesList()
     cacheStart = INVALID_OFFSET;
     count      = 0;
     allocated  = 0;
+    indexed    = false;
 }
 bool ZonesList::Reserve(uint32 newAllocatedSize)
 {
     if (newAllocatedSize <= allocated)
         return true;
+    CHECK(newAllocatedSize <= MAX_ZONES, false, "A maximum of %u zones can be create !", MAX_ZONES);
 
-    uint32 newSize = allocated << 1;
-    if (newSize == 0)
-        newSize = 8;
-
-    while ((newSize < newAllocatedSize) && (newSize < MAX_ZONES))
-        newSize = newSize << 1;
-    CHECK(newSize < MAX_ZONES, false, "A maximum of %u zones can be create !", MAX_ZONES);
-    Zone* tmp = new Zone[newSize];
+    // the exact size is allocated => a caller that knows how many zones will be added (bulk add) does not waste memory
+    Zone* tmp = new Zone[newAllocatedSize];
     if (count > 0)
     {
         memcpy(tmp, list, ((size_t) count) * sizeof(Zone));
     }
     if (list)
         delete[] list;
-    list      = tmp;
-    allocated = newSize;
+    list       = tmp;
+    allocated  = newAllocatedSize;
+    lastZone   = nullptr; // it pointed in the old list
+    cacheEnd   = INVALID_OFFSET;
+    cacheStart = INVALID_OFFSET;
     return true;
 }
 
+void ZonesList::Clear()
+{
+    // the allocated memory is kept (the list is usually filled again)
+    count      = 0;
+    lastZone   = nullptr;
+    cacheEnd   = INVALID_OFFSET;
+    cacheStart = INVALID_OFFSET;
+    indexed    = false;
+    segments.clear();
+}
 bool ZonesList::Add(uint64 s, uint64 e, ColorPair c, std::string_view txt)
 {
     if (count >= allocated)
     {
-        CHECK(Reserve(count + 1), false, "");
+        CHECK(Reserve(std::clamp<uint32>(allocated << 1, 8, MAX_ZONES)), false, "");
+        CHECK(count < allocated, false, "A maximum of %u zones can be create !", MAX_ZONES);
     }
     list[count].Set(s, e, c, txt);
     count++;
+    // the index is built again (once) at the next lookup => adding many zones is not slowed down by it
+    indexed    = false;
+    lastZone   = nullptr;
+    cacheStart = INVALID_OFFSET;
+    cacheEnd   = INVALID_OFFSET;
     return true;
 }
-const Zone* ZonesList::OffsetToZone(uint64 position)
+void ZonesList::BuildIndex()
 {
-    if ((position >= cacheStart) && (position <= cacheEnd) && (position != INVALID_OFFSET))
-        return lastZone;
-
-    if ((lastZone) && (position >= lastZone->start) && (position < lastZone->end))
-        return lastZone;
-
-    auto z     = list;
-    auto e     = z + count;
-    Zone* last = nullptr;
-    uint64 closestEnd, closestStart;
-    closestStart = 0;
-    closestEnd   = INVALID_OFFSET;
-    if (z)
+    // splits [0, INVALID_OFFSET) in disjoint segments where the same zone wins (the last added one that contains them)
+    // sweep over the starts and the ends of the zones, with a heap of the zones that may contain the current point
+    // zones are usually added in order and do not overlap => no sort is needed and the heap has at most one element
+    auto startsSorted = true, endsSorted = true;
+    for (uint32 tr = 1; tr < count; tr++)
     {
-        for (; z != e; z++)
-        {
-            if ((position >= z->start) && (position <= z->end))
-            {
-                last = z;
-                continue;
-            }
-            if ((z->end < position) && (z->end > closestStart))
-                closestStart = z->end;
-            if ((z->start > position) && (z->start < closestEnd))
-                closestEnd = z->start;
-        }
+        startsSorted &= list[tr - 1].start <= list[tr].start;
+        endsSorted &= list[tr - 1].end <= list[tr].end;
     }
-    if (last != nullptr)
+    std::vector<std::pair<uint64, uint32>> starts;
+    std::vector<uint64> ends;
+    if (!startsSorted)
     {
-        if (closestStart > last->start)
-            cacheStart = closestStart;
-        else
-            cacheStart = last->start;
-        if (closestEnd < last->end)
-            cacheEnd = closestEnd;
-        else
-            cacheEnd = last->end;
+        starts.resize(count);
+        for (uint32 tr = 0; tr < count; tr++)
+            starts[tr] = { list[tr].start, tr };
+        std::stable_sort(starts.begin(), starts.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
     }
-    else
+    if (!endsSorted)
     {
-        if ((closestEnd > 0) && (closestEnd != INVALID_OFFSET))
+        ends.resize(count);
+        for (uint32 tr = 0; tr < count; tr++)
+            ends[tr] = list[tr].end;
+        std::sort(ends.begin(), ends.end());
+    }
+    auto startOf = [&](uint32 idx) -> uint64 { return startsSorted ? list[idx].start : starts[idx].first; };
+    auto zoneOf  = [&](uint32 idx) -> uint32 { return startsSorted ? idx : starts[idx].second; };
+    auto endOf   = [&](uint32 idx) -> uint64 { return endsSorted ? list[idx].end : ends[idx]; };
+
+    std::priority_queue<uint32> active; // the zone with the highest index wins
+    uint32 nextStart = 0, nextEnd = 0;
+    segments.clear();
+    segments.reserve(((size_t) count) + 1);
+    segments.push_back({ 0, NO_ZONE });
+    // a zone that ends at INVALID_OFFSET - 1 (or after) never has to be removed
+    while (((nextEnd < count) && (endOf(nextEnd) < INVALID_OFFSET - 1)) || (nextStart < count))
+    {
+        uint64 p = INVALID_OFFSET;
+        if (nextStart < count)
+            p = startOf(nextStart);
+        if ((nextEnd < count) && (endOf(nextEnd) < INVALID_OFFSET - 1))
+            p = std::min<>(p, endOf(nextEnd) + 1);
+        while ((nextEnd < count) && (endOf(nextEnd) < p))
+            nextEnd++;
+        // zones that ended are removed only when they would win (they are never checked otherwise) ; this is done
+        // before adding the new ones => for zones that do not overlap the heap has at most one element
+        while ((!active.empty()) && (list[active.top()].end < p))
+            active.pop();
+        while ((nextStart < count) && (startOf(nextStart) == p))
+            active.push(zoneOf(nextStart++));
+        const auto zone = active.empty() ? NO_ZONE : active.top();
+        if (segments.back().start == p)
         {
-            cacheStart = closestStart;
-            cacheEnd   = closestEnd - 1;
+            segments.back().zone = zone;
+            if ((segments.size() > 1) && (segments[segments.size() - 2].zone == zone))
+                segments.pop_back();
         }
-        else
+        else if (segments.back().zone != zone)
         {
-            cacheStart = cacheEnd = INVALID_OFFSET;
+            segments.push_back({ p, zone });
         }
     }
-    lastZone = last;
-    return last;
-}
\ No newline at end of file
+    indexed = true;
+}
+const Zone* ZonesList::OffsetToZone(uint64 position)
+{
+    uint64 runEnd;
+    return OffsetToZone(position, runEnd);
+}
+const Zone* ZonesList::OffsetToZone(uint64 position, uint64& runEnd)
+{
+    if ((position >= cacheStart) && (position <= cacheEnd) && (position != INVALID_OFFSET))
+    {
+        runEnd = cacheEnd;
+        return lastZone;
+    }
+    if (!indexed)
+        BuildIndex();
+
+    // the segment that contains 'position' is the last one that starts before (or at) it
+    const auto cmp = [](uint64 value, const Segment& seg) { return value < seg.start; };
+    auto it        = std::upper_bound(segments.begin(), segments.end(), position, cmp);
+    runEnd         = it != segments.end() ? it->start - 1 : INVALID_OFFSET - 1;
+    it--; // the first segment starts at 0
+    cacheStart = it->start;
+    cacheEnd   = runEnd;
+    lastZone   = it->zone == NO_ZONE ? nullptr : list + it->zone;
+    return lastZone;
+}
@@ -43,6 +43,7 @@ namespace View
         {
             OnView,
             OnHeader,
+            OnEntropyMap,
             Outside
         };
         struct MousePositionInfo
@@ -50,12 +51,27 @@ namespace View
             MouseLocation location;
             uint64 bufferOffset;
         };
+        struct SearchData
+        {
+            std::u16string text;
+            uint32 typeIndex;
+            bool matchCase;
+            bool findAll;
+            GView::Utils::SearchEngine engine;          // patterns of the last search (used by FindNext / FindPrevious)
+            GView::Utils::RegexEngine regex;            // regular expression of the last search
+            Reference<GView::Utils::Searcher> searcher; // 'engine' or 'regex' (null before the first search)
+            GView::Utils::SearchResults results;        // all the matches (only after a "find all" search)
+            SearchData();
+        };
         struct Config
         {
             struct
             {
                 ColorPair Ascii;
                 ColorPair Unicode;
+                ColorPair SearchMatch;
+                Color EntropyMap[5];                  // foreground of the entropy map for each EntropyMap::BlockType
+                Color EntropyMapBack, EntropyMapView; // background of the entropy map (EntropyMapView for the visible rows)
             } Colors;
             struct
             {
@@ -65,6 +81,10 @@ namespace View
                 AppCUI::Input::Key GoToEntryPoint;
                 AppCUI::Input::Key ChangeSelectionType;
                 AppCUI::Input::Key ShowHideStrings;
+                AppCUI::Input::Key FindNext;
+                AppCUI::Input::Key FindPrevious;
+                AppCUI::Input::Key ShowFindResults;
+                AppCUI::Input::Key Follow;
             } Keys;
             bool Loaded;
 
@@ -74,6 +94,10 @@ namespace View
 
         class Instance : public View::ViewControl
         {
+            struct UnicodeRun
+            {
+                uint64 start, end, middle;
+            };
             struct DrawLineInfo
             {
                 uint64 offset;
@@ -85,8 +109,13 @@ namespace View
                 Character* chNameAndSize;
                 Character* chNumbers;
                 Character* chText;
+                std::vector<ColorPair> colors;                  // the color of each character of the line
+                std::vector<uint8> bytes;                       // the line (and a few bytes after it) for the color callbacks
+                std::vector<UnicodeRun> unicode;                // unicode strings on the line (drawn as characters)
+                std::vector<GView::Utils::SearchMatch> similar; // occurrences of the current selection on the line
                 bool recomputeOffsets;
-                DrawLineInfo() : recomputeOffsets(true)
+                bool active;
+                DrawLineInfo() : recomputeOffsets(true), active(false)
                 {
                 }
             };
@@ -102,6 +131,9 @@ namespace View
                 uint32 xAddress;
                 uint32 xNumbers;
                 uint32 xText;
+                uint32 xEntropyMap;
+                uint32 entropyMapSize;  // 0 if the entropy map is hidden
+                bool entropyMapPending; // some rows of the map were drawn before their blocks were computed
             } Layout;
             struct
             {
@@ -116,6 +148,8 @@ namespace View
                 StringType type;
                 String asciiMaskRepr;
                 bool showAscii, showUnicode;
+                Reference<GView::Utils::StringsExtractorList> indexes; // background indexes of the strings (owned by the window)
+                Reference<GView::Utils::StringsExtractor> index;       // the one with the settings of this view (null until needed)
             } StringInfo;
             struct
             {
@@ -125,11 +159,20 @@ namespace View
             {
                 uint8 buffer[256];
                 uint32 size;
-                uint64 start, end;
                 bool highlight;
+                GView::Utils::SearchEngine engine; // searches the selected bytes on the visible lines
             } CurrentSelection;
+            struct
+            {
+                bool enabled;                          // the size of the file is polled in background
+                bool autoScroll;                       // the cursor moves to the new end of the object if it was on the last byte
+                uint64 size;                           // size of the object when it was checked last time (to notice a truncation)
+                uint64 polledSize;                     // size reported by 'watcher' when the object was updated last time
+                GView::Utils::FileSizeWatcher watcher; // running only while 'enabled' is set
+            } Follow;
 
             bool showTypeObjects;
+            SearchData search;
             CodePage codePage;
             Pointer<SettingsData> settings;
             Reference<GView::Object> obj;
@@ -139,6 +182,8 @@ namespace View
             String addressModesList;
             BufferColor bufColor;
             FixSizeString<29> name;
+            String paintBenchmark;                         // result of the last paint benchmark (empty if it was not run)
+            Reference<GView::Utils::ZonesList> matchZones; // rule matches (owned by the window), shown over the regular zones
 
             static Config config;
 
@@ -152,11 +197,15 @@ namespace View
 
             void UpdateCurrentSelection();
 
+            void UpdateLineColors(DrawLineInfo& dli);
             void PrepareDrawLineInfo(DrawLineInfo& dli);
             void WriteHeaders(Renderer& renderer);
             void WriteLineAddress(DrawLineInfo& dli);
             void WriteLineNumbersToChars(DrawLineInfo& dli);
+            void WriteEntropyMap(Renderer& renderer);
+            uint64 EntropyMapRowToOffset(uint32 row);
             void WriteLineTextToChars(DrawLineInfo& dli);
+            bool WriteLineToChars(DrawLineInfo& dli, uint32 row);
             void UpdateViewSizes();
             void MoveTo(uint64 offset, bool select);
             void MoveScrollTo(uint64 offset);
@@ -168,20 +217,35 @@ namespace View
 
             void UpdateStringInfo(uint64 offset);
             void ResetStringInfo();
+            void RestartStringsIndex();
             std::string_view GetAsciiMaskStringRepresentation();
             bool SetStringAsciiMask(string_view stringRepresentation);
 
+            const GView::Utils::Zone* OffsetToZone(uint64 offset);
+            const GView::Utils::Zone* OffsetToZone(uint64 offset, uint64& runEnd);
             ColorPair OffsetToColorZone(uint64 offset);
-            ColorPair OffsetToColor(uint64 offset);
+
+            void BenchmarkPaint();
 
             void AnalyzeMousePosition(int x, int y, MousePositionInfo& mpInfo);
 
             void OpenCurrentSelection();
+            void FindNext();
+            void FindPrevious();
+            void FindAll();
+            void ShowFindResults();
+            void MoveToMatch(uint64 offset, uint32 size);
+            void FollowObjectGrowth();
+            void SetFollowMode(bool enabled);
 
           public:
             Instance(const std::string_view& name, Reference<GView::Object> obj, Settings* settings);
 
+            void SetStringsIndex(Reference<GView::Utils::StringsExtractorList> indexes);
+            void SetMatchZones(Reference<GView::Utils::ZonesList> zones);
+
             virtual void Paint(Renderer& renderer) override;
+            virtual bool OnFrameUpdate() override;
             virtual void OnAfterResize(int newWidth, int newHeight) override;
             virtual bool OnKeyEvent(AppCUI::Input::Key keyCode, char16 characterCode) override;
             virtual bool OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar) override;
@@ -254,6 +318,39 @@ namespace View
                 return resultedPos;
             }
         };
+        class FindDialog : public Window
+        {
+            Reference<SearchData> search;
+            Reference<TextField> txPattern;
+            Reference<ComboBox> cbType;
+            Reference<CheckBox> cbMatchCase;
+
+            void UpdateMatchCase();
+            void Validate(bool findAll);
+
+          public:
+            FindDialog(Reference<SearchData> search);
+
+            virtual bool OnEvent(Reference<Control>, Event eventType, int ID) override;
+        };
+        class FindResultsDialog : public Window
+        {
+            Reference<SearchData> search;
+            Reference<ListView> lst;
+            size_t selectedResult;
+
+            void Validate();
+
+          public:
+            FindResultsDialog(
+                  Reference<SearchData> search, Reference<SettingsData> settings, Reference<GView::Object> obj, uint64 currentPos);
+
+            virtual bool OnEvent(Reference<Control>, Event eventType, int ID) override;
+            inline size_t GetSelectedResult() const
+            {
+                return selectedResult;
+            }
+        };
     } // namespace BufferViewer
 } // namespace View
 
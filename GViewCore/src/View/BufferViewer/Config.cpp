@@ -11,12 +11,25 @@ void Config::Update(IniSection sect)
     sect.UpdateValue("Key.GoToEntryPoint", Key::F7, true);
     sect.UpdateValue("Key.ChangeSelectionType", Key::F9, true);
     sect.UpdateValue("Key.ShowHideStrings", Key::F4 | Key::Alt, true);
+    sect.UpdateValue("Key.FindNext", Key::F8, true);
+    sect.UpdateValue("Key.FindPrevious", Key::F8 | Key::Shift, true);
+    sect.UpdateValue("Key.ShowFindResults", Key::F8 | Key::Alt, true);
+    sect.UpdateValue("Key.Follow", Key::F12, true);
 }
 
 void Config::Initialize()
 {
-    this->Colors.Ascii   = ColorPair{ Color::Red, Color::DarkBlue };
-    this->Colors.Unicode = ColorPair{ Color::Yellow, Color::DarkBlue };
+    this->Colors.Ascii       = ColorPair{ Color::Red, Color::DarkBlue };
+    this->Colors.Unicode     = ColorPair{ Color::Yellow, Color::DarkBlue };
+    this->Colors.SearchMatch = ColorPair{ Color::Black, Color::Yellow };
+
+    this->Colors.EntropyMap[(uint32) GView::Utils::EntropyMap::BlockType::NotComputed] = Color::Silver;
+    this->Colors.EntropyMap[(uint32) GView::Utils::EntropyMap::BlockType::Zero]        = Color::Gray;
+    this->Colors.EntropyMap[(uint32) GView::Utils::EntropyMap::BlockType::Text]        = Color::Green;
+    this->Colors.EntropyMap[(uint32) GView::Utils::EntropyMap::BlockType::Binary]      = Color::Aqua;
+    this->Colors.EntropyMap[(uint32) GView::Utils::EntropyMap::BlockType::Packed]      = Color::Red;
+    this->Colors.EntropyMapBack                                                        = Color::Black;
+    this->Colors.EntropyMapView                                                        = Color::DarkBlue;
 
     auto ini = AppCUI::Application::GetAppSettings();
     if (ini)
@@ -28,6 +41,10 @@ void Config::Initialize()
         this->Keys.GoToEntryPoint        = sect.GetValue("Key.GoToEntryPoint").ToKey(Key::F7);
         this->Keys.ChangeSelectionType   = sect.GetValue("Key.ChangeSelectionType").ToKey(Key::F9);
         this->Keys.ShowHideStrings       = sect.GetValue("Key.ShowHideStrings").ToKey(Key::Alt | Key::F3);
+        this->Keys.FindNext              = sect.GetValue("Key.FindNext").ToKey(Key::F8);
+        this->Keys.FindPrevious          = sect.GetValue("Key.FindPrevious").ToKey(Key::Shift | Key::F8);
+        this->Keys.ShowFindResults       = sect.GetValue("Key.ShowFindResults").ToKey(Key::Alt | Key::F8);
+        this->Keys.Follow                = sect.GetValue("Key.Follow").ToKey(Key::F12);
     }
     else
     {
@@ -37,6 +54,10 @@ void Config::Initialize()
         this->Keys.GoToEntryPoint        = Key::F7;
         this->Keys.ChangeSelectionType   = Key::F9;
         this->Keys.ShowHideStrings       = Key::Alt | Key::F3;
+        this->Keys.FindNext              = Key::F8;
+        this->Keys.FindPrevious          = Key::Shift | Key::F8;
+        this->Keys.ShowFindResults       = Key::Alt | Key::F8;
+        this->Keys.Follow                = Key::F12;
     }
 
     this->Loaded = true;
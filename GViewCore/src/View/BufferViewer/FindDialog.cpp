@@ -0,0 +1,190 @@
+#include "BufferViewer.hpp"
+
+using namespace GView::View::BufferViewer;
+using namespace GView::Utils::CharacterEncoding;
+using namespace AppCUI::Input;
+
+constexpr int32 BTN_ID_OK       = 1;
+constexpr int32 BTN_ID_CANCEL   = 2;
+constexpr int32 BTN_ID_FIND_ALL = 3;
+
+constexpr std::string_view FIND_TYPES =
+      "Hex (separate patterns with |),Text (ASCII),Text (UTF-8),Text (UTF-16LE),Text (UTF-16BE),Text (any encoding),Regular expression";
+constexpr uint32 FIND_TYPE_HEX           = 0;
+constexpr uint32 FIND_TYPE_ASCII         = 1;
+constexpr uint32 FIND_TYPE_UTF8          = 2;
+constexpr uint32 FIND_TYPE_UTF16LE       = 3;
+constexpr uint32 FIND_TYPE_UTF16BE       = 4;
+constexpr uint32 FIND_TYPE_ALL_ENCODINGS = 5;
+constexpr uint32 FIND_TYPE_REGEX         = 6;
+
+SearchData::SearchData()
+{
+    this->typeIndex = FIND_TYPE_ASCII;
+    this->matchCase = false;
+    this->findAll   = false;
+    this->searcher  = nullptr;
+}
+
+FindDialog::FindDialog(Reference<SearchData> _search) : Window("Find", "d:c,w:70,h:12", WindowFlags::ProcessReturn), search(_search)
+{
+    Factory::Label::Create(this, "&Pattern", "x:1,y:1,w:8");
+    Factory::Label::Create(this, "&Type", "x:1,y:3,w:8");
+    txPattern   = Factory::TextField::Create(this, std::u16string_view(search->text), "x:10,y:1,w:56");
+    cbType      = Factory::ComboBox::Create(this, "x:10,y:3,w:56", FIND_TYPES);
+    cbMatchCase = Factory::CheckBox::Create(this, "&Match case", "x:10,y:5,w:30");
+    txPattern->SetHotKey('P');
+    cbType->SetHotKey('T');
+    cbType->SetCurentItemIndex(search->typeIndex);
+    cbMatchCase->SetChecked(search->matchCase);
+    UpdateMatchCase();
+
+    Factory::Button::Create(this, "&Find", "l:13,b:0,w:13", BTN_ID_OK);
+    Factory::Button::Create(this, "Find &all", "l:28,b:0,w:13", BTN_ID_FIND_ALL);
+    Factory::Button::Create(this, "&Cancel", "l:43,b:0,w:13", BTN_ID_CANCEL);
+
+    txPattern->SetFocus();
+}
+void FindDialog::UpdateMatchCase()
+{
+    cbMatchCase->SetEnabled(cbType->GetCurrentItemIndex() != FIND_TYPE_HEX);
+}
+void FindDialog::Validate(bool findAll)
+{
+    LocalUnicodeStringBuilder<256> text;
+    if ((text.Set(txPattern->GetText()) == false) || (text.Len() == 0))
+    {
+        Dialogs::MessageBox::ShowError("Error", "Please write a pattern to search for !");
+        txPattern->SetFocus();
+        return;
+    }
+
+    GView::Utils::SearchEngine engine;
+    GView::Utils::RegexEngine regex;
+    const auto type       = cbType->GetCurrentItemIndex();
+    const auto ignoreCase = !cbMatchCase->IsChecked();
+    if (type == FIND_TYPE_REGEX)
+    {
+        // the expression is matched against bytes => non ASCII characters are searched as their UTF-8 sequence
+        std::string pattern;
+        LocalString<256> error;
+        EncodedCharacter ec;
+        for (auto ch : text.ToStringView())
+        {
+            const auto bytes = ec.Encode(ch, Encoding::UTF8);
+            pattern.append((const char*) bytes.GetData(), bytes.GetLength());
+        }
+        if (regex.Compile(pattern, ignoreCase, error) == false)
+        {
+            Dialogs::MessageBox::ShowError("Error", error);
+            txPattern->SetFocus();
+            return;
+        }
+    }
+    else if (type == FIND_TYPE_HEX)
+    {
+        // several patterns can be searched at once: "4D 5A ?? 00 | 50 4B 03 04"
+        LocalString<256> hex;
+        LocalString<256> error;
+        if (hex.Set(txPattern->GetText()) == false)
+        {
+            Dialogs::MessageBox::ShowError("Error", "Invalid hex pattern (expecting ascii characters) !");
+            txPattern->SetFocus();
+            return;
+        }
+        std::string_view patterns = hex.ToStringView();
+        while (!patterns.empty())
+        {
+            const auto next = patterns.find('|');
+            if (engine.AddHexPattern(patterns.substr(0, next)) == false)
+            {
+                Dialogs::MessageBox::ShowError(
+                      "Error",
+                      error.Format(
+                            "Invalid hex pattern (expecting up to %u bytes written as hex pairs or ?? for any byte, like `4D 5A ?? 00`) !",
+                            GView::Utils::SearchEngine::MAX_PATTERN_SIZE));
+                txPattern->SetFocus();
+                return;
+            }
+            patterns = next == std::string_view::npos ? std::string_view() : patterns.substr(next + 1);
+        }
+    }
+    else
+    {
+        bool result;
+        switch (type)
+        {
+        case FIND_TYPE_ASCII:
+            result = engine.AddTextPattern(text.ToStringView(), Encoding::Ascii, ignoreCase);
+            break;
+        case FIND_TYPE_UTF8:
+            result = engine.AddTextPattern(text.ToStringView(), Encoding::UTF8, ignoreCase);
+            break;
+        case FIND_TYPE_UTF16LE:
+            result = engine.AddTextPattern(text.ToStringView(), Encoding::Unicode16LE, ignoreCase);
+            break;
+        case FIND_TYPE_UTF16BE:
+            result = engine.AddTextPattern(text.ToStringView(), Encoding::Unicode16BE, ignoreCase);
+            break;
+        case FIND_TYPE_ALL_ENCODINGS:
+        default:
+            result = engine.AddTextPattern(text.ToStringView(), Encoding::UTF8, ignoreCase) &&
+                     engine.AddTextPattern(text.ToStringView(), Encoding::Unicode16LE, ignoreCase) &&
+                     engine.AddTextPattern(text.ToStringView(), Encoding::Unicode16BE, ignoreCase);
+            break;
+        }
+        if (result == false)
+        {
+            Dialogs::MessageBox::ShowError("Error", "The text can not be searched with the selected encoding (or it is too long) !");
+            txPattern->SetFocus();
+            return;
+        }
+    }
+
+    // all good
+    search->text      = text.ToStringView();
+    search->typeIndex = type;
+    search->matchCase = !ignoreCase;
+    search->findAll   = findAll;
+    search->engine    = std::move(engine);
+    search->regex     = std::move(regex);
+    if (type == FIND_TYPE_REGEX)
+        search->searcher = &search->regex;
+    else
+        search->searcher = &search->engine;
+    Exit(Dialogs::Result::Ok);
+}
+
+bool FindDialog::OnEvent(Reference<Control> control, Event eventType, int ID)
+{
+    if (eventType == Event::ButtonClicked)
+    {
+        switch (ID)
+        {
+        case BTN_ID_CANCEL:
+            Exit(Dialogs::Result::Cancel);
+            return true;
+        case BTN_ID_OK:
+            Validate(false);
+            return true;
+        case BTN_ID_FIND_ALL:
+            Validate(true);
+            return true;
+        }
+    }
+
+    switch (eventType)
+    {
+    case Event::ComboBoxSelectedItemChanged:
+        UpdateMatchCase();
+        return true;
+    case Event::WindowAccept:
+        Validate(false);
+        return true;
+    case Event::WindowClose:
+        Exit(Dialogs::Result::Cancel);
+        return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,111 @@
+#include "BufferViewer.hpp"
+
+using namespace GView::View::BufferViewer;
+using namespace AppCUI::Input;
+
+constexpr int32 BTN_ID_OK                = 1;
+constexpr int32 BTN_ID_CANCEL            = 2;
+constexpr uint64 NO_RESULT               = 0xFFFFFFFFFFFFFFFFULL;
+constexpr size_t MAX_LISTED_RESULTS      = 10000; // the index may have millions of matches => only the ones around the cursor are listed
+constexpr uint32 CONTEXT_BYTES           = 8;     // bytes shown before and after a match
+constexpr uint32 MAX_SHOWN_MATCHED_BYTES = 16;
+
+FindResultsDialog::FindResultsDialog(
+      Reference<SearchData> _search, Reference<SettingsData> settings, Reference<GView::Object> obj, uint64 currentPos)
+    : Window("Find results", "d:c,w:100,h:24", WindowFlags::ProcessReturn), search(_search)
+{
+    LocalString<128> tmp;
+    LocalString<512> bytes;
+    NumericFormatter n;
+    this->selectedResult = NO_RESULT;
+
+    const auto& results = search->results;
+    const auto count    = results.GetCount();
+    const auto current  = std::min<>(results.LowerBound(currentPos), count > 0 ? count - 1 : 0);
+    const auto first    = current > MAX_LISTED_RESULTS / 2 ? current - MAX_LISTED_RESULTS / 2 : 0;
+    const auto last     = std::min<>(first + MAX_LISTED_RESULTS, count);
+    if (last - first < count)
+        tmp.Format("%llu matches (showing %llu to %llu, around the cursor)", (uint64) count, (uint64) first + 1, (uint64) last);
+    else
+        tmp.Format("%llu matches", (uint64) count);
+    Factory::Label::Create(this, tmp, "l:1,t:0,r:1,h:1");
+
+    lst = Factory::ListView::Create(
+          this, "l:1,t:1,r:1,b:3", { "n:Offset,a:r,w:18", "n:Size,a:r,w:6", "n:Zone,a:l,w:20", "n:Bytes,a:l,w:200" }, ListViewFlags::None);
+    for (auto idx = first; idx < last; idx++)
+    {
+        const auto offset = results.GetOffset(idx);
+        const auto size   = results.GetSize(idx);
+        auto item         = lst->AddItem(n.ToString(offset, { NumericFormatFlags::HexPrefix, 16 }));
+        item.SetText(1, tmp.Format("%u", size));
+        if (settings.IsValid())
+        {
+            const auto* z = settings->zList.OffsetToZone(offset);
+            if (z)
+                item.SetText(2, z->name);
+        }
+        // a few bytes around the match: 00 00 [4D 5A 90] 00 03
+        const auto start = offset > CONTEXT_BYTES ? offset - CONTEXT_BYTES : 0;
+        const auto shown = std::min<>(size, MAX_SHOWN_MATCHED_BYTES);
+        const auto buf   = obj->GetData().Get(start, (uint32) (offset - start) + shown + CONTEXT_BYTES, false);
+        bytes.Clear();
+        for (uint32 tr = 0; tr < (uint32) buf.GetLength(); tr++)
+        {
+            const auto pos = start + tr;
+            if (pos == offset)
+                bytes.AddChar('[');
+            bytes.AddFormat("%02X", buf[tr]);
+            if (pos + 1 == offset + shown)
+            {
+                if (shown < size)
+                    bytes.Add(" ...");
+                bytes.AddChar(']');
+            }
+            bytes.AddChar(' ');
+        }
+        item.SetText(3, bytes);
+        item.SetData((uint64) idx);
+        if (idx == current)
+            item.SetType(ListViewItem::Type::Highlighted);
+    }
+
+    Factory::Button::Create(this, "&Go to", "l:34,b:0,w:13", BTN_ID_OK);
+    Factory::Button::Create(this, "&Cancel", "l:49,b:0,w:13", BTN_ID_CANCEL);
+    lst->SetFocus();
+}
+
+void FindResultsDialog::Validate()
+{
+    const auto idx = lst->GetCurrentItem().GetData(NO_RESULT);
+    if (idx == NO_RESULT)
+        return;
+    this->selectedResult = (size_t) idx;
+    Exit(Dialogs::Result::Ok);
+}
+
+bool FindResultsDialog::OnEvent(Reference<Control> control, Event eventType, int ID)
+{
+    switch (eventType)
+    {
+    case Event::ButtonClicked:
+        switch (ID)
+        {
+        case BTN_ID_CANCEL:
+            Exit(Dialogs::Result::Cancel);
+            return true;
+        case BTN_ID_OK:
+            Validate();
+            return true;
+        }
+        break;
+    case Event::ListViewItemPressed:
+    case Event::WindowAccept:
+        Validate();
+        return true;
+    case Event::WindowClose:
+        Exit(Dialogs::Result::Cancel);
+        return true;
+    }
+
+    return false;
+}
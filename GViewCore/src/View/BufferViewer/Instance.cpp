@@ -13,23 +13,6 @@ const std::string_view signed_dec_header = "  +0   +1   +2   +3   +4   +5   +6
 const std::string_view unsigned_dec_header =
       " +0  +1  +2  +3  +4  +5  +6  +7  +8  +9 +10 +11 +12 +13 +14 +15 +16 +17 +18 +19 +20 +21 +22 +23 +24 +25 +26 +27 +28 +29 +30 +31 ";
 
-bool DefaultAsciiMask[256] = {
-    false, false, false, false, false, false, false, false, false, true,  false, false, false, false, false, false, false, false, false,
-    false, false, false, false, false, false, false, false, false, false, false, false, false, true,  true,  true,  true,  true,  true,
-    true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,
-    true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,
-    true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,
-    true,  false, true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,
-    true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  true,  false, false, false, false, false, false,
-    false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false,
-    false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false,
-    false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false,
-    false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false,
-    false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false,
-    false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false,
-    false, false, false, false, false, false, false, false, false
-};
-
 constexpr int BUFFERVIEW_CMD_CHANGECOL         = 0xBF00;
 constexpr int BUFFERVIEW_CMD_CHANGEBASE        = 0xBF01;
 constexpr int BUFFERVIEW_CMD_CHANGEADDRESSMODE = 0xBF02;
@@ -37,6 +20,18 @@ constexpr int BUFFERVIEW_CMD_GOTOEP            = 0xBF03;
 constexpr int BUFFERVIEW_CMD_CHANGECODEPAGE    = 0xBF04;
 constexpr int BUFFERVIEW_CMD_CHANGESELECTION   = 0xBF05;
 constexpr int BUFFERVIEW_CMD_HIDESTRINGS       = 0xBF06;
+constexpr int BUFFERVIEW_CMD_FINDNEXT          = 0xBF07;
+constexpr int BUFFERVIEW_CMD_FINDPREVIOUS      = 0xBF08;
+constexpr int BUFFERVIEW_CMD_SHOWFINDRESULTS   = 0xBF09;
+constexpr int BUFFERVIEW_CMD_FOLLOW            = 0xBF0A;
+
+constexpr size_t MAX_FIND_ALL_RESULTS    = 0x1000000;
+constexpr uint32 COLOR_CALLBACK_SIZE    = 16;  // bytes sent to the plugin color callback
+constexpr uint32 PAINT_BENCHMARK_FRAMES = 200; // frames drawn by the paint benchmark
+
+constexpr uint32 ENTROPY_MAP_SIZE    = 2;      // a separator and the map column
+constexpr uint64 ENTROPY_MAP_SAMPLES = 16;     // blocks checked for every row of the map
+constexpr char16 NOT_COMPUTED_GLYPH  = 0x00B7; // a row whose blocks were not computed yet
 
 Config Instance::config;
 
@@ -57,20 +52,25 @@ Instance::Instance(const std::string_view& _name, Reference<GView::Object> _obj,
     this->Layout.xNumbers            = 0;
     this->Layout.xAddress            = 0;
     this->Layout.xText               = 0;
+    this->Layout.xEntropyMap         = 0;
+    this->Layout.entropyMapSize      = 0; // the map (and its background workers) is shown on request
+    this->Layout.entropyMapPending   = false;
     this->Cursor.currentPos          = 0;
     this->Cursor.startView           = 0;
-    this->StringInfo.minCount        = 4;
+    this->StringInfo.minCount        = GView::Utils::StringsExtractor::DEFAULT_MIN_COUNT;
     this->StringInfo.showAscii       = true;
     this->StringInfo.showUnicode     = true;
     this->Cursor.base                = 16;
     this->currentAdrressMode         = 0;
     this->CurrentSelection.size      = 0;
-    this->CurrentSelection.start     = GView::Utils::INVALID_OFFSET;
-    this->CurrentSelection.end       = GView::Utils::INVALID_OFFSET;
     this->CurrentSelection.highlight = true;
     this->codePage                   = CodePageID::DOS_437;
+    this->Follow.enabled             = false;
+    this->Follow.autoScroll          = true;
+    this->Follow.size                = _obj->GetData().GetSize();
+    this->Follow.polledSize          = GView::Utils::INVALID_OFFSET;
 
-    memcpy(this->StringInfo.AsciiMask, DefaultAsciiMask, 256);
+    memcpy(this->StringInfo.AsciiMask, GView::Utils::StringsExtractor::DefaultAsciiMask, 256);
 
     this->bufColor.Reset();
     this->ResetStringInfo();
@@ -111,9 +111,8 @@ void Instance::OpenCurrentSelection()
 }
 void Instance::UpdateCurrentSelection()
 {
-    this->CurrentSelection.size  = 0;
-    this->CurrentSelection.start = GView::Utils::INVALID_OFFSET;
-    this->CurrentSelection.end   = GView::Utils::INVALID_OFFSET;
+    this->CurrentSelection.size = 0;
+    this->CurrentSelection.engine.Clear();
 
     if (this->selection.IsSingleSelectionEnabled())
     {
@@ -127,6 +126,7 @@ void Instance::UpdateCurrentSelection()
                 if (b.IsValid())
                 {
                     memcpy(this->CurrentSelection.buffer, b.begin(), b.GetLength());
+                    this->CurrentSelection.engine.AddBytesPattern(BufferView(this->CurrentSelection.buffer, this->CurrentSelection.size));
                 }
                 else
                 {
@@ -341,7 +341,160 @@ bool Instance::ShowGoToDialog()
 }
 bool Instance::ShowFindDialog()
 {
-    NOT_IMPLEMENTED(false);
+    FindDialog dlg(&this->search);
+    if (dlg.Show() == Dialogs::Result::Ok)
+    {
+        // highlighted matches belong to the previous search
+        this->search.results.Clear();
+        if (this->search.findAll)
+            FindAll();
+        else
+            FindNext();
+    }
+    return true;
+}
+void Instance::MoveToMatch(uint64 offset, uint32 size)
+{
+    MoveTo(offset, false);
+    Select(offset, size);
+}
+void Instance::FindNext()
+{
+    // with a "find all" index the next match is one binary search away
+    const auto& results = this->search.results;
+    if (results.GetCount() > 0)
+    {
+        auto idx = results.LowerBound(this->Cursor.currentPos + 1);
+        if (idx >= results.GetCount())
+            idx = 0; // wrap around
+        MoveToMatch(results.GetOffset(idx), results.GetSize(idx));
+        return;
+    }
+
+    const auto size = this->obj->GetData().GetSize();
+    if ((size == 0) || (this->search.searcher.IsValid() == false))
+        return;
+
+    // search from the cursor (the current match is skipped) to the end and then from the beginning up to the cursor
+    const auto start = std::min<>(this->Cursor.currentPos + 1, size);
+    GView::Utils::SearchMatch result{ GView::Utils::INVALID_OFFSET, 0, 0 };
+    auto onMatch = [&result](const GView::Utils::SearchMatch& m)
+    {
+        result = m;
+        return false; // first match is enough
+    };
+    if (this->search.searcher->SearchWithProgress(this->obj, start, size - start, "Searching ...", onMatch) == false)
+        return;
+    if ((result.offset == GView::Utils::INVALID_OFFSET) && (start > 0))
+    {
+        const auto end = std::min<>(start + this->search.searcher->GetMaxMatchSize() - 1, size);
+        if (this->search.searcher->SearchWithProgress(this->obj, 0, end, "Searching from the beginning ...", onMatch) == false)
+            return;
+    }
+    if (result.offset == GView::Utils::INVALID_OFFSET)
+    {
+        Dialogs::MessageBox::ShowNotification("Find", "Pattern not found !");
+        return;
+    }
+    MoveToMatch(result.offset, result.size);
+}
+void Instance::FindPrevious()
+{
+    const auto& results = this->search.results;
+    if (results.GetCount() > 0)
+    {
+        auto idx = results.LowerBound(this->Cursor.currentPos);
+        idx      = idx > 0 ? idx - 1 : results.GetCount() - 1; // wrap around
+        MoveToMatch(results.GetOffset(idx), results.GetSize(idx));
+        return;
+    }
+
+    const auto size = this->obj->GetData().GetSize();
+    if ((size == 0) || (this->search.searcher.IsValid() == false))
+        return;
+
+    // without an index the data can only be searched forward => the last match before the cursor is kept
+    const auto cursor = std::min<>(this->Cursor.currentPos, size);
+    GView::Utils::SearchMatch result{ GView::Utils::INVALID_OFFSET, 0, 0 };
+    auto onMatch = [&result, cursor](const GView::Utils::SearchMatch& m)
+    {
+        if (m.offset >= cursor)
+            return false;
+        result = m;
+        return true;
+    };
+    const auto end = std::min<>(cursor + this->search.searcher->GetMaxMatchSize() - 1, size);
+    if (this->search.searcher->SearchWithProgress(this->obj, 0, end, "Searching ...", onMatch) == false)
+        return;
+    if ((result.offset == GView::Utils::INVALID_OFFSET) && (cursor < size))
+    {
+        // wrap around => the last match of the object
+        auto onLastMatch = [&result](const GView::Utils::SearchMatch& m)
+        {
+            result = m;
+            return true;
+        };
+        if (this->search.searcher->SearchWithProgress(this->obj, cursor, size - cursor, "Searching from the end ...", onLastMatch) == false)
+            return;
+    }
+    if (result.offset == GView::Utils::INVALID_OFFSET)
+    {
+        Dialogs::MessageBox::ShowNotification("Find", "Pattern not found !");
+        return;
+    }
+    MoveToMatch(result.offset, result.size);
+}
+void Instance::FindAll()
+{
+    auto& results   = this->search.results;
+    const auto size = this->obj->GetData().GetSize();
+    results.Clear();
+    if ((size == 0) || (this->search.searcher.IsValid() == false))
+        return;
+
+    auto truncated = false;
+    auto onMatch   = [&results, &truncated](const GView::Utils::SearchMatch& m)
+    {
+        if (results.GetCount() >= MAX_FIND_ALL_RESULTS)
+        {
+            truncated = true;
+            return false;
+        }
+        results.Add(m.offset, m.size);
+        return true;
+    };
+    if (this->search.searcher->SearchWithProgress(this->obj, 0, size, "Searching all matches ...", onMatch) == false)
+    {
+        results.Clear();
+        return;
+    }
+    if (results.GetCount() == 0)
+    {
+        Dialogs::MessageBox::ShowNotification("Find", "Pattern not found !");
+        return;
+    }
+    if (truncated)
+    {
+        LocalString<128> tmp;
+        Dialogs::MessageBox::ShowNotification(
+              "Find", tmp.Format("Too many matches: only the first %llu were kept !", (uint64) MAX_FIND_ALL_RESULTS));
+    }
+    ShowFindResults();
+}
+void Instance::ShowFindResults()
+{
+    const auto& results = this->search.results;
+    if (results.GetCount() == 0)
+    {
+        Dialogs::MessageBox::ShowNotification("Find results", "There are no results (use `Find all` from the Find dialog) !");
+        return;
+    }
+    FindResultsDialog dlg(&this->search, this->settings.get(), this->obj, this->Cursor.currentPos);
+    if (dlg.Show() == Dialogs::Result::Ok)
+    {
+        const auto idx = dlg.GetSelectedResult();
+        MoveToMatch(results.GetOffset(idx), results.GetSize(idx));
+    }
 }
 bool Instance::ShowCopyDialog()
 {
@@ -355,8 +508,50 @@ void Instance::ResetStringInfo()
     StringInfo.middle = GView::Utils::INVALID_OFFSET;
     StringInfo.type   = StringType::None;
 }
+void Instance::SetStringsIndex(Reference<GView::Utils::StringsExtractorList> indexes)
+{
+    this->StringInfo.indexes = indexes;
+    RestartStringsIndex();
+}
+void Instance::SetMatchZones(Reference<GView::Utils::ZonesList> zones)
+{
+    this->matchZones = zones;
+}
+void Instance::RestartStringsIndex()
+{
+    // the index with the new settings is requested (and, if no other view uses them, started) when it is needed
+    ResetStringInfo();
+    StringInfo.index = nullptr;
+}
 void Instance::UpdateStringInfo(uint64 offset)
 {
+    if ((StringInfo.index.IsValid() == false) && (StringInfo.indexes.IsValid()))
+        StringInfo.index = StringInfo.indexes->Get(StringInfo.AsciiMask, StringInfo.minCount);
+    // the part of the object that was already indexed (in background) does not need to be scanned again
+    if ((StringInfo.index.IsValid()) && (StringInfo.index->HasSettings(StringInfo.AsciiMask, StringInfo.minCount)))
+    {
+        GView::Utils::StringRange str;
+        uint64 gapEnd;
+        if (StringInfo.index->Find(offset, str, gapEnd))
+        {
+            if ((str.size > 0) && (str.unicode ? StringInfo.showUnicode : StringInfo.showAscii))
+            {
+                StringInfo.start  = str.offset;
+                StringInfo.end    = str.offset + str.size;
+                StringInfo.middle = str.unicode ? str.offset + str.size / 2 : GView::Utils::INVALID_OFFSET;
+                StringInfo.type   = str.unicode ? StringType::Unicode : StringType::Ascii;
+            }
+            else
+            {
+                StringInfo.start  = offset;
+                StringInfo.end    = str.size > 0 ? str.offset + str.size : gapEnd;
+                StringInfo.middle = GView::Utils::INVALID_OFFSET;
+                StringInfo.type   = StringType::None;
+            }
+            return;
+        }
+    }
+
     auto buf = this->obj->GetData().Get(offset, 1024, false);
     if (!buf.IsValid())
     {
@@ -479,76 +674,40 @@ bool Instance::SetStringAsciiMask(string_view stringRepresentation)
     return false;
 }
 
-ColorPair Instance::OffsetToColorZone(uint64 offset)
-{
-    auto* z = this->settings->zList.OffsetToZone(offset);
-    if (z == nullptr)
-        return Cfg.Text.Inactive;
-    else
-        return z->color;
-}
-ColorPair Instance::OffsetToColor(uint64 offset)
+const GView::Utils::Zone* Instance::OffsetToZone(uint64 offset)
 {
-    // current selection
-    if ((this->CurrentSelection.size) && (this->CurrentSelection.highlight))
-    {
-        if ((offset >= this->CurrentSelection.start) && (offset < this->CurrentSelection.end))
-            return Cfg.Selection.SimilarText;
-
-        auto b = this->obj->GetData().Get(offset, this->CurrentSelection.size, true);
-        if (b.IsValid())
-        {
-            if (b[0] == this->CurrentSelection.buffer[0])
-            {
-                if (memcmp(b.begin(), this->CurrentSelection.buffer, this->CurrentSelection.size) == 0)
-                {
-                    this->CurrentSelection.start = offset;
-                    this->CurrentSelection.end   = offset + this->CurrentSelection.size;
-                    return Cfg.Selection.SimilarText;
-                }
-            }
-        }
-    }
-    // color
-    if ((showTypeObjects) && (settings) && (settings->positionToColorCallback))
+    if ((this->matchZones.IsValid()) && (this->matchZones->GetCount() > 0))
     {
-        if ((offset >= bufColor.start) && (offset <= bufColor.end))
-            return bufColor.color;
-        if (settings->positionToColorCallback->GetColorForBuffer(offset, this->obj->GetData().Get(offset, 16, false), bufColor))
-            return bufColor.color;
-        // no color provided for the specific buffer --> check strings and zones
+        auto* z = this->matchZones->OffsetToZone(offset);
+        if (z)
+            return z;
     }
-    // check strings
-    if (this->StringInfo.showAscii || this->StringInfo.showUnicode)
+    return this->settings->zList.OffsetToZone(offset);
+}
+const GView::Utils::Zone* Instance::OffsetToZone(uint64 offset, uint64& runEnd)
+{
+    // 'runEnd' is the last offset (after 'offset') that has the same zone
+    uint64 matchEnd = GView::Utils::INVALID_OFFSET;
+    if ((this->matchZones.IsValid()) && (this->matchZones->GetCount() > 0))
     {
-        if ((offset >= StringInfo.start) && (offset < StringInfo.end))
-        {
-            switch (StringInfo.type)
-            {
-            case StringType::Ascii:
-                return config.Colors.Ascii;
-            case StringType::Unicode:
-                return config.Colors.Unicode;
-            }
-        }
-        else
+        auto* z = this->matchZones->OffsetToZone(offset, matchEnd);
+        if (z)
         {
-            UpdateStringInfo(offset);
-            if ((offset >= StringInfo.start) && (offset < StringInfo.end))
-            {
-                switch (StringInfo.type)
-                {
-                case StringType::Ascii:
-                    return config.Colors.Ascii;
-                case StringType::Unicode:
-                    return config.Colors.Unicode;
-                }
-            }
+            runEnd = matchEnd;
+            return z;
         }
     }
-
-    // not a string --> check the zone
-    return OffsetToColorZone(offset);
+    auto* z = this->settings->zList.OffsetToZone(offset, runEnd);
+    runEnd  = std::min<>(runEnd, matchEnd); // a rule match may start before the end of this zone
+    return z;
+}
+ColorPair Instance::OffsetToColorZone(uint64 offset)
+{
+    auto* z = OffsetToZone(offset);
+    if (z == nullptr)
+        return Cfg.Text.Inactive;
+    else
+        return z->color;
 }
 
 void Instance::UpdateViewSizes()
@@ -576,7 +735,7 @@ void Instance::UpdateViewSizes()
     {
         this->Layout.xText = sz;
         // full screen --> ascii only
-        auto width = (uint32) this->GetWidth();
+        auto width = (uint32) this->GetWidth() - std::min<uint32>(this->Layout.entropyMapSize, this->GetWidth());
         if (sz + 1 < width)
             this->Layout.charactersPerLine = width - (1 + sz);
         else
@@ -587,6 +746,8 @@ void Instance::UpdateViewSizes()
         this->Layout.xText             = sz + this->Layout.nrCols * (characterFormatModeSize[(uint32) this->Layout.charFormatMode] + 1) + 3;
         this->Layout.charactersPerLine = this->Layout.nrCols;
     }
+    // the entropy map is always the last column
+    this->Layout.xEntropyMap = this->GetWidth() > 0 ? this->GetWidth() - 1 : 0;
     // compute visible rows
     this->Layout.visibleRows = this->GetHeight();
     if (this->Layout.visibleRows > 0)
@@ -594,6 +755,114 @@ void Instance::UpdateViewSizes()
     if (this->Layout.visibleRows == 0)
         this->Layout.visibleRows = 1;
 }
+void Instance::UpdateLineColors(DrawLineInfo& dli)
+{
+    // the colors are computed as spans (a plugin buffer, a string or a zone usually covers many bytes of the line)
+    // and the search matches, the similar bytes and the selections are painted over them
+    dli.unicode.clear();
+    if (dli.textSize == 0)
+        return;
+    auto* col = dli.colors.data();
+    if (!dli.active)
+    {
+        std::fill(col, col + dli.textSize, Cfg.Text.Inactive);
+        return;
+    }
+    // the line is copied => the callbacks below may read other parts of the object (and move the cache)
+    const auto buf = this->obj->GetData().Get(dli.offset, dli.textSize + COLOR_CALLBACK_SIZE, false);
+    dli.bytes.assign(buf.GetData(), buf.GetData() + buf.GetLength());
+
+    const auto lineStart   = dli.offset;
+    const auto lineEnd     = lineStart + std::min<uint64>(dli.textSize, dli.bytes.size());
+    const auto usePlugin   = (showTypeObjects) && (settings) && (settings->positionToColorCallback);
+    const auto showStrings = this->StringInfo.showAscii || this->StringInfo.showUnicode;
+    auto fill              = [col, lineStart, lineEnd](uint64 start, uint64 end, ColorPair color)
+    {
+        // 'end' is exclusive
+        start = std::max<>(start, lineStart);
+        end   = std::min<>(end, lineEnd);
+        if (start < end)
+            std::fill(col + (start - lineStart), col + (end - lineStart), color);
+    };
+
+    for (auto ofs = lineStart; ofs < lineEnd;)
+    {
+        auto spanEnd = lineEnd;
+        if (usePlugin)
+        {
+            auto hasColor = (ofs >= bufColor.start) && (ofs <= bufColor.end);
+            if (!hasColor)
+            {
+                const auto pos  = (size_t) (ofs - lineStart);
+                const auto size = std::min<size_t>(COLOR_CALLBACK_SIZE, dli.bytes.size() - pos);
+                const auto view = BufferView(dli.bytes.data() + pos, size);
+                hasColor        = settings->positionToColorCallback->GetColorForBuffer(ofs, view, bufColor);
+            }
+            if (hasColor)
+            {
+                const auto end = bufColor.end >= lineEnd ? lineEnd : std::max<>(bufColor.end, ofs) + 1;
+                fill(ofs, end, bufColor.color);
+                ofs = end;
+                continue;
+            }
+            // no color for this byte --> the callback has to be asked again for the next one (no span can be longer)
+            spanEnd = ofs + 1;
+        }
+        if (showStrings)
+        {
+            if ((ofs < StringInfo.start) || (ofs >= StringInfo.end))
+                UpdateStringInfo(ofs);
+            if ((ofs >= StringInfo.start) && (ofs < StringInfo.end))
+            {
+                switch (StringInfo.type)
+                {
+                case StringType::Ascii:
+                    spanEnd = std::min<>(spanEnd, StringInfo.end);
+                    fill(ofs, spanEnd, config.Colors.Ascii);
+                    ofs = spanEnd;
+                    continue;
+                case StringType::Unicode:
+                    spanEnd = std::min<>(spanEnd, StringInfo.end);
+                    fill(ofs, spanEnd, config.Colors.Unicode);
+                    if ((dli.unicode.empty()) || (dli.unicode.back().start != StringInfo.start))
+                        dli.unicode.push_back({ StringInfo.start, StringInfo.end, StringInfo.middle });
+                    ofs = spanEnd;
+                    continue;
+                }
+                // not a string until StringInfo.end
+                spanEnd = std::min<>(spanEnd, StringInfo.end);
+            }
+        }
+        // not a string --> the zone
+        uint64 zoneEnd;
+        auto* z = OffsetToZone(ofs, zoneEnd);
+        if (zoneEnd < spanEnd)
+            spanEnd = std::max<>(zoneEnd, ofs) + 1;
+        fill(ofs, spanEnd, z ? z->color : Cfg.Text.Inactive);
+        ofs = spanEnd;
+    }
+
+    const auto& results = this->search.results;
+    for (auto idx = results.FirstOverlapping(lineStart); (idx < results.GetCount()) && (results.GetOffset(idx) < lineEnd); idx++)
+        fill(results.GetOffset(idx), results.GetOffset(idx) + results.GetSize(idx), config.Colors.SearchMatch);
+
+    if ((this->CurrentSelection.size) && (this->CurrentSelection.highlight))
+    {
+        // an occurrence may start on the previous line or end on the next one
+        const auto extra = (uint64) this->CurrentSelection.size - 1;
+        const auto start = lineStart > extra ? lineStart - extra : 0;
+        const auto data  = this->obj->GetData().Get(start, (uint32) (lineEnd + extra - start), false);
+        dli.similar.clear();
+        this->CurrentSelection.engine.SearchBuffer(data, start, 0, dli.similar);
+        for (const auto& m : dli.similar)
+            fill(m.offset, m.offset + m.size, Cfg.Selection.SimilarText);
+    }
+
+    const auto selCount = this->selection.IsSingleSelectionEnabled() ? 1U : this->selection.GetCount();
+    for (uint32 idx = 0; idx < selCount; idx++)
+        if (this->selection.HasSelection(idx))
+            fill(this->selection.GetSelectionStart(idx), this->selection.GetSelectionEnd(idx) + 1, Cfg.Selection.Editor);
+}
 void Instance::PrepareDrawLineInfo(DrawLineInfo& dli)
 {
     if (dli.recomputeOffsets)
@@ -612,7 +881,7 @@ void Instance::PrepareDrawLineInfo(DrawLineInfo& dli)
         if (this->Layout.nrCols == 0)
         {
             // full screen --> ascii only
-            auto width      = (uint32) this->GetWidth();
+            auto width      = (uint32) this->GetWidth() - std::min<uint32>(this->Layout.entropyMapSize, this->GetWidth());
             dli.numbersSize = 0;
             if (dli.offsetAndNameSize + 1 < width)
                 dli.textSize = width - (1 + dli.offsetAndNameSize);
@@ -627,8 +896,11 @@ void Instance::PrepareDrawLineInfo(DrawLineInfo& dli)
         }
         // make sure that we have enough buffer
         this->chars.Resize(dli.offsetAndNameSize + dli.textSize + dli.numbersSize);
+        dli.colors.resize(dli.textSize);
         dli.recomputeOffsets = false;
     }
+    // colors are computed before reading the line (they may need the bytes around it)
+    UpdateLineColors(dli);
     auto buf          = this->obj->GetData().Get(dli.offset, dli.textSize, false);
     dli.start         = buf.GetData();
     dli.end           = buf.GetData() + buf.GetLength();
@@ -695,7 +967,7 @@ void Instance::WriteLineAddress(DrawLineInfo& dli)
     {
         c = OffsetToColorZone(dli.offset);
     }
-    z = this->settings->zList.OffsetToZone(dli.offset);
+    z = OffsetToZone(dli.offset);
 
     if (this->Layout.lineNameSize > 0)
     {
@@ -782,74 +1054,53 @@ void Instance::WriteLineAddress(DrawLineInfo& dli)
 }
 void Instance::WriteLineTextToChars(DrawLineInfo& dli)
 {
-    auto cp    = Cfg.Text.Inactive;
-    bool activ = this->HasFocus();
+    const auto startCh  = dli.chText;
+    const auto ofsStart = dli.offset;
+    const auto* col     = dli.colors.data();
 
-    if (activ)
+    while (dli.start < dli.end)
     {
-        const auto startCh  = dli.chText;
-        const auto ofsStart = dli.offset;
-        while (dli.start < dli.end)
+        dli.chText->Code  = codePage[*dli.start];
+        dli.chText->Color = *col;
+        dli.chText++;
+        dli.start++;
+        col++;
+    }
+    dli.offset += dli.chText - startCh;
+
+    // unicode strings are drawn as characters (first half) followed by spaces (second half)
+    for (const auto& u : dli.unicode)
+    {
+        const auto end = std::min<>(u.end, dli.offset);
+        for (auto ofs = std::max<>(u.start, ofsStart); ofs < end; ofs++)
         {
-            cp = OffsetToColor(dli.offset);
-            if (selection.Contains(dli.offset))
-                cp = Cfg.Selection.Editor;
-            if (StringInfo.type == StringType::Unicode)
-            {
-                if (dli.offset > StringInfo.middle)
-                    dli.chText->Code = ' ';
-                else
-                    dli.chText->Code = codePage[obj->GetData().GetFromCache(((dli.offset - StringInfo.start) << 1) + StringInfo.start)];
-            }
+            if (ofs > u.middle)
+                startCh[ofs - ofsStart].Code = ' ';
             else
-            {
-                dli.chText->Code = codePage[*dli.start];
-            }
-            dli.chText->Color = cp;
-            dli.chText++;
-            dli.start++;
-            dli.offset++;
-        }
-        if ((this->Cursor.currentPos >= ofsStart) && (this->Cursor.currentPos < dli.offset))
-        {
-            (startCh + (this->Cursor.currentPos - ofsStart))->Color = Cfg.Cursor.Normal;
+                startCh[ofs - ofsStart].Code = codePage[obj->GetData().GetFromCache(((ofs - u.start) << 1) + u.start)];
         }
     }
-    else
+    if ((dli.active) && (this->Cursor.currentPos >= ofsStart) && (this->Cursor.currentPos < dli.offset))
     {
-        while (dli.start < dli.end)
-        {
-            dli.chText->Code  = codePage[*dli.start];
-            dli.chText->Color = Cfg.Text.Inactive;
-            dli.chText++;
-            dli.start++;
-        }
+        (startCh + (this->Cursor.currentPos - ofsStart))->Color = Cfg.Cursor.Normal;
     }
     this->chars.Resize((uint32) (dli.chText - this->chars.GetBuffer()));
 }
 void Instance::WriteLineNumbersToChars(DrawLineInfo& dli)
 {
-    auto c     = dli.chNumbers;
-    auto cp    = Cfg.Text.Inactive;
-    bool activ = this->HasFocus();
-    auto ut    = (uint8) 0;
-    auto sps   = dli.chText;
-    auto start = dli.offset;
-    auto end   = start + (dli.end - dli.start);
+    auto c       = dli.chNumbers;
+    auto cp      = Cfg.Text.Inactive;
+    auto ut      = (uint8) 0;
+    auto sps     = dli.chText;
+    auto start   = dli.offset;
+    auto end     = start + (dli.end - dli.start);
+    auto* col    = dli.colors.data();
+    auto colSize = characterFormatModeSize[(uint32) this->Layout.charFormatMode] + 1;
 
     while (dli.start < dli.end)
     {
-        if (activ)
-        {
-            cp = OffsetToColor(dli.offset);
-
-            if (selection.Contains(dli.offset))
-            {
-                cp = Cfg.Selection.Editor;
-                if (c > this->chars.GetBuffer())
-                    (c - 1)->Color = cp;
-            }
-        }
+        cp = *col;
+        col++;
         switch (this->Layout.charFormatMode)
         {
         case CharacterFormatMode::Hex:
@@ -976,25 +1227,7 @@ void Instance::WriteLineNumbersToChars(DrawLineInfo& dli)
         c->Color = cp;
         c++;
 
-        if (activ)
-        {
-            if (StringInfo.type == StringType::Unicode)
-            {
-                if (dli.offset > StringInfo.middle)
-                    dli.chText->Code = ' ';
-                else
-                    dli.chText->Code = codePage[obj->GetData().GetFromCache(((dli.offset - StringInfo.start) << 1) + StringInfo.start)];
-            }
-            else
-            {
-                dli.chText->Code = codePage[*dli.start];
-            }
-        }
-        else
-        {
-            dli.chText->Code = codePage[*dli.start];
-        }
-
+        dli.chText->Code  = codePage[*dli.start];
         dli.chText->Color = cp;
         dli.chText++;
         dli.start++;
@@ -1007,13 +1240,43 @@ void Instance::WriteLineNumbersToChars(DrawLineInfo& dli)
         c->Color = Cfg.Text.Inactive;
         c++;
     }
-    if ((activ) && (this->Cursor.currentPos >= start) && (this->Cursor.currentPos < end))
+    // unicode strings are drawn as characters (first half) followed by spaces (second half)
+    for (const auto& u : dli.unicode)
+    {
+        const auto e = std::min<>(u.end, end);
+        for (auto ofs = std::max<>(u.start, start); ofs < e; ofs++)
+        {
+            if (ofs > u.middle)
+                sps[ofs - start].Code = ' ';
+            else
+                sps[ofs - start].Code = codePage[obj->GetData().GetFromCache(((ofs - u.start) << 1) + u.start)];
+        }
+    }
+    if (!dli.active)
+    {
+        this->chars.Resize((uint32) (dli.chText - this->chars.GetBuffer()));
+        return;
+    }
+    // the separator before a selection has the color of the selection
+    const auto selCount = this->selection.IsSingleSelectionEnabled() ? 1U : this->selection.GetCount();
+    for (uint32 idx = 0; idx < selCount; idx++)
+    {
+        if (!this->selection.HasSelection(idx))
+            continue;
+        const auto selStart = std::max<>(this->selection.GetSelectionStart(idx), start);
+        if ((selStart < end) && (this->selection.GetSelectionEnd(idx) >= selStart))
+        {
+            c = dli.chNumbers + (selStart - start) * colSize;
+            if (c > this->chars.GetBuffer())
+                (c - 1)->Color = Cfg.Selection.Editor;
+        }
+    }
+    if ((this->Cursor.currentPos >= start) && (this->Cursor.currentPos < end))
     {
-        const auto reprsz = characterFormatModeSize[static_cast<uint32>(this->Layout.charFormatMode)] + 1;
-        c                 = dli.chNumbers + (this->Cursor.currentPos - start) * reprsz;
-        const auto st     = this->chars.GetBuffer();
-        const auto c_e    = std::min<>(c + reprsz, sps);
-        c                 = std::max<>(c - 1, st);
+        c              = dli.chNumbers + (this->Cursor.currentPos - start) * colSize;
+        const auto st  = this->chars.GetBuffer();
+        const auto c_e = std::min<>(c + colSize, sps);
+        c              = std::max<>(c - 1, st);
         while (c < c_e)
         {
             c->Color = Cfg.Cursor.Normal;
@@ -1025,24 +1288,159 @@ void Instance::WriteLineNumbersToChars(DrawLineInfo& dli)
     }
     this->chars.Resize((uint32) (dli.chText - this->chars.GetBuffer()));
 }
+uint64 Instance::EntropyMapRowToOffset(uint32 row)
+{
+    // the rows of the map cover the whole object (aligned to the entropy blocks)
+    const auto size = this->obj->GetData().GetSize();
+    const auto ofs  = size * row / this->Layout.visibleRows;
+    return ofs - ofs % GView::Utils::EntropyMap::BLOCK_SIZE;
+}
+void Instance::WriteEntropyMap(Renderer& renderer)
+{
+    using BlockType                = GView::Utils::EntropyMap::BlockType;
+    const auto size                = this->obj->GetData().GetSize();
+    this->Layout.entropyMapPending = false;
+    if ((this->Layout.entropyMapSize == 0) || (size == 0))
+        return;
+
+    // background workers start from the visible bytes ; paint only reads what they have already computed (a row without any
+    // computed block is drawn with a dot) so that it never waits for the object to be read
+    auto& map             = this->obj->GetEntropyMap();
+    const auto viewStart  = this->Cursor.startView;
+    const auto viewEnd    = viewStart + (uint64) this->Layout.charactersPerLine * this->Layout.visibleRows;
+    const auto x          = (int) this->Layout.xEntropyMap;
+    const char16 glyphs[] = { 0x2591, 0x2592, 0x2593, 0x2588 }; // light shade ... full block
+    map.Start(viewStart);
+
+    for (uint32 tr = 0; tr < this->Layout.visibleRows; tr++)
+    {
+        const auto start = EntropyMapRowToOffset(tr);
+        const auto end   = std::max<>(tr + 1 < this->Layout.visibleRows ? EntropyMapRowToOffset(tr + 1) : size, start + 1);
+        const auto step  = std::max<>((end - start) / ENTROPY_MAP_SAMPLES, (uint64) GView::Utils::EntropyMap::BLOCK_SIZE);
+        double entropy = 0.0, value;
+        uint32 count = 0, samples = 0;
+        auto type    = BlockType::NotComputed;
+        BlockType blockType;
+        for (auto ofs = start; ofs < end; ofs += step, samples++)
+        {
+            if (map.TryGet(ofs, value, blockType))
+            {
+                entropy += value;
+                type = std::max<>(type, blockType); // the most "interesting" type of the row is shown
+                count++;
+            }
+        }
+        const auto back  = (start < viewEnd) && (end > viewStart) ? config.Colors.EntropyMapView : config.Colors.EntropyMapBack;
+        const auto glyph = count == 0 ? NOT_COMPUTED_GLYPH : glyphs[std::min<uint32>((uint32) (entropy / count / 2), 3)];
+        this->Layout.entropyMapPending |= (count < samples);
+        renderer.FillHorizontalLine(x, tr + 1, x, glyph, ColorPair{ config.Colors.EntropyMap[(uint32) type], back });
+    }
+}
+bool Instance::WriteLineToChars(DrawLineInfo& dli, uint32 row)
+{
+    dli.offset = ((uint64) this->Layout.charactersPerLine) * row + this->Cursor.startView;
+    if (dli.offset >= this->obj->GetData().GetSize())
+        return false;
+    PrepareDrawLineInfo(dli);
+    WriteLineAddress(dli);
+    if (this->Layout.nrCols == 0)
+        WriteLineTextToChars(dli);
+    else
+        WriteLineNumbersToChars(dli);
+    return true;
+}
+void Instance::FollowObjectGrowth()
+{
+    // the object is shared with the other views => one of them could have already noticed that its size changed
+    // the file itself is checked again only if the size polled in background changed
+    auto& data        = this->obj->GetData();
+    const auto polled = this->Follow.watcher.GetSize();
+    if ((this->Follow.enabled) && (polled != this->Follow.polledSize))
+    {
+        this->Follow.polledSize = polled;
+        data.UpdateSize();
+    }
+    const auto newSize = data.GetSize();
+    if (newSize < this->Follow.size)
+    {
+        // the file was truncated => the cursor (and the view) can not stay past its new end
+        this->Follow.size = newSize;
+        if (newSize == 0)
+            this->Cursor.currentPos = this->Cursor.startView = 0;
+        else if (this->Cursor.currentPos >= newSize)
+            MoveTo(newSize - 1, false);
+        return;
+    }
+    if ((!this->Follow.enabled) || (newSize == this->Follow.size))
+    {
+        this->Follow.size = newSize; // another view could have noticed that the object grew
+        return;
+    }
+    const auto wasOnLastByte = this->Cursor.currentPos + 1 >= this->Follow.size;
+    this->Follow.size        = newSize;
+    if ((this->Follow.autoScroll) && (wasOnLastByte))
+        MoveTo(newSize - 1, false);
+}
+void Instance::SetFollowMode(bool enabled)
+{
+    this->Follow.enabled = enabled;
+    this->Follow.watcher.Stop();
+    if (!enabled)
+        return;
+    this->Follow.watcher.Start(this->obj->GetPath());
+    this->Follow.polledSize = this->Follow.watcher.GetSize();
+    this->obj->GetData().UpdateSize();
+    this->Follow.size = this->obj->GetData().GetSize();
+    if ((this->Follow.autoScroll) && (this->Follow.size > 0))
+        MoveTo(this->Follow.size - 1, false);
+}
+bool Instance::OnFrameUpdate()
+{
+    // an idle view is repainted as soon as the background poll notices that the followed file changed its size (or while the
+    // workers fill in the blocks of the entropy map that were not computed when it was painted)
+    if ((this->Follow.enabled) && (this->Follow.watcher.GetSize() != this->Follow.polledSize))
+    {
+        FollowObjectGrowth();
+        return true;
+    }
+    return this->Layout.entropyMapPending;
+}
 void Instance::Paint(Renderer& renderer)
 {
+    FollowObjectGrowth();
     renderer.Clear();
     DrawLineInfo dli;
+    dli.active = this->HasFocus();
     WriteHeaders(renderer);
     for (uint32 tr = 0; tr < this->Layout.visibleRows; tr++)
     {
-        dli.offset = ((uint64) this->Layout.charactersPerLine) * tr + this->Cursor.startView;
-        if (dli.offset >= this->obj->GetData().GetSize())
+        if (!WriteLineToChars(dli, tr))
             break;
-        PrepareDrawLineInfo(dli);
-        WriteLineAddress(dli);
-        if (this->Layout.nrCols == 0)
-            WriteLineTextToChars(dli);
-        else
-            WriteLineNumbersToChars(dli);
         renderer.WriteSingleLineCharacterBuffer(0, tr + 1, chars, false);
     }
+    WriteEntropyMap(renderer);
+}
+void Instance::BenchmarkPaint()
+{
+    // the lines of the view are built (but not sent to the screen) several times ; every frame starts
+    // without the cached string and plugin color information (as if the view was just scrolled)
+    DrawLineInfo dli;
+    uint32 rows      = 0;
+    dli.active       = true;
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32 frame = 0; frame < PAINT_BENCHMARK_FRAMES; frame++)
+    {
+        ResetStringInfo();
+        bufColor.Reset();
+        for (rows = 0; rows < this->Layout.visibleRows; rows++)
+            if (!WriteLineToChars(dli, rows))
+                break;
+    }
+    const auto total = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    ResetStringInfo();
+    bufColor.Reset();
+    this->paintBenchmark.SetFormat("%.3f ms/frame (%dx%u characters)", total / PAINT_BENCHMARK_FRAMES, this->GetWidth(), rows);
+    Dialogs::MessageBox::ShowNotification("Paint benchmark", this->paintBenchmark.ToStringView());
 }
 void Instance::OnAfterResize(int width, int height)
 {
@@ -1132,10 +1530,21 @@ bool Instance::OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar)
             commandBar.SetCommand(config.Keys.ShowHideStrings, "Strings:OFF", BUFFERVIEW_CMD_HIDESTRINGS);
     }
 
+    // Find
+    if (this->search.searcher.IsValid())
+    {
+        commandBar.SetCommand(config.Keys.FindNext, "FindNext", BUFFERVIEW_CMD_FINDNEXT);
+        commandBar.SetCommand(config.Keys.FindPrevious, "FindPrev", BUFFERVIEW_CMD_FINDPREVIOUS);
+    }
+    if (this->search.results.GetCount() > 0)
+        commandBar.SetCommand(config.Keys.ShowFindResults, "Results", BUFFERVIEW_CMD_SHOWFINDRESULTS);
+    commandBar.SetCommand(config.Keys.Follow, this->Follow.enabled ? "Follow:ON" : "Follow:OFF", BUFFERVIEW_CMD_FOLLOW);
+
     return false;
 }
 bool Instance::OnKeyEvent(AppCUI::Input::Key keyCode, char16 charCode)
 {
+    FollowObjectGrowth();
     bool select = ((keyCode & Key::Shift) != Key::None);
     if (select)
         keyCode = static_cast<Key>((uint32) keyCode - (uint32) Key::Shift);
@@ -1358,6 +1767,18 @@ bool Instance::OnEvent(Reference<Control>, Event eventType, int ID)
             this->StringInfo.showAscii = this->StringInfo.showUnicode = true;
         }
         return true;
+    case BUFFERVIEW_CMD_FINDNEXT:
+        FindNext();
+        return true;
+    case BUFFERVIEW_CMD_FINDPREVIOUS:
+        FindPrevious();
+        return true;
+    case BUFFERVIEW_CMD_SHOWFINDRESULTS:
+        ShowFindResults();
+        return true;
+    case BUFFERVIEW_CMD_FOLLOW:
+        SetFollowMode(!this->Follow.enabled);
+        return true;
     }
     return false;
 }
@@ -1428,7 +1849,7 @@ int Instance::PrintCursorPosInfo(int x, int y, uint32 width, bool addSeparator,
 }
 int Instance::PrintCursorZone(int x, int y, uint32 width, Renderer& r)
 {
-    auto zone = this->settings->zList.OffsetToZone(this->Cursor.currentPos);
+    auto zone = OffsetToZone(this->Cursor.currentPos);
     if (zone)
     {
         r.WriteSingleLineText(x, y, width, zone->name, this->CursorColors.Highlighted);
@@ -1721,6 +2142,14 @@ void Instance::AnalyzeMousePosition(int x, int y, MousePositionInfo& mpInfo)
         return;
     }
     auto xPoz = (uint32) x;
+    if ((Layout.entropyMapSize > 0) && (xPoz == Layout.xEntropyMap) && ((uint32) yPoz < Layout.visibleRows))
+    {
+        mpInfo.location     = MouseLocation::OnEntropyMap;
+        mpInfo.bufferOffset = std::min<>(EntropyMapRowToOffset(yPoz), this->obj->GetData().GetSize());
+        if (mpInfo.bufferOffset >= this->obj->GetData().GetSize())
+            mpInfo.location = MouseLocation::Outside;
+        return;
+    }
     if ((xPoz >= Layout.xText) && (xPoz < Layout.xText + Layout.charactersPerLine))
     {
         mpInfo.location     = MouseLocation::OnView;
@@ -1754,6 +2183,9 @@ void Instance::OnMousePressed(int x, int y, AppCUI::Input::MouseButton button)
     {
         MoveTo(mpInfo.bufferOffset, false);
     }
+    // a click on the entropy map jumps to the part of the object represented by that row
+    if (mpInfo.location == MouseLocation::OnEntropyMap)
+        MoveTo(mpInfo.bufferOffset, false);
 }
 void Instance::OnMouseReleased(int x, int y, AppCUI::Input::MouseButton button)
 {
@@ -1768,6 +2200,11 @@ bool Instance::OnMouseDrag(int x, int y, AppCUI::Input::MouseButton button)
         MoveTo(mpInfo.bufferOffset, true);
         return true;
     }
+    if (mpInfo.location == MouseLocation::OnEntropyMap)
+    {
+        MoveTo(mpInfo.bufferOffset, false);
+        return true;
+    }
     return false;
 }
 bool Instance::OnMouseEnter()
@@ -1819,6 +2256,7 @@ enum class PropertyID : uint32
     ZoneNameWidth,
     CodePage,
     AddressType,
+    ShowEntropyMap,
     // selection
     HighlightSelection,
     SelectionType,
@@ -1837,7 +2275,13 @@ enum class PropertyID : uint32
     ChangeAddressMode,
     GoToEntryPoint,
     ChangeSelectionType,
-    ShowHideStrings
+    ShowHideStrings,
+    FollowKey,
+    // follow
+    Follow,
+    FollowAutoScroll,
+    // performance
+    PaintBenchmark
 };
 #define BT(t) static_cast<uint32>(t)
 
@@ -1881,6 +2325,9 @@ bool Instance::GetPropertyValue(uint32 id, PropertyValue& value)
     case PropertyID::ShowTypeObject:
         value = this->showTypeObjects;
         return true;
+    case PropertyID::ShowEntropyMap:
+        value = this->Layout.entropyMapSize > 0;
+        return true;
     case PropertyID::HighlightSelection:
         value = this->CurrentSelection.highlight;
         return true;
@@ -1920,9 +2367,24 @@ bool Instance::GetPropertyValue(uint32 id, PropertyValue& value)
     case PropertyID::ShowHideStrings:
         value = config.Keys.ShowHideStrings;
         return true;
+    case PropertyID::FollowKey:
+        value = config.Keys.Follow;
+        return true;
+    case PropertyID::Follow:
+        value = this->Follow.enabled;
+        return true;
+    case PropertyID::FollowAutoScroll:
+        value = this->Follow.autoScroll;
+        return true;
     case PropertyID::AddressType:
         value = this->currentAdrressMode;
         return true;
+    case PropertyID::PaintBenchmark:
+        if (this->paintBenchmark.Len() > 0)
+            value = this->paintBenchmark.ToStringView();
+        else
+            value = std::string_view("Not measured");
+        return true;
     }
     return false;
 }
@@ -1958,7 +2420,7 @@ bool Instance::SetPropertyValue(uint32 id, const PropertyValue& value, String& e
             return false;
         }
         this->StringInfo.minCount = tmpValue;
-        this->ResetStringInfo();
+        this->RestartStringsIndex();
         return true;
     case PropertyID::ShowAddress:
         this->Layout.lineAddressSize = std::get<bool>(value) ? 8 : 0;
@@ -1988,12 +2450,21 @@ bool Instance::SetPropertyValue(uint32 id, const PropertyValue& value, String& e
         return true;
     case PropertyID::StringCharacterSet:
         if (this->SetStringAsciiMask(std::get<string_view>(value)))
+        {
+            this->RestartStringsIndex();
             return true;
+        }
         error = "Invalid format (use \\x<hex> values, ascii characters or '-' sign for intervals (ex: A-Z)";
         return false;
     case PropertyID::ShowTypeObject:
         this->showTypeObjects = std::get<bool>(value);
         return true;
+    case PropertyID::ShowEntropyMap:
+        this->Layout.entropyMapSize = std::get<bool>(value) ? ENTROPY_MAP_SIZE : 0;
+        if (this->Layout.entropyMapSize == 0)
+            this->obj->GetEntropyMap().Stop(); // restarted by the next paint of a view that shows the map
+        UpdateViewSizes();
+        return true;
     case PropertyID::HighlightSelection:
         this->CurrentSelection.highlight = std::get<bool>(value);
         return true;
@@ -2021,6 +2492,15 @@ bool Instance::SetPropertyValue(uint32 id, const PropertyValue& value, String& e
     case PropertyID::ShowHideStrings:
         config.Keys.ShowHideStrings = std::get<AppCUI::Input::Key>(value);
         return true;
+    case PropertyID::FollowKey:
+        config.Keys.Follow = std::get<AppCUI::Input::Key>(value);
+        return true;
+    case PropertyID::Follow:
+        SetFollowMode(std::get<bool>(value));
+        return true;
+    case PropertyID::FollowAutoScroll:
+        this->Follow.autoScroll = std::get<bool>(value);
+        return true;
     case PropertyID::AddressType:
         this->currentAdrressMode = (uint32) std::get<uint64>(value);
         return true;
@@ -2038,6 +2518,8 @@ void Instance::SetCustomPropertyValue(uint32 propertyID)
         SelectionEditor dlg(&this->selection, idx, this->settings.get(), this->obj->GetData().GetSize());
         dlg.Show();
     }
+    if (propID == PropertyID::PaintBenchmark)
+        BenchmarkPaint();
 }
 bool Instance::IsPropertyValueReadOnly(uint32 propertyID)
 {
@@ -2076,6 +2558,7 @@ const vector<Property> Instance::GetPropertiesList()
         { BT(PropertyID::CursorOffset), "Display", "Cursor offset", PropertyType::Boolean, "Dec,Hex" },
         { BT(PropertyID::DataFormat), "Display", "Data format", PropertyType::List, "Hex=0,Oct=1,Signed decimal=2,Unsigned decimal=3" },
         { BT(PropertyID::ShowTypeObject), "Display", "Show Type specific patterns", PropertyType::Boolean },
+        { BT(PropertyID::ShowEntropyMap), "Display", "Show entropy map", PropertyType::Boolean },
         { BT(PropertyID::CodePage), "Display", "CodePage", PropertyType::List, CodePage::GetPropertyListValues() },
 
         // Address
@@ -2105,7 +2588,15 @@ const vector<Property> Instance::GetPropertiesList()
         { BT(PropertyID::ChangeColumnsView), "Shortcuts", "Change nr. of columns", PropertyType::Key },
         { BT(PropertyID::GoToEntryPoint), "Shortcuts", "Go To Entry Point", PropertyType::Key },
         { BT(PropertyID::ChangeSelectionType), "Shortcuts", "Change selection type", PropertyType::Key },
-        { BT(PropertyID::ShowHideStrings), "Shortcuts", "Show/Hide strings", PropertyType::Key }
+        { BT(PropertyID::ShowHideStrings), "Shortcuts", "Show/Hide strings", PropertyType::Key },
+        { BT(PropertyID::FollowKey), "Shortcuts", "Follow mode", PropertyType::Key },
+
+        // Follow
+        { BT(PropertyID::Follow), "Follow", "Enabled", PropertyType::Boolean },
+        { BT(PropertyID::FollowAutoScroll), "Follow", "Auto scroll", PropertyType::Boolean },
+
+        // performance
+        { BT(PropertyID::PaintBenchmark), "Performance", "Paint benchmark", PropertyType::Custom }
     };
 }
 #undef BT
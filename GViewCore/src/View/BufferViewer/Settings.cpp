@@ -22,6 +22,11 @@ void Settings::AddZone(uint64 start, uint64 size, ColorPair col, std::string_vie
     if (size > 0)
         Members->zList.Add(start, start + size - 1, col, name);
 }
+void Settings::ReserveZones(uint32 count)
+{
+    auto* Members = (SettingsData*) (this->data);
+    Members->zList.Reserve(Members->zList.GetCount() + count);
+}
 
 void Settings::AddBookmark(uint8 bookmarkID, uint64 fileOffset)
 {
@@ -99,7 +99,26 @@ Instance::Instance(const std::string_view& _name, Reference<GView::Object> _obj,
         config.Initialize();
 
     // load the entire data into a file
-    auto buf                     = obj->GetData().GetEntireFile();
+    auto buf = obj->GetData().GetEntireFile();
+    Buffer content;
+    if ((!buf.IsValid()) && (obj->GetData().GetSize() <= 0x80000000ULL))
+    {
+        // the file does not fit in the cache => gather it chunk by chunk
+        content.Resize((size_t) obj->GetData().GetSize());
+        auto p = content.GetData();
+        if (obj->GetData().ForEachChunk(
+                  0,
+                  obj->GetData().GetSize(),
+                  [&p](uint64, BufferView chunk)
+                  {
+                      memcpy(p, chunk.GetData(), chunk.GetLength());
+                      p += chunk.GetLength();
+                      return true;
+                  }))
+        {
+            buf = content;
+        }
+    }
     this->text                   = GView::Utils::CharacterEncoding::ConvertToUnicode16(buf);
     this->prettyFormat           = true;
     this->highlightSimilarTokens = true;
@@ -3,21 +3,37 @@
 using namespace GView::View::TextViewer;
 using namespace AppCUI::Input;
 
+constexpr uint32 DEFAULT_SPARSE_INDEX_MIN_LINES = 4000000; // about 64 MB of line index
+
 void Config::Update(IniSection sect)
 {
     sect.UpdateValue("Key.WrapMethod", Key::F2, true);
+    sect.UpdateValue("Key.Follow", Key::F12, true);
+    sect.UpdateValue("Key.FindNext", Key::F8, true);
+    sect.UpdateValue("Key.FindPrevious", Key::F8 | Key::Shift, true);
+    sect.UpdateValue("SparseIndexMinLines", DEFAULT_SPARSE_INDEX_MIN_LINES, true);
 }
 void Config::Initialize()
 {
+    this->Colors.SearchMatch = ColorPair{ Color::Black, Color::Yellow };
+
     auto ini = AppCUI::Application::GetAppSettings();
     if (ini)
     {
-        auto sect           = ini->GetSection("View.Text");
-        this->Keys.WordWrap = sect.GetValue("Key.WrapMethod").ToKey(Key::F2);
+        auto sect                 = ini->GetSection("View.Text");
+        this->Keys.WordWrap       = sect.GetValue("Key.WrapMethod").ToKey(Key::F2);
+        this->Keys.Follow         = sect.GetValue("Key.Follow").ToKey(Key::F12);
+        this->Keys.FindNext       = sect.GetValue("Key.FindNext").ToKey(Key::F8);
+        this->Keys.FindPrevious   = sect.GetValue("Key.FindPrevious").ToKey(Key::Shift | Key::F8);
+        this->SparseIndexMinLines = sect.GetValue("SparseIndexMinLines").ToUInt32(DEFAULT_SPARSE_INDEX_MIN_LINES);
     }
     else
     {
-        this->Keys.WordWrap = Key::F2;
+        this->Keys.WordWrap       = Key::F2;
+        this->Keys.Follow         = Key::F12;
+        this->Keys.FindNext       = Key::F8;
+        this->Keys.FindPrevious   = Key::Shift | Key::F8;
+        this->SparseIndexMinLines = DEFAULT_SPARSE_INDEX_MIN_LINES;
     }
 
     this->Loaded = true;
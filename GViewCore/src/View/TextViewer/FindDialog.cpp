@@ -0,0 +1,133 @@
+#include "TextViewer.hpp"
+
+using namespace GView::View::TextViewer;
+using namespace GView::Utils::CharacterEncoding;
+using namespace AppCUI::Input;
+
+constexpr int32 BTN_ID_OK       = 1;
+constexpr int32 BTN_ID_CANCEL   = 2;
+constexpr int32 BTN_ID_FIND_ALL = 3;
+
+SearchData::SearchData()
+{
+    this->useRegex    = false;
+    this->matchCase   = false;
+    this->findAll     = false;
+    this->searcher    = nullptr;
+    this->matchOffset = GView::Utils::INVALID_OFFSET;
+    this->matchSize   = 0;
+}
+
+FindDialog::FindDialog(Reference<SearchData> _search, Encoding _encoding)
+    : Window("Find", "d:c,w:70,h:12", WindowFlags::ProcessReturn), search(_search), encoding(_encoding)
+{
+    Factory::Label::Create(this, "&Pattern", "x:1,y:1,w:8");
+    txPattern   = Factory::TextField::Create(this, std::u16string_view(search->text), "x:10,y:1,w:56");
+    cbRegex     = Factory::CheckBox::Create(this, "&Regular expression", "x:10,y:3,w:30");
+    cbMatchCase = Factory::CheckBox::Create(this, "&Match case", "x:10,y:5,w:30");
+    txPattern->SetHotKey('P');
+    cbRegex->SetChecked(search->useRegex);
+    cbMatchCase->SetChecked(search->matchCase);
+
+    Factory::Button::Create(this, "&Find", "l:13,b:0,w:13", BTN_ID_OK);
+    Factory::Button::Create(this, "Find &all", "l:28,b:0,w:13", BTN_ID_FIND_ALL);
+    Factory::Button::Create(this, "&Cancel", "l:43,b:0,w:13", BTN_ID_CANCEL);
+
+    txPattern->SetFocus();
+}
+void FindDialog::Validate(bool findAll)
+{
+    LocalUnicodeStringBuilder<256> text;
+    if ((text.Set(txPattern->GetText()) == false) || (text.Len() == 0))
+    {
+        Dialogs::MessageBox::ShowError("Error", "Please write a pattern to search for !");
+        txPattern->SetFocus();
+        return;
+    }
+
+    GView::Utils::SearchEngine engine;
+    GView::Utils::RegexEngine regex;
+    const auto useRegex   = cbRegex->IsChecked();
+    const auto ignoreCase = !cbMatchCase->IsChecked();
+    if (useRegex)
+    {
+        // the expression is matched against bytes => only text with one byte per ASCII character can be searched
+        if ((encoding == Encoding::Unicode16LE) || (encoding == Encoding::Unicode16BE))
+        {
+            Dialogs::MessageBox::ShowError("Error", "Regular expressions can only be searched in ASCII or UTF-8 text !");
+            cbRegex->SetFocus();
+            return;
+        }
+        std::string pattern;
+        LocalString<256> error;
+        EncodedCharacter ec;
+        for (auto ch : text.ToStringView())
+        {
+            const auto bytes = ec.Encode(ch, Encoding::UTF8);
+            pattern.append((const char*) bytes.GetData(), bytes.GetLength());
+        }
+        if (regex.Compile(pattern, ignoreCase, error) == false)
+        {
+            Dialogs::MessageBox::ShowError("Error", error);
+            txPattern->SetFocus();
+            return;
+        }
+    }
+    else
+    {
+        // the text is searched with the encoding of the object
+        auto textEncoding = encoding;
+        if ((textEncoding != Encoding::Unicode16LE) && (textEncoding != Encoding::Unicode16BE) && (textEncoding != Encoding::Ascii))
+            textEncoding = Encoding::UTF8;
+        if (engine.AddTextPattern(text.ToStringView(), textEncoding, ignoreCase) == false)
+        {
+            Dialogs::MessageBox::ShowError("Error", "The text can not be searched with the encoding of this object (or it is too long) !");
+            txPattern->SetFocus();
+            return;
+        }
+    }
+
+    // all good
+    search->text      = text.ToStringView();
+    search->useRegex  = useRegex;
+    search->matchCase = !ignoreCase;
+    search->findAll   = findAll;
+    search->engine    = std::move(engine);
+    search->regex     = std::move(regex);
+    if (useRegex)
+        search->searcher = &search->regex;
+    else
+        search->searcher = &search->engine;
+    Exit(Dialogs::Result::Ok);
+}
+
+bool FindDialog::OnEvent(Reference<Control> control, Event eventType, int ID)
+{
+    if (eventType == Event::ButtonClicked)
+    {
+        switch (ID)
+        {
+        case BTN_ID_CANCEL:
+            Exit(Dialogs::Result::Cancel);
+            return true;
+        case BTN_ID_OK:
+            Validate(false);
+            return true;
+        case BTN_ID_FIND_ALL:
+            Validate(true);
+            return true;
+        }
+    }
+
+    switch (eventType)
+    {
+    case Event::WindowAccept:
+        Validate(false);
+        return true;
+    case Event::WindowClose:
+        Exit(Dialogs::Result::Cancel);
+        return true;
+    }
+
+    return false;
+}
@@ -7,15 +7,15 @@ constexpr int32 BTN_ID_OK        = 1;
 constexpr int32 BTN_ID_CANCEL    = 2;
 constexpr int32 RB_GROUP_ID      = 123;
 
-GoToDialog::GoToDialog(uint64 currentPos, uint64 sz, uint32 currentLine, uint32 _maxLines)
+GoToDialog::GoToDialog(uint64 currentPos, uint64 sz, uint64 currentLine, uint64 _maxLines)
     : Window("GoTo", "d:c,w:60,h:10", WindowFlags::ProcessReturn), maxSize(sz), maxLines(_maxLines)
 {
     LocalString<128> tmp;
     resultedPos = GView::Utils::INVALID_OFFSET;
     gotoLine    = true;
 
-    rbLineNumber = Factory::RadioBox::Create(this, tmp.Format("&Line (1..%u)", _maxLines), "x:1,y:1,w:38", RB_GROUP_ID);
-    txLineNumber = Factory::TextField::Create(this, tmp.Format("%u", currentLine), "x:40,y:1,w:16");
+    rbLineNumber = Factory::RadioBox::Create(this, tmp.Format("&Line (1..%llu)", _maxLines), "x:1,y:1,w:38", RB_GROUP_ID);
+    txLineNumber = Factory::TextField::Create(this, tmp.Format("%llu", currentLine), "x:40,y:1,w:16");
 
     rbFileOffset = Factory::RadioBox::Create(this, tmp.Format("&File offset (0..%llu)", sz), "x:1,y:3,w:38", RB_GROUP_ID);
     txFileOffset = Factory::TextField::Create(this, tmp.Format("%llu", currentPos), "x:40,y:3,w:16");
@@ -64,7 +64,7 @@ void GoToDialog::Validate()
     {
         if ((newPos > maxLines) || (newPos < 1))
         {
-            Dialogs::MessageBox::ShowError("Error", error.Format("Valid line number are between 1 and %u", maxLines));
+            Dialogs::MessageBox::ShowError("Error", error.Format("Valid line number are between 1 and %llu", maxLines));
             input->SetFocus();
             return;
         }
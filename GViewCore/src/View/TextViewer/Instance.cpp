@@ -6,8 +6,13 @@ using namespace AppCUI::Input;
 
 Config Instance::config;
 
-constexpr int32 CMD_ID_WORD_WRAP     = 0xBF00;
-constexpr uint32 INVALID_LINE_NUMBER = 0xFFFFFFFF;
+constexpr int32 CMD_ID_WORD_WRAP      = 0xBF00;
+constexpr int32 CMD_ID_FOLLOW         = 0xBF01;
+constexpr int32 CMD_ID_FIND_NEXT      = 0xBF02;
+constexpr int32 CMD_ID_FIND_PREVIOUS  = 0xBF03;
+constexpr uint64 INVALID_LINE_NUMBER  = 0xFFFFFFFFFFFFFFFFULL;
+constexpr size_t LINES_BATCH_SIZE     = 0x10000;   // lines published at once by the indexing thread
+constexpr size_t MAX_FIND_ALL_RESULTS = 0x1000000; // same limit as the one from the buffer view
 
 enum class BulletParserState : uint8
 {
@@ -198,30 +203,31 @@ uint8 GetCharGroup(char16 ch)
 class DataCharacterStream
 {
     GView::Utils::DataCache& dataCache;
-    std::vector<LineInfo>& lines;
+    LineIndex& lines;
     Reference<SettingsData> settings;
-    uint32 linesCount;
+    uint64 linesCount;
     uint32 charIndex;
-    uint32 currentLine;
+    uint64 currentLine;
 
-    bool ConvertLine(uint32 lineNo)
+    bool ConvertLine(uint64 lineNo)
     {
         CHECK(lineNo < linesCount, false, "");
-        auto buf = dataCache.Get(lines[lineNo].offset, lines[lineNo].size, false);
+        const auto li = lines.Get(lineNo);
+        auto buf      = dataCache.Get(li.offset, li.size, false);
         CHECK(tempLine.Create(buf, settings), false, "");
         currentLine = lineNo;
         return true;
     }
 
   public:
-    DataCharacterStream(std::vector<LineInfo>& li, Reference<SettingsData> _settings, GView::Utils::DataCache& cache)
+    DataCharacterStream(LineIndex& li, Reference<SettingsData> _settings, GView::Utils::DataCache& cache)
         : settings(_settings), dataCache(cache), lines(li)
     {
-        linesCount  = static_cast<uint32>(li.size());
+        linesCount  = li.GetCount();
         currentLine = 0;
         charIndex   = 0;
     }
-    bool Init(uint32 lineNo, uint32 chIndex)
+    bool Init(uint64 lineNo, uint32 chIndex)
     {
         CHECK(ConvertLine(lineNo), false, "");
         charIndex = chIndex;
@@ -258,7 +264,7 @@ class DataCharacterStream
         }
         return true;
     }
-    inline uint32 GetLineNumber() const
+    inline uint64 GetLineNumber() const
     {
         return this->currentLine;
     }
@@ -292,14 +298,32 @@ Instance::Instance(const std::string_view& _name, Reference<GView::Object> _obj,
 
     this->lineNumberWidth = 0;
     this->SubLines.entries.reserve(256); // reserve 256 sub-lines
-    this->SubLines.lineNo  = INVALID_LINE_NUMBER;
+    this->subLinesUseCounter = 0;
+    this->ResetSubLinesCache();
     this->ViewPort.scrollX = 0;
     this->ViewPort.Reset();
     this->mouseStatus = MouseStatus::None;
 
+    this->Indexer.pendingCount   = 0;
+    this->Indexer.indexedSize    = 0;
+    this->Indexer.stop           = false;
+    this->Indexer.completed      = false;
+    this->Indexer.merged         = false;
+    this->Indexer.estimatedCount = 0;
+    this->Indexer.pendingGoTo    = GView::Utils::INVALID_OFFSET;
+    this->Indexer.replaceLast    = false;
+    this->Follow.enabled         = false;
+    this->Follow.autoScroll      = true;
+    this->Follow.toEnd           = false;
+    this->Follow.polledSize      = GView::Utils::INVALID_OFFSET;
+
     this->settings->encoding = CharacterEncoding::AnalyzeBufferForEncoding(this->obj->GetData().Get(0, 4096, false), true, this->sizeOfBOM);
     this->MoveTo(0, 0, false);
 }
+Instance::~Instance()
+{
+    StopLineIndexing();
+}
 
 void Instance::OpenCurrentSelection()
 {
@@ -320,263 +344,481 @@ void Instance::OpenCurrentSelection()
 }
 void Instance::RecomputeLineIndexes()
 {
+    StopLineIndexing();
+
     // first --> simple estimation
     auto buf        = this->obj->GetData().Get(0, 4096, false);
     auto sz         = this->obj->GetData().GetSize();
-    auto csz        = this->obj->GetData().GetCacheSize() & 0xFFFFFFF0; // make sure that csz is odd
     auto crlf_count = (uint64) 1;
 
     for (auto ch : buf)
         if ((ch == '\n') || (ch == '\r'))
             crlf_count++;
 
-    auto estimated_count = ((crlf_count * sz) / buf.GetLength()) + 16;
-
-    this->lines.clear();
-    this->lines.reserve(estimated_count);
+    auto estimated_count = buf.GetLength() > 0 ? ((crlf_count * sz) / buf.GetLength()) + 16 : 16;
 
-    uint64 offset    = this->sizeOfBOM;
-    uint64 start     = this->sizeOfBOM;
-    uint32 charCount = 0;
-    char16 lastChar  = 0;
-
-    CharacterEncoding::ExpandedCharacter ch;
-
-    while (offset < sz)
+    this->lines.Reset(this->obj->GetData(), this->settings->encoding, config.SparseIndexMinLines, estimated_count);
+    ResetSubLinesCache();
+    this->Indexer.estimatedCount = estimated_count;
+    this->Indexer.pendingGoTo    = GView::Utils::INVALID_OFFSET;
+    this->Indexer.replaceLast    = false;
+    StartLineIndexing(this->sizeOfBOM, sz, 0);
+    UpdateLineIndexes();
+}
+void Instance::StartLineIndexing(uint64 start, uint64 end, uint64 firstLine)
+{
+    // indexes [start, end) ; 'start' is the offset of line 'firstLine'
+    this->Indexer.pending.clear();
+    this->Indexer.pendingCount = 0;
+    this->Indexer.indexedSize  = start;
+    this->Indexer.stop         = false;
+    this->Indexer.completed    = false;
+    this->Indexer.merged       = false;
+
+    auto reader = this->obj->CreateReader();
+    if (reader)
+    {
+        // the lines are indexed in background ; only the first ones (the ones from the view port) are waited for
+        this->Indexer.worker =
+              std::thread([this, start, end, firstLine, r = std::move(reader)]() { IndexLines(*r, start, end, firstLine); });
+        std::unique_lock<std::mutex> guard(this->Indexer.lock);
+        this->Indexer.published.wait(
+              guard, [this] { return (this->Indexer.completed) || (this->Indexer.pendingCount >= MAX_LINES_TO_VIEW); });
+    }
+    else
+    {
+        IndexLines(this->obj->GetData(), start, end, firstLine);
+    }
+}
+void Instance::IndexLines(GView::Utils::DataCache& cache, uint64 start, uint64 end, uint64 firstLine)
+{
+    // runs on the indexing thread => it only publishes lines into 'Indexer.pending' ('lines' belongs to the UI thread)
+    const auto sz         = std::min<uint64>(end, cache.GetSize());
+    const auto denseLimit = this->lines.GetDenseLimit();
+    uint64 covered        = start;                     // end of the last line that was added to the batch
+    uint64 count          = firstLine;                 // lines found so far
+    uint64 batchCount     = 0;                         // lines found since the last publish
+    auto batchSize        = (uint64) MAX_LINES_TO_VIEW; // the first batch is small => the view can be shown as soon as possible
+
+    std::vector<LineInfo> batch;
+    batch.reserve(LINES_BATCH_SIZE);
+    auto publish = [&](bool last)
     {
-        buf = this->obj->GetData().Get(offset, csz, false);
-        if (buf.Empty())
-            return;
-        // process the buffer
-        auto* p       = buf.begin();
-        auto* e       = buf.end();
-        auto* loopEnd = buf.end();
-        if (((offset + buf.GetLength()) < sz) && (buf.GetLength() > 16))
         {
-            // if this is a partial part of the file and it has more then 16 bytes, deduct 8 bytes to make sure that any possible conversion
-            // will be made
-            loopEnd -= 8;
+            std::lock_guard<std::mutex> guard(this->Indexer.lock);
+            this->Indexer.pending.insert(this->Indexer.pending.end(), batch.begin(), batch.end());
+            this->Indexer.pendingCount += batchCount;
+            this->Indexer.indexedSize = last ? sz : covered;
+            this->Indexer.completed   = last;
         }
-        while (p < loopEnd)
+        this->Indexer.published.notify_all();
+        batch.clear();
+        batchCount = 0;
+        batchSize  = LINES_BATCH_SIZE;
+    };
+    std::vector<GView::Utils::LineScanner::Line> found;
+    auto addLines = [&]()
+    {
+        for (const auto& l : found)
         {
-            if (ch.FromEncoding(this->settings->encoding, p, e))
-            {
-                p += ch.Length();
-                auto chr = ch.GetChar();
-                if (((chr == '\n') && (lastChar != '\r')) || ((chr == '\r') && (lastChar != '\n')))
-                {
-                    // end of the current line
-                    lines.emplace_back(start, charCount, (uint32) (offset - start));
-                    offset += ch.Length();
-                    start     = offset;
-                    charCount = 0;
-                    lastChar  = chr;
-                    continue;
-                }
+            // after the dense limit only the checkpoints are published (the other lines are scanned again when needed)
+            if ((count < denseLimit) || (count % LineIndex::LINES_PER_CHECKPOINT == 0))
+                batch.emplace_back(l.offset, l.charsCount, l.size);
+            covered = l.offset + l.size + l.newLineSize;
+            count++;
+            if (++batchCount >= batchSize)
+                publish(false);
+        }
+        found.clear();
+    };
 
-                // combined CRLF or LFCR
-                if (((chr == '\n') && (lastChar == '\r')) || ((chr == '\r') && (lastChar == '\n')))
-                {
-                    // just advanced one extra char (no new line found)
-                    offset += ch.Length();
-                    start     = offset;
-                    charCount = 0;
-                    lastChar  = 0; // important as the CRLF or LFCR has ended
-                    continue;
-                }
+    GView::Utils::LineScanner scanner(this->lines.GetEncoding(), start, LineIndex::MAX_CHARS_PER_LINE);
+    // the next chunk is read in background while the current one is scanned
+    GView::Utils::SequentialReader reader(cache, start, sz - std::min<uint64>(start, sz));
+    for (auto buf = reader.Next(); buf.IsValid(); buf = reader.Next())
+    {
+        if (this->Indexer.stop)
+            break;
+        scanner.Scan(buf, found);
+        addLines();
+    }
+    scanner.Finish(found);
+    addLines();
+    publish(true);
+}
+void Instance::StopLineIndexing()
+{
+    this->Indexer.stop = true;
+    if (this->Indexer.worker.joinable())
+        this->Indexer.worker.join();
+}
+bool Instance::UpdateLineIndexes()
+{
+    // moves the lines that were published by the indexing thread into 'lines'
+    if (this->Indexer.merged)
+        return false;
+    std::vector<LineInfo> newLines;
+    uint64 newCount, indexedSize;
+    bool completed;
+    {
+        std::lock_guard<std::mutex> guard(this->Indexer.lock);
+        newLines.swap(this->Indexer.pending);
+        newCount                   = this->Indexer.pendingCount;
+        indexedSize                = this->Indexer.indexedSize;
+        completed                  = this->Indexer.completed;
+        this->Indexer.pendingCount = 0;
+    }
+    if ((newCount == 0) && (!completed))
+        return false;
 
-                // other character
-                lastChar = 0; // don't care
-                charCount++;
-                offset += ch.Length();
-                if (charCount > 2000)
-                {
-                    // limit line to 2000 characters
-                    lines.emplace_back(start, charCount, (uint32) (offset - start));
-                    start     = offset;
-                    charCount = 0;
-                }
-            }
-            else
-            {
-                // need to treat conversion error
-                // consider one character (binary format)
-                charCount++;
-                offset++;
-                p++;
-                if (charCount > 2000)
-                {
-                    // limit line to 2000 characters
-                    lines.emplace_back(start, charCount, (uint32) (offset - start));
-                    start     = offset;
-                    charCount = 0;
-                }
-            }
-        }
-        if (charCount > 0)
+    const auto oldCount = this->lines.GetCount();
+    if ((this->Indexer.replaceLast) && (newCount > 0))
+    {
+        // the object grew => the first line that was indexed again replaces the previous last line
+        this->lines.RemoveLast();
+        this->Indexer.replaceLast = false;
+        ResetSubLinesCache();
+    }
+    this->lines.Append(newLines, newCount, indexedSize);
+    if (completed)
+    {
+        if (this->Indexer.worker.joinable())
+            this->Indexer.worker.join();
+        this->Indexer.merged         = true;
+        this->Indexer.replaceLast    = false;
+        this->Indexer.estimatedCount = this->lines.GetCount();
+    }
+    else
+    {
+        const auto estimated         = this->lines.GetCount() * this->obj->GetData().GetSize() / std::max<uint64>(indexedSize, 1);
+        this->Indexer.estimatedCount = std::max<uint64>(estimated, this->lines.GetCount());
+    }
+
+    // the view port has to be computed again if it reached the previous end of the index (or the lines number width changed)
+    const auto oldWidth = this->lineNumberWidth;
+    UpdateLineNumberWidth();
+    if ((this->lineNumberWidth != oldWidth) || (this->ViewPort.End.lineNo + 1 >= oldCount))
+    {
+        this->ComputeViewPort(this->ViewPort.Start.lineNo, this->ViewPort.Start.subLineNo, Direction::TopToBottom);
+        this->UpdateViewPort();
+    }
+
+    // a GoTo to an offset that was not indexed at that time
+    if ((this->Indexer.pendingGoTo != GView::Utils::INVALID_OFFSET) && (!this->lines.IsEmpty()))
+    {
+        const auto last = this->lines.GetLast();
+        if ((this->Indexer.merged) || (this->Indexer.pendingGoTo < last.offset + last.size))
         {
-            // last line
-            lines.emplace_back(start, charCount, (uint32) (offset - start));
+            const auto offset         = this->Indexer.pendingGoTo;
+            this->Indexer.pendingGoTo = GView::Utils::INVALID_OFFSET;
+            GoTo(offset);
         }
     }
+    if (this->Follow.toEnd)
+    {
+        MoveToEndOfFile(false);
+        this->Follow.toEnd = !this->Indexer.merged;
+    }
+    return true;
+}
+void Instance::FollowObjectGrowth()
+{
+    // the file itself is checked again only if the size polled in background changed (and after the previous indexing ended)
+    // the object is shared with the other views => one of them could have already noticed that its size changed
+    auto& data        = this->obj->GetData();
+    const auto polled = this->Follow.watcher.GetSize();
+    if ((this->Follow.enabled) && (this->Indexer.merged) && (polled != this->Follow.polledSize))
+    {
+        this->Follow.polledSize = polled;
+        data.UpdateSize();
+    }
+    if (data.GetSize() < this->Indexer.indexedSize)
+    {
+        // the file was truncated => the lines (and the matches) past its new end are gone and the ones before it could have
+        // been written again => everything is indexed again and the cursor stays on the same line (or on the last one)
+        const auto lineNo    = this->Cursor.lineNo;
+        const auto charIndex = this->Cursor.charIndex;
+        this->search.results.Clear();
+        this->search.matchOffset = GView::Utils::INVALID_OFFSET;
+        this->search.matchSize   = 0;
+        this->sizeOfBOM = (uint32) std::min<uint64>(this->sizeOfBOM, data.GetSize());
+        this->ViewPort.Reset();
+        RecomputeLineIndexes();
+        MoveTo(lineNo, charIndex, false);
+        return;
+    }
+    if ((!this->Follow.enabled) || (!this->Indexer.merged) || (data.GetSize() == this->Indexer.indexedSize))
+        return;
 
-    auto linesCount = this->lines.size() + 1;
-    if (linesCount < 10)
-        this->lineNumberWidth = 2;
-    else if (linesCount < 100)
-        this->lineNumberWidth = 3;
-    else if (linesCount < 1000)
-        this->lineNumberWidth = 4;
-    else if (linesCount < 10000)
-        this->lineNumberWidth = 5;
-    else if (linesCount < 100000)
-        this->lineNumberWidth = 6;
-    else if (linesCount < 1000000)
-        this->lineNumberWidth = 7;
-    else
-        this->lineNumberWidth = 8;
+    // if the cursor was on the last line it moves to the new end of the object
+    this->Follow.toEnd = (this->Follow.autoScroll) && (this->Cursor.lineNo + 1 >= this->lines.GetCount());
+
+    // only the appended data is indexed ; the last line is scanned again as it can continue in the new data (or its '\r' can be
+    // paired with a '\n' from the new data)
+    uint64 start = this->sizeOfBOM, firstLine = 0;
+    if (!this->lines.IsEmpty())
+    {
+        start                     = this->lines.GetLast().offset;
+        firstLine                 = this->lines.GetCount() - 1;
+        this->Indexer.replaceLast = true;
+    }
+    StartLineIndexing(start, data.GetSize(), firstLine);
+    UpdateLineIndexes();
+}
+void Instance::SetFollowMode(bool enabled)
+{
+    this->Follow.enabled = enabled;
+    this->Follow.toEnd   = false;
+    this->Follow.watcher.Stop();
+    if (!enabled)
+        return;
+    this->Follow.watcher.Start(this->obj->GetPath());
+    this->Follow.polledSize = this->obj->GetData().GetSize(); // the file is checked as soon as the indexing ends
+    FollowObjectGrowth();
+    if (this->Follow.autoScroll)
+    {
+        UpdateLineIndexes();
+        MoveToEndOfFile(false);
+        this->Follow.toEnd = !this->Indexer.merged;
+    }
+}
+void Instance::UpdateLineNumberWidth()
+{
+    // while the lines are indexed the width is computed for the estimated number of lines (so that it rarely changes)
+    // (the digits of the last line number and a separator)
+    this->lineNumberWidth = 2;
+    for (auto linesCount = this->Indexer.estimatedCount + 1; linesCount >= 10; linesCount /= 10)
+        this->lineNumberWidth++;
 }
-bool Instance::GetLineInfo(uint32 lineNo, LineInfo& li)
+uint64 Instance::OffsetToLineNo(uint64 offset)
 {
-    if (lineNo >= this->lines.size())
+    return this->lines.OffsetToLineNo(offset);
+}
+bool Instance::GetLineInfo(uint64 lineNo, LineInfo& li)
+{
+    if (lineNo >= this->lines.GetCount())
         return false;
-    li = this->lines[lineNo];
+    li = this->lines.Get(lineNo);
     return true;
 }
-LineInfo Instance::GetLineInfo(uint32 lineNo)
+LineInfo Instance::GetLineInfo(uint64 lineNo)
 {
-    const auto sz = this->lines.size();
+    const auto sz = this->lines.GetCount();
     if (lineNo < sz)
-        return this->lines[lineNo];
+        return this->lines.Get(lineNo);
     // if its outside --> always return the last line
     if (sz > 0)
-        return this->lines[sz - 1];
+        return this->lines.GetLast();
     // otherwise return an empty line
     return LineInfo(0, 0, 0);
 }
-void Instance::ComputeSubLineIndexes(uint32 lineNo, BufferView& buf, uint64& startOffset)
+void Instance::ResetSubLinesCache()
+{
+    this->SubLines.lineNo = INVALID_LINE_NUMBER;
+    for (auto& e : this->SubLinesCache)
+    {
+        e.lineNo  = INVALID_LINE_NUMBER;
+        e.lastUse = 0;
+    }
+}
+bool Instance::LoadSubLinesLayout(uint64 lineNo, uint32 width)
 {
-    if (lineNo == this->SubLines.lineNo)
-        return; // we've already computed this --> no need to computed again
+    auto isLayoutOf = [&](const SubLinesLayout& l)
+    {
+        return (l.lineNo == lineNo) && (l.width == width) && (l.tabSize == this->settings->tabSize) &&
+               (l.wrapMethod == this->settings->wrapMethod);
+    };
+    if (isLayoutOf(this->SubLines))
+        return true;
 
-    LineInfo li            = GetLineInfo(lineNo);
-    uint32 w               = this->GetWidth();
-    uint32 bufPos          = 0;
-    uint32 charIndex       = 0;
-    bool computeAlignament = true;
-    auto bp                = BulletParserState::FirstPadding;
-    uint32 bpBulletWidth   = 0;
-    startOffset            = li.offset;
+    // the current layout goes into the cache (in place of the requested one or of the least recently used one)
+    SubLinesLayout* found = nullptr;
+    SubLinesLayout* older = &this->SubLinesCache[0];
+    for (auto& e : this->SubLinesCache)
+    {
+        if ((e.lineNo != INVALID_LINE_NUMBER) && (isLayoutOf(e)))
+        {
+            found = &e;
+            break;
+        }
+        if (e.lastUse < older->lastUse)
+            older = &e;
+    }
+    if (found)
+    {
+        std::swap(*found, this->SubLines);
+        if (found->lineNo == INVALID_LINE_NUMBER)
+            found->lastUse = 0;
+        this->SubLines.lastUse = ++this->subLinesUseCounter;
+        return true;
+    }
+    if (this->SubLines.lineNo != INVALID_LINE_NUMBER)
+        std::swap(*older, this->SubLines); // 'SubLines' reuses the memory of the evicted layout
+    return false;
+}
+void Instance::ComputeSubLineIndexes(uint64 lineNo, uint32 subLinesCount, uint32 charIndex)
+{
+    uint32 w = this->GetWidth();
+    if ((this->lineNumberWidth + 2) >= w)
+        w = 1;
+    else
+        w -= (this->lineNumberWidth + 2);
+
+    // the layout is computed until it has 'subLinesCount' sub-lines and the last one ends after 'charIndex'
+    auto isEnough = [&]()
+    {
+        if (this->SubLines.complete)
+            return true;
+        if (this->SubLines.entries.size() < subLinesCount)
+            return false;
+        const auto& last = this->SubLines.entries.back();
+        return last.relativeCharIndex + last.charsCount > charIndex;
+    };
+    // a layout is computed only once while it stays in the cache (the view port is computed again on almost every key)
+    if (LoadSubLinesLayout(lineNo, w))
+    {
+        if (isEnough())
+            return;
+    }
+    else
+    {
+        this->SubLines.entries.clear();
+        this->SubLines.lineNo         = lineNo;
+        this->SubLines.leftAlignament = 0;
+        this->SubLines.width          = w;
+        this->SubLines.tabSize        = this->settings->tabSize;
+        this->SubLines.wrapMethod     = this->settings->wrapMethod;
+        this->SubLines.lastUse        = ++this->subLinesUseCounter;
+        this->SubLines.nextOffset     = 0;
+        this->SubLines.nextCharIndex  = 0;
+        this->SubLines.complete       = false;
+    }
+
+    LineInfo li = GetLineInfo(lineNo);
 
     //---------------------------------------------------
     //|  We will always have at least ONE sub-line      |
     //---------------------------------------------------
-    this->SubLines.entries.clear();
-    this->SubLines.lineNo         = lineNo;
-    this->SubLines.leftAlignament = 0;
+    if (this->settings->wrapMethod == WrapMethod::None)
+    {
+        this->SubLines.entries.emplace_back(0, li.size, 0, li.charsCount);
+        this->SubLines.complete = true;
+        if ((li.size == 0) || (li.charsCount == 0))
+        {
+            this->SubLines.lineNo = INVALID_LINE_NUMBER; // need to recompute
+        }
+        return;
+    }
 
-    if ((this->lineNumberWidth + 2) >= w)
-        w = 1;
-    else
-        w -= (this->lineNumberWidth + 2);
-    buf = this->obj->GetData().Get(li.offset, li.size, false);
-    CharacterStream cs(buf, 0, this->settings.ToReference());
-    // process
+    // the decoding continues from the start of the next sub-line ; the left alignament is known after the first sub-line
+    const auto start       = std::min<>(this->SubLines.nextOffset, li.size);
+    uint32 bufPos          = 0;
+    uint32 lineCharIndex   = this->SubLines.nextCharIndex;
+    bool computeAlignament = this->SubLines.entries.empty();
+    auto bp                = BulletParserState::FirstPadding;
+    uint32 bpBulletWidth   = 0;
+    bool stopped           = false;
 
-    if (this->settings->wrapMethod != WrapMethod::None)
+    CharacterStream cs(this->obj->GetData().Get(li.offset + start, li.size - start, false), lineCharIndex, this->settings.ToReference());
+    if (!computeAlignament)
+        cs.ResetXOffset(this->SubLines.leftAlignament);
+    // process
+    while (cs.Next())
     {
-        // parse first sub-line
-        while (cs.Next())
+        if (cs.GetNextXOffset() > w)
         {
-            if (cs.GetNextXOffset() > w)
+            // move to next line
+            this->SubLines.entries.emplace_back(
+                  start + bufPos, cs.GetCurrentBufferPos() - bufPos, lineCharIndex, cs.GetNextCharIndex() - lineCharIndex);
+            bufPos            = cs.GetCurrentBufferPos();
+            lineCharIndex     = cs.GetNextCharIndex();
+            computeAlignament = false;
+            cs.ResetXOffset(this->SubLines.leftAlignament);
+            if (isEnough())
             {
-                // move to next line
-                this->SubLines.entries.emplace_back(
-                      bufPos, cs.GetCurrentBufferPos() - bufPos, charIndex, cs.GetNextCharIndex() - charIndex);
-                bufPos            = cs.GetCurrentBufferPos();
-                charIndex         = cs.GetNextCharIndex();
-                computeAlignament = false;
-                cs.ResetXOffset(this->SubLines.leftAlignament);
+                stopped = true;
+                break;
             }
-            if (computeAlignament)
+        }
+        if (computeAlignament)
+        {
+            switch (this->settings->wrapMethod)
             {
-                switch (this->settings->wrapMethod)
+            case WrapMethod::LeftMargin:
+                computeAlignament             = false;
+                this->SubLines.leftAlignament = 0;
+                break;
+            case WrapMethod::Padding:
+                if ((cs.GetCharacter() == ' ') || (cs.IsTabCharacter()))
+                    this->SubLines.leftAlignament = cs.GetNextXOffset();
+                else
+                    computeAlignament = false;
+                break;
+            case WrapMethod::Bullets:
+                // its important for the parser to check this states in this order (next padding, first padding and bullet)
+                if (bp == BulletParserState::NextPadding)
                 {
-                case WrapMethod::LeftMargin:
-                    computeAlignament             = false;
-                    this->SubLines.leftAlignament = 0;
-                    break;
-                case WrapMethod::Padding:
                     if ((cs.GetCharacter() == ' ') || (cs.IsTabCharacter()))
                         this->SubLines.leftAlignament = cs.GetNextXOffset();
                     else
                         computeAlignament = false;
-                    break;
-                case WrapMethod::Bullets:
-                    // its important for the parser to check this states in this order (next padding, first padding and bullet)
-                    if (bp == BulletParserState::NextPadding)
-                    {
-                        if ((cs.GetCharacter() == ' ') || (cs.IsTabCharacter()))
-                            this->SubLines.leftAlignament = cs.GetNextXOffset();
-                        else
-                            computeAlignament = false;
-                    }
-                    if (bp == BulletParserState::FirstPadding)
+                }
+                if (bp == BulletParserState::FirstPadding)
+                {
+                    if ((cs.GetCharacter() == ' ') || (cs.IsTabCharacter()))
+                        this->SubLines.leftAlignament = cs.GetNextXOffset();
+                    else
                     {
-                        if ((cs.GetCharacter() == ' ') || (cs.IsTabCharacter()))
-                            this->SubLines.leftAlignament = cs.GetNextXOffset();
-                        else
-                        {
-                            bp            = BulletParserState::Bullet;
-                            bpBulletWidth = 0;
-                        }
+                        bp            = BulletParserState::Bullet;
+                        bpBulletWidth = 0;
                     }
-                    if (bp == BulletParserState::Bullet)
+                }
+                if (bp == BulletParserState::Bullet)
+                {
+                    this->SubLines.leftAlignament = cs.GetNextXOffset();
+                    bpBulletWidth++;
+                    if ((cs.GetCharacter() == '-') || (cs.GetCharacter() == '*') || (cs.GetCharacter() == '.') ||
+                        (cs.GetCharacter() == ')'))
+                        bp = BulletParserState::NextPadding;
+                    else if (bpBulletWidth > 4)
                     {
-                        this->SubLines.leftAlignament = cs.GetNextXOffset();
-                        bpBulletWidth++;
-                        if ((cs.GetCharacter() == '-') || (cs.GetCharacter() == '*') || (cs.GetCharacter() == '.') ||
-                            (cs.GetCharacter() == ')'))
-                            bp = BulletParserState::NextPadding;
-                        else if (bpBulletWidth > 4)
-                        {
-                            // no special bullet detected --> align normally to the left margin
-                            computeAlignament             = false;
-                            this->SubLines.leftAlignament = 0;
-                        }
+                        // no special bullet detected --> align normally to the left margin
+                        computeAlignament             = false;
+                        this->SubLines.leftAlignament = 0;
                     }
-                    break;
-                default:
-                    computeAlignament = false;
-                    break;
                 }
+                break;
+            default:
+                computeAlignament = false;
+                break;
             }
         }
-        if (cs.GetCurrentBufferPos() > bufPos)
-            this->SubLines.entries.emplace_back(bufPos, cs.GetCurrentBufferPos() - bufPos, charIndex, cs.GetCharIndex() - charIndex);
-        // there should always be at least one sub-line
-        if (this->SubLines.entries.empty())
-        {
-            this->SubLines.entries.emplace_back(0, 0, 0, 0);
-            this->SubLines.lineNo = INVALID_LINE_NUMBER; // need to recompute
-        }
     }
-    else
+    this->SubLines.nextOffset    = start + bufPos;
+    this->SubLines.nextCharIndex = lineCharIndex;
+    if (stopped)
+        return;
+
+    this->SubLines.complete = true;
+    if (cs.GetCurrentBufferPos() > bufPos)
+        this->SubLines.entries.emplace_back(
+              start + bufPos, cs.GetCurrentBufferPos() - bufPos, lineCharIndex, cs.GetCharIndex() - lineCharIndex);
+    // there should always be at least one sub-line
+    if (this->SubLines.entries.empty())
     {
-        this->SubLines.entries.emplace_back(0, li.size, 0, li.charsCount);
-        if ((li.size == 0) || (li.charsCount == 0))
-        {
-            this->SubLines.lineNo = INVALID_LINE_NUMBER; // need to recompute
-        }
+        this->SubLines.entries.emplace_back(0, 0, 0, 0);
+        this->SubLines.lineNo = INVALID_LINE_NUMBER; // need to recompute
     }
 }
-void Instance::ComputeSubLineIndexes(uint32 lineNo)
+void Instance::ComputeSubLineIndexes(uint64 lineNo)
 {
-    if (lineNo == this->SubLines.lineNo)
-        return; // we've already computed this --> no need to computed again
-    uint64 startOffset;
-    BufferView buf;
-    ComputeSubLineIndexes(lineNo, buf, startOffset);
+    ComputeSubLineIndexes(lineNo, ALL_SUB_LINES, 0);
+}
+uint32 Instance::ComputeSubLineNo(uint64 lineNo, uint32 charIndex)
+{
+    // only the sub-lines up to the one that contains 'charIndex' are needed
+    ComputeSubLineIndexes(lineNo, 1, charIndex);
+    return CharacterIndexToSubLineNo(charIndex);
 }
 uint32 Instance::CharacterIndexToSubLineNo(uint32 charIndex)
 {
@@ -617,10 +859,10 @@ uint32 Instance::CharacterIndexToSubLineNo(uint32 charIndex)
         middle = (start + end) >> 1;
     }
 }
-void Instance::CommputeViewPort_NoWrap(uint32 lineNo, Direction dir)
+void Instance::CommputeViewPort_NoWrap(uint64 lineNo, Direction dir)
 {
     auto h       = (std::min<>(static_cast<uint32>(std::max<>(this->GetHeight(), 1)), MAX_LINES_TO_VIEW)) - 1U;
-    uint32 start = lineNo;
+    uint64 start = lineNo;
     auto* l      = ViewPort.Lines;
 
     if (dir == Direction::BottomToTop)
@@ -629,10 +871,13 @@ void Instance::CommputeViewPort_NoWrap(uint32 lineNo, Direction dir)
     }
 
     ViewPort.Reset();
-    if (this->lines.empty())
+    if (this->lines.IsEmpty())
         return;
 
-    uint32 lastLineNo = static_cast<uint32>(this->lines.size() - 1); // lines.size() will alway be bigger than 1
+    uint64 lastLineNo = this->lines.GetCount() - 1; // lines.size() will alway be bigger than 1
+
+    // the index can have fewer lines than when 'lineNo' was computed (a truncated file or another encoding)
+    start = std::min<>(start, lastLineNo);
 
     // sets the view port
     ViewPort.Start.lineNo    = start;
@@ -641,7 +886,7 @@ void Instance::CommputeViewPort_NoWrap(uint32 lineNo, Direction dir)
     ViewPort.End.subLineNo   = 0;
 
     // populate the lines
-    ViewPort.linesCount = (ViewPort.End.lineNo + 1) - ViewPort.Start.lineNo;
+    ViewPort.linesCount = (uint32) ((ViewPort.End.lineNo + 1) - ViewPort.Start.lineNo);
     auto* l_end         = l + ViewPort.linesCount;
     while (l < l_end)
     {
@@ -651,16 +896,17 @@ void Instance::CommputeViewPort_NoWrap(uint32 lineNo, Direction dir)
         l->offset        = lineInfo.offset;
         l->xStart        = 0;
         l->lineCharIndex = 0;
+        l->scrollStart   = { 0, 0, 0 };
         start++;
         l++;
     }
 }
-void Instance::CommputeViewPort_Wrap(uint32 lineNo, uint32 subLineNo, Direction dir)
+void Instance::CommputeViewPort_Wrap(uint64 lineNo, uint32 subLineNo, Direction dir)
 {
     auto h = (std::min<>(static_cast<uint32>(std::max<>(this->GetHeight(), 1)), MAX_LINES_TO_VIEW));
 
     ViewPort.Reset();
-    if (this->lines.empty())
+    if (this->lines.IsEmpty())
         return;
     if (dir == Direction::TopToBottom)
     {
@@ -673,10 +919,11 @@ void Instance::CommputeViewPort_Wrap(uint32 lineNo, uint32 subLineNo, Direction
         auto* l                  = ViewPort.Lines;
         const auto* l_max        = l + h;
 
-        while ((l < l_max) && (start < this->lines.size()))
+        while ((l < l_max) && (start < this->lines.GetCount()))
         {
             auto lineInfo = GetLineInfo(start);
-            ComputeSubLineIndexes(start);
+            // only the sub-lines that fit in the view port are computed
+            ComputeSubLineIndexes(start, startSL + (uint32) (l_max - l), 0);
             ViewPort.End.lineNo    = start;
             ViewPort.End.subLineNo = 0; // default value
             while ((l < l_max) && (startSL < this->SubLines.entries.size()))
@@ -687,6 +934,7 @@ void Instance::CommputeViewPort_Wrap(uint32 lineNo, uint32 subLineNo, Direction
                 l->xStart        = startSL == 0 ? 0 : this->SubLines.leftAlignament;
                 l->size          = sl.size;
                 l->lineCharIndex = sl.relativeCharIndex;
+                l->scrollStart   = { 0, 0, 0 };
                 l++;
                 ViewPort.End.subLineNo = startSL;
                 startSL++;
@@ -705,7 +953,7 @@ void Instance::CommputeViewPort_Wrap(uint32 lineNo, uint32 subLineNo, Direction
         ViewPort.End.subLineNo   = subLineNo;
         auto* l                  = ViewPort.Lines + MAX_LINES_TO_VIEW - 1;
         const auto* l_min        = l - h;
-        auto start               = (int32) lineNo;
+        auto start               = (int64) lineNo;
         auto startSL             = (int32) subLineNo;
         bool resetSL             = false;
         while ((l > l_min) && (start >= 0))
@@ -724,6 +972,7 @@ void Instance::CommputeViewPort_Wrap(uint32 lineNo, uint32 subLineNo, Direction
                 l->xStart        = startSL == 0 ? 0 : this->SubLines.leftAlignament;
                 l->size          = sl.size;
                 l->lineCharIndex = sl.relativeCharIndex;
+                l->scrollStart   = { 0, 0, 0 };
                 l--;
                 ViewPort.Start.subLineNo = startSL;
                 startSL--;
@@ -740,27 +989,27 @@ void Instance::CommputeViewPort_Wrap(uint32 lineNo, uint32 subLineNo, Direction
         }
     }
 }
-void Instance::ComputeViewPort(uint32 lineNo, uint32 subLineNo, Direction dir)
+void Instance::ComputeViewPort(uint64 lineNo, uint32 subLineNo, Direction dir)
 {
     if (this->HasWordWrap())
         CommputeViewPort_Wrap(lineNo, subLineNo, dir);
     else
         CommputeViewPort_NoWrap(lineNo, dir);
 }
-void Instance::MoveTo(uint32 lineNo, uint32 charIndex, bool select)
+void Instance::MoveTo(uint64 lineNo, uint32 charIndex, bool select)
 {
     auto sidx = -1;
     if (select)
         sidx = this->selection.BeginSelection(this->Cursor.pos);
     // sanity checks
-    if (this->lines.size() == 0)
+    if (this->lines.IsEmpty())
     {
         lineNo = 0;
     }
     else
     {
-        if (lineNo >= static_cast<uint32>(this->lines.size()))
-            lineNo = static_cast<uint32>(this->lines.size() - 1);
+        if (lineNo >= this->lines.GetCount())
+            lineNo = this->lines.GetCount() - 1;
     }
     LineInfo li = GetLineInfo(lineNo);
     if (charIndex >= li.charsCount)
@@ -774,8 +1023,7 @@ void Instance::MoveTo(uint32 lineNo, uint32 charIndex, bool select)
     if (this->HasWordWrap())
     {
         // find the new subline for the cursor
-        ComputeSubLineIndexes(lineNo);
-        this->Cursor.sublineNo = CharacterIndexToSubLineNo(charIndex);
+        this->Cursor.sublineNo = ComputeSubLineNo(lineNo, charIndex);
     }
     else
     {
@@ -788,14 +1036,14 @@ void Instance::MoveTo(uint32 lineNo, uint32 charIndex, bool select)
         this->selection.UpdateSelection(sidx, this->Cursor.pos);
     }
 }
-void Instance::MoveToStartOfLine(uint32 lineNo, bool select)
+void Instance::MoveToStartOfLine(uint64 lineNo, bool select)
 {
-    if (lineNo >= this->lines.size())
-        MoveToEndOfLine(static_cast<uint32>(this->lines.size() - 1), select); // last position
+    if (lineNo >= this->lines.GetCount())
+        MoveToEndOfLine(this->lines.GetCount() - 1, select); // last position
     else
         MoveTo(lineNo, 0, select);
 }
-void Instance::MoveToEndOfLine(uint32 lineNo, bool select)
+void Instance::MoveToEndOfLine(uint64 lineNo, bool select)
 {
     LineInfo li = GetLineInfo(lineNo);
     if (li.charsCount > 0)
@@ -805,9 +1053,9 @@ void Instance::MoveToEndOfLine(uint32 lineNo, bool select)
 }
 void Instance::MoveToEndOfFile(bool select)
 {
-    if (this->lines.empty())
+    if (this->lines.IsEmpty())
         return;
-    MoveTo(static_cast<uint32>(this->lines.size() - 1), 0xFFFFFFFF, select);
+    MoveTo(this->lines.GetCount() - 1, 0xFFFFFFFF, select);
 }
 void Instance::MoveLeft(bool select)
 {
@@ -845,9 +1093,9 @@ void Instance::MoveToNextWord(bool select)
 }
 void Instance::MoveDown(uint32 noOfTimes, bool select)
 {
-    if (this->lines.size() == 0)
+    if (this->lines.IsEmpty())
         return; // safety check
-    uint32 lastLine = static_cast<uint32>(this->lines.size() - 1);
+    uint64 lastLine = this->lines.GetCount() - 1;
     if (HasWordWrap())
     {
         auto lineNo = this->Cursor.lineNo;
@@ -913,17 +1161,16 @@ void Instance::MoveDown(uint32 noOfTimes, bool select)
         if (Cursor.lineNo == lastLine)
             MoveToEndOfLine(lastLine, select);
         else
-            MoveTo(std::min<>(lastLine, this->Cursor.lineNo + noOfTimes), this->Cursor.charIndex, select);
+            MoveTo(std::min<uint64>(lastLine, this->Cursor.lineNo + noOfTimes), this->Cursor.charIndex, select);
     }
 }
 void Instance::MoveScrollDown()
 {
     if (this->HasWordWrap())
     {
-        ComputeSubLineIndexes(this->ViewPort.Start.lineNo);
         if ((this->Cursor.lineNo == this->ViewPort.Start.lineNo) && (this->Cursor.sublineNo == this->ViewPort.Start.subLineNo))
             MoveDown(1, false);
-        ComputeSubLineIndexes(this->ViewPort.Start.lineNo);
+        ComputeSubLineIndexes(this->ViewPort.Start.lineNo, this->ViewPort.Start.subLineNo + 2U, 0);
         if (static_cast<size_t>(this->ViewPort.Start.subLineNo) + 1U < this->SubLines.entries.size())
             this->ComputeViewPort(this->ViewPort.Start.lineNo, this->ViewPort.Start.subLineNo + 1U, Direction::TopToBottom);
         else
@@ -1089,8 +1336,7 @@ void Instance::UpdateCursor_Wrap()
 {
     // only file pos need to be computed
     auto li = GetLineInfo(Cursor.lineNo);
-    ComputeSubLineIndexes(Cursor.lineNo);
-    Cursor.sublineNo = CharacterIndexToSubLineNo(Cursor.charIndex);
+    Cursor.sublineNo = ComputeSubLineNo(Cursor.lineNo, Cursor.charIndex);
     const auto& sl   = this->SubLines.entries[Cursor.sublineNo];
     auto idx         = sl.relativeCharIndex;
     CharacterStream cs(this->obj->GetData().Get(sl.relativeOffset + li.offset, sl.size, false), 0, this->settings.ToReference());
@@ -1182,14 +1428,37 @@ void Instance::DrawLine(uint32 y, Graphics::Renderer& renderer, ControlState sta
         renderer.WriteSingleLineText(0, y, this->lineNumberWidth, n.ToDec(vd->lineNo + 1), lineNoColor, TextAlignament::Right);
     renderer.WriteSpecialCharacter(this->lineNumberWidth, y, SpecialChars::BoxVerticalSingleLine, lineSepColor);
 
+    // matches of the last search (from the "find all" index or the one found by FindNext / FindPrevious)
+    const auto& results = this->search.results;
+    auto matchIndex     = results.FirstOverlapping(vd->offset);
+    auto isMatch        = [&](uint64 ofs)
+    {
+        if ((ofs >= this->search.matchOffset) && (ofs - this->search.matchOffset < this->search.matchSize))
+            return true;
+        // characters are visited in offset order => the matches that end before 'ofs' are never needed again
+        while ((matchIndex < results.GetCount()) && (results.GetOffset(matchIndex) + results.GetSize(matchIndex) <= ofs))
+            matchIndex++;
+        return (matchIndex < results.GetCount()) && (results.GetOffset(matchIndex) <= ofs);
+    };
+
     if (vd->size > 0)
     {
-        CharacterStream cs(this->obj->GetData().Get(vd->offset, vd->size, false), 0, this->settings.ToReference());
-        auto c       = this->chars;
-        auto lastC   = this->chars;
-        auto c_end   = c + MAX_CHARACTERS_PER_LINE;
-        auto xScroll = 0U;
-
+        // only the characters that fit in the view are decoded
+        const auto w     = static_cast<uint32>(std::max<>(this->GetWidth(), 0));
+        const auto width = w > this->lineNumberWidth + 1 ? w - (this->lineNumberWidth + 1) : 1U;
+        auto buf         = this->obj->GetData().Get(vd->offset, vd->size, false);
+        auto c           = this->chars;
+        auto lastC       = this->chars;
+        auto c_end       = c + std::min<uint32>(MAX_CHARACTERS_PER_LINE, width);
+        auto xScroll     = 0U;
+
+        // a scrolled line is decoded from the last known character before scrollX (not from its start)
+        auto& from = vd->scrollStart;
+        if ((ViewPort.scrollX == 0) || (from.x >= ViewPort.scrollX) || (from.bufPos > buf.GetLength()))
+            from = { 0, 0, 0 };
+        const auto base = from.bufPos;
+        CharacterStream cs(BufferView(buf.GetData() + base, buf.GetLength() - base), from.charIndex, this->settings.ToReference());
+        cs.ResetXOffset(from.x);
         if (ViewPort.scrollX > 0)
         {
             while (cs.Next())
@@ -1199,9 +1468,10 @@ void Instance::DrawLine(uint32 y, Graphics::Renderer& renderer, ControlState sta
                     xScroll = ViewPort.scrollX;
                     break;
                 }
+                from = { cs.GetNextXOffset(), base + cs.GetCurrentBufferPos(), cs.GetNextCharIndex() };
             }
         }
-        auto bufPos = cs.GetCurrentBufferPos();
+        auto bufPos = base + cs.GetCurrentBufferPos();
         while ((cs.Next()) && (lastC < c_end))
         {
             auto c = this->chars + (cs.GetXOffset() + vd->xStart - xScroll);
@@ -1216,8 +1486,9 @@ void Instance::DrawLine(uint32 y, Graphics::Renderer& renderer, ControlState sta
                 lastC++;
             }
 
-            c->Code  = cs.GetCharacter();
-            c->Color = textColor;
+            const auto matched = isMatch(vd->offset + bufPos);
+            c->Code            = cs.GetCharacter();
+            c->Color           = matched ? config.Colors.SearchMatch : textColor;
             if (focused)
             {
                 if (this->selection.Contains(vd->offset + bufPos))
@@ -1231,6 +1502,8 @@ void Instance::DrawLine(uint32 y, Graphics::Renderer& renderer, ControlState sta
                 {
                     if ((vd->lineNo == Cursor.lineNo) && (cs.GetCharIndex() + vd->lineCharIndex == Cursor.charIndex))
                         c->Color = Cfg.Cursor.Normal;
+                    else if (matched)
+                        c->Color = config.Colors.SearchMatch;
                     else if (cs.HasDecodingErrors())
                         c->Color = Cfg.Text.Error;
                     else if (cs.IsTabCharacter())
@@ -1238,7 +1511,7 @@ void Instance::DrawLine(uint32 y, Graphics::Renderer& renderer, ControlState sta
                 }
             }
             lastC  = c + 1;
-            bufPos = cs.GetCurrentBufferPos();
+            bufPos = base + cs.GetCurrentBufferPos();
         }
         renderer.WriteSingleLineCharacterBuffer(this->lineNumberWidth + 1, y, CharacterView(chars, (size_t) (lastC - chars)), false);
     }
@@ -1249,12 +1522,24 @@ void Instance::DrawLine(uint32 y, Graphics::Renderer& renderer, ControlState sta
             renderer.WriteCharacter(this->lineNumberWidth + 1, y, ' ', Cfg.Cursor.Normal);
     }
 }
+bool Instance::OnFrameUpdate()
+{
+    // an idle view is repainted as soon as the background poll notices that the followed file changed its size (the new data
+    // is indexed in background as well => the view is repainted until the indexing ends)
+    if ((!this->Follow.enabled) || (this->Follow.watcher.GetSize() == this->Follow.polledSize))
+        return false;
+    FollowObjectGrowth();
+    UpdateLineIndexes();
+    return true;
+}
 void Instance::Paint(Graphics::Renderer& renderer)
 {
     auto idx         = 0U;
     auto lineNo      = INVALID_LINE_NUMBER;
     const auto focus = this->HasFocus();
 
+    FollowObjectGrowth();
+    UpdateLineIndexes();
     if (this->ViewPort.linesCount == 0)
     {
         this->ComputeViewPort(0, 0, Direction::TopToBottom);
@@ -1287,10 +1572,20 @@ bool Instance::OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar)
         commandBar.SetCommand(config.Keys.WordWrap, "Wrap:Bullets", CMD_ID_WORD_WRAP);
         break;
     }
+    commandBar.SetCommand(config.Keys.Follow, this->Follow.enabled ? "Follow:ON" : "Follow:OFF", CMD_ID_FOLLOW);
+    if (this->search.searcher.IsValid())
+    {
+        commandBar.SetCommand(config.Keys.FindNext, "FindNext", CMD_ID_FIND_NEXT);
+        commandBar.SetCommand(config.Keys.FindPrevious, "FindPrev", CMD_ID_FIND_PREVIOUS);
+    }
     return false;
 }
 bool Instance::OnKeyEvent(AppCUI::Input::Key keyCode, char16 characterCode)
 {
+    FollowObjectGrowth();
+    UpdateLineIndexes();
+    this->Indexer.pendingGoTo = GView::Utils::INVALID_OFFSET; // the user moved away from it
+    this->Follow.toEnd        = false;
     switch (keyCode)
     {
     case Key::Left:
@@ -1415,16 +1710,27 @@ bool Instance::OnEvent(Reference<Control>, Event eventType, int ID)
             break;
         }
         return true;
+    case CMD_ID_FOLLOW:
+        SetFollowMode(!this->Follow.enabled);
+        return true;
+    case CMD_ID_FIND_NEXT:
+        FindNext();
+        return true;
+    case CMD_ID_FIND_PREVIOUS:
+        FindPrevious();
+        return true;
     }
     return false;
 }
 void Instance::OnUpdateScrollBars()
 {
-    if (this->lines.size() > 0)
+    UpdateLineIndexes();
+    if (this->lines.GetCount() > 0)
     {
-        const auto& fistLine = this->lines[0];
-        const auto& lastLine = this->lines[this->lines.size() - 1];
-        const auto maxOfs    = lastLine.offset + lastLine.size;
+        const auto fistLine = this->lines.Get(0);
+        const auto lastLine = this->lines.GetLast();
+        // while the lines are indexed the scroll bar covers the whole object
+        const auto maxOfs = this->Indexer.merged ? lastLine.offset + lastLine.size : this->obj->GetData().GetSize();
         auto pos             = std::max<>(this->Cursor.pos, fistLine.offset);
         this->UpdateVScrollBar(std::min<>(pos, maxOfs), maxOfs);
     }
@@ -1436,22 +1742,21 @@ void Instance::OnUpdateScrollBars()
 void Instance::SetWrapMethod(WrapMethod method)
 {
     this->settings->wrapMethod = method;
-    this->ViewPort.scrollX     = 0;
-    this->SubLines.lineNo      = INVALID_LINE_NUMBER;
+    this->ViewPort.scrollX = 0;
     this->ViewPort.Reset();
     this->ComputeViewPort(this->ViewPort.Start.lineNo, this->ViewPort.Start.subLineNo, Direction::TopToBottom);
     this->UpdateViewPort();
 }
 bool Instance::GoTo(uint64 offset)
 {
-    auto lineNo = 0U;
-    for (lineNo = 0U; lineNo < this->lines.size(); lineNo++)
+    UpdateLineIndexes();
+    const auto last = this->lines.IsEmpty() ? LineInfo(0, 0, 0) : this->lines.GetLast();
+    if ((!this->Indexer.merged) && (!this->lines.IsEmpty()) && (offset >= last.offset + last.size))
     {
-        if (offset < this->lines[lineNo].offset)
-            break;
+        // not indexed yet --> go as far as possible now and finish the move when the line is indexed
+        this->Indexer.pendingGoTo = offset;
     }
-    if (lineNo > 0)
-        lineNo--;
+    auto lineNo = OffsetToLineNo(offset);
     auto li     = GetLineInfo(lineNo);
     auto cIndex = 0U;
     CharacterStream cs(this->obj->GetData().Get(li.offset, li.size, false), 0, this->settings.ToReference());
@@ -1470,7 +1775,8 @@ bool Instance::Select(uint64 offset, uint64 size)
 }
 bool Instance::ShowGoToDialog()
 {
-    GoToDialog dlg(this->Cursor.pos, this->obj->GetData().GetSize(), this->Cursor.lineNo + 1U, static_cast<uint32>(this->lines.size()));
+    UpdateLineIndexes();
+    GoToDialog dlg(this->Cursor.pos, this->obj->GetData().GetSize(), this->Cursor.lineNo + 1, this->Indexer.estimatedCount);
     if (dlg.Show() == Dialogs::Result::Ok)
     {
         if (dlg.ShouldGoToLine())
@@ -1486,7 +1792,150 @@ bool Instance::ShowGoToDialog()
 }
 bool Instance::ShowFindDialog()
 {
-    NOT_IMPLEMENTED(false);
+    FindDialog dlg(&this->search, this->settings->encoding);
+    if (dlg.Show() == Dialogs::Result::Ok)
+    {
+        // highlighted matches belong to the previous search
+        this->search.results.Clear();
+        this->search.matchOffset = GView::Utils::INVALID_OFFSET;
+        this->search.matchSize   = 0;
+        if (this->search.findAll)
+            FindAll();
+        else
+            FindNext();
+    }
+    return true;
+}
+void Instance::MoveToMatch(uint64 offset, uint32 size)
+{
+    GoTo(offset);
+    this->search.matchOffset = offset;
+    this->search.matchSize   = size;
+}
+void Instance::FindNext()
+{
+    // with a "find all" index the next match is one binary search away
+    const auto& results = this->search.results;
+    if (results.GetCount() > 0)
+    {
+        auto idx = results.LowerBound(this->Cursor.pos + 1);
+        if (idx >= results.GetCount())
+            idx = 0; // wrap around
+        MoveToMatch(results.GetOffset(idx), results.GetSize(idx));
+        return;
+    }
+
+    const auto size = this->obj->GetData().GetSize();
+    if ((size == 0) || (this->search.searcher.IsValid() == false))
+        return;
+
+    // search from the cursor (the current match is skipped) to the end and then from the beginning up to the cursor
+    const auto start = std::min<>(this->Cursor.pos + 1, size);
+    GView::Utils::SearchMatch result{ GView::Utils::INVALID_OFFSET, 0, 0 };
+    auto onMatch = [&result](const GView::Utils::SearchMatch& m)
+    {
+        result = m;
+        return false; // first match is enough
+    };
+    if (this->search.searcher->SearchWithProgress(this->obj, start, size - start, "Searching ...", onMatch) == false)
+        return;
+    if ((result.offset == GView::Utils::INVALID_OFFSET) && (start > 0))
+    {
+        const auto end = std::min<>(start + this->search.searcher->GetMaxMatchSize() - 1, size);
+        if (this->search.searcher->SearchWithProgress(this->obj, 0, end, "Searching from the beginning ...", onMatch) == false)
+            return;
+    }
+    if (result.offset == GView::Utils::INVALID_OFFSET)
+    {
+        Dialogs::MessageBox::ShowNotification("Find", "Pattern not found !");
+        return;
+    }
+    MoveToMatch(result.offset, result.size);
+}
+void Instance::FindPrevious()
+{
+    const auto& results = this->search.results;
+    if (results.GetCount() > 0)
+    {
+        auto idx = results.LowerBound(this->Cursor.pos);
+        idx      = idx > 0 ? idx - 1 : results.GetCount() - 1; // wrap around
+        MoveToMatch(results.GetOffset(idx), results.GetSize(idx));
+        return;
+    }
+
+    const auto size = this->obj->GetData().GetSize();
+    if ((size == 0) || (this->search.searcher.IsValid() == false))
+        return;
+
+    // without an index the data can only be searched forward => the last match before the cursor is kept
+    const auto cursor = std::min<>(this->Cursor.pos, size);
+    GView::Utils::SearchMatch result{ GView::Utils::INVALID_OFFSET, 0, 0 };
+    auto onMatch = [&result, cursor](const GView::Utils::SearchMatch& m)
+    {
+        if (m.offset >= cursor)
+            return false;
+        result = m;
+        return true;
+    };
+    const auto end = std::min<>(cursor + this->search.searcher->GetMaxMatchSize() - 1, size);
+    if (this->search.searcher->SearchWithProgress(this->obj, 0, end, "Searching ...", onMatch) == false)
+        return;
+    if ((result.offset == GView::Utils::INVALID_OFFSET) && (cursor < size))
+    {
+        // wrap around => the last match of the object
+        auto onLastMatch = [&result](const GView::Utils::SearchMatch& m)
+        {
+            result = m;
+            return true;
+        };
+        if (this->search.searcher->SearchWithProgress(this->obj, cursor, size - cursor, "Searching from the end ...", onLastMatch) == false)
+            return;
+    }
+    if (result.offset == GView::Utils::INVALID_OFFSET)
+    {
+        Dialogs::MessageBox::ShowNotification("Find", "Pattern not found !");
+        return;
+    }
+    MoveToMatch(result.offset, result.size);
+}
+void Instance::FindAll()
+{
+    auto& results   = this->search.results;
+    const auto size = this->obj->GetData().GetSize();
+    results.Clear();
+    if ((size == 0) || (this->search.searcher.IsValid() == false))
+        return;
+
+    auto truncated = false;
+    auto onMatch   = [&results, &truncated](const GView::Utils::SearchMatch& m)
+    {
+        if (results.GetCount() >= MAX_FIND_ALL_RESULTS)
+        {
+            truncated = true;
+            return false;
+        }
+        results.Add(m.offset, m.size);
+        return true;
+    };
+    if (this->search.searcher->SearchWithProgress(this->obj, 0, size, "Searching all matches ...", onMatch) == false)
+    {
+        results.Clear();
+        return;
+    }
+    if (results.GetCount() == 0)
+    {
+        Dialogs::MessageBox::ShowNotification("Find", "Pattern not found !");
+        return;
+    }
+    LocalString<128> tmp;
+    const auto message = truncated ? tmp.Format("Too many matches: only the first %llu were kept !", (uint64) MAX_FIND_ALL_RESULTS)
+                                   : tmp.Format("%llu matches (FindNext / FindPrev go through them)", (uint64) results.GetCount());
+    Dialogs::MessageBox::ShowNotification("Find", message);
+    // the first match from the cursor
+    auto idx = results.LowerBound(this->Cursor.pos);
+    if (idx >= results.GetCount())
+        idx = 0;
+    MoveToMatch(results.GetOffset(idx), results.GetSize(idx));
 }
 bool Instance::ShowCopyDialog()
 {
@@ -1497,7 +1946,7 @@ std::string_view Instance::GetName()
     return this->name;
 }
 //======================================================================[Mouse coords]==================
-void Instance::MousePosToTextOffset(int x, int y, uint32& lineNo, uint32& charIndex)
+void Instance::MousePosToTextOffset(int x, int y, uint64& lineNo, uint32& charIndex)
 {
     if ((y >= 0) && (y < (int) ViewPort.linesCount))
     {
@@ -1568,7 +2017,8 @@ void Instance::MousePosToTextOffset(int x, int y, uint32& lineNo, uint32& charIn
 }
 void Instance::OnMousePressed(int x, int y, AppCUI::Input::MouseButton button)
 {
-    uint32 lineNo, chIndex;
+    uint64 lineNo;
+    uint32 chIndex;
     MousePosToTextOffset(x, y, lineNo, chIndex);
     if (x <= (int) this->lineNumberWidth)
     {
@@ -1608,7 +2058,8 @@ void Instance::OnMouseReleased(int x, int y, AppCUI::Input::MouseButton button)
 }
 bool Instance::OnMouseDrag(int x, int y, AppCUI::Input::MouseButton button)
 {
-    uint32 lineNo, chIndex;
+    uint64 lineNo;
+    uint32 chIndex;
     MousePosToTextOffset(x, y, lineNo, chIndex);
     MoveTo(lineNo, chIndex, true);
     return true;
@@ -1649,7 +2100,20 @@ int Instance::PrintSelectionInfo(uint32 selectionID, int x, int y, uint32 width,
 void Instance::PaintCursorInformation(AppCUI::Graphics::Renderer& r, uint32 width, uint32 height)
 {
     LocalString<128> tmp;
+    LocalString<32> lineInfo;
+    LocalString<16> indexInfo;
     auto xPoz = 0;
+    if (this->Indexer.merged)
+    {
+        lineInfo.Format("%llu/%llu", Cursor.lineNo + 1, lines.GetCount());
+    }
+    else
+    {
+        // the total number of lines is an estimation until all the object is indexed
+        const auto size = std::max<uint64>(this->obj->GetData().GetSize(), 1);
+        lineInfo.Format("%llu/~%llu", Cursor.lineNo + 1, this->Indexer.estimatedCount);
+        indexInfo.Format("%u%%", (uint32) (this->Indexer.indexedSize * 100 / size));
+    }
     if (height == 1)
     {
         xPoz = PrintSelectionInfo(0, 0, 0, 16, r);
@@ -1659,9 +2123,11 @@ void Instance::PaintCursorInformation(AppCUI::Graphics::Renderer& r, uint32 widt
             xPoz = PrintSelectionInfo(2, xPoz, 0, 16, r);
             xPoz = PrintSelectionInfo(3, xPoz, 0, 16, r);
         }
-        xPoz = this->WriteCursorInfo(r, xPoz, 0, 20, "Line:", tmp.Format("%d/%d", Cursor.lineNo + 1, (uint32) lines.size()));
+        xPoz = this->WriteCursorInfo(r, xPoz, 0, 20, "Line:", lineInfo.ToStringView());
         xPoz = this->WriteCursorInfo(r, xPoz, 0, 10, "Col:", tmp.Format("%d", Cursor.charIndex + 1));
         xPoz = this->WriteCursorInfo(r, xPoz, 0, 20, "File ofs: ", tmp.Format("%llu", Cursor.pos));
+        if (!this->Indexer.merged)
+            xPoz = this->WriteCursorInfo(r, xPoz, 0, 16, "Indexing:", indexInfo.ToStringView());
     }
     else
     {
@@ -1669,9 +2135,11 @@ void Instance::PaintCursorInformation(AppCUI::Graphics::Renderer& r, uint32 widt
         xPoz = PrintSelectionInfo(2, 0, 1, 16, r);
         PrintSelectionInfo(1, xPoz, 0, 16, r);
         xPoz = PrintSelectionInfo(3, xPoz, 1, 16, r);
-        this->WriteCursorInfo(r, xPoz, 0, 20, "Line:", tmp.Format("%d/%d", Cursor.lineNo + 1, (uint32) lines.size()));
+        this->WriteCursorInfo(r, xPoz, 0, 20, "Line:", lineInfo.ToStringView());
         xPoz = this->WriteCursorInfo(r, xPoz, 1, 20, "Col:", tmp.Format("%d", Cursor.charIndex + 1));
-        xPoz = this->WriteCursorInfo(r, xPoz, 0, 20, "File ofs: ", tmp.Format("%llu", Cursor.pos));
+        this->WriteCursorInfo(r, xPoz, 0, 20, "File ofs: ", tmp.Format("%llu", Cursor.pos));
+        if (!this->Indexer.merged)
+            this->WriteCursorInfo(r, xPoz, 1, 20, "Indexing:", indexInfo.ToStringView());
     }
 }
 
@@ -1686,6 +2154,9 @@ enum class PropertyID : uint32
     TabSize,
     ShowTabCharacter,
     WrapMethodKey,
+    Follow,
+    FollowAutoScroll,
+    FollowKey,
 };
 #define BT(t) static_cast<uint32>(t)
 
@@ -1714,6 +2185,15 @@ bool Instance::GetPropertyValue(uint32 id, PropertyValue& value)
     case PropertyID::WrapMethodKey:
         value = this->config.Keys.WordWrap;
         return true;
+    case PropertyID::Follow:
+        value = this->Follow.enabled;
+        return true;
+    case PropertyID::FollowAutoScroll:
+        value = this->Follow.autoScroll;
+        return true;
+    case PropertyID::FollowKey:
+        value = this->config.Keys.Follow;
+        return true;
     }
     return false;
 }
@@ -1741,6 +2221,8 @@ bool Instance::SetPropertyValue(uint32 id, const PropertyValue& value, String& e
             return false;
         }
         this->settings->tabSize = uint32Temp;
+        for (auto& l : this->ViewPort.Lines)
+            l.scrollStart = { 0, 0, 0 }; // the x offsets depend on the tab size
         this->UpdateViewPort();
         return true;
     case PropertyID::ShowTabCharacter:
@@ -1749,6 +2231,15 @@ bool Instance::SetPropertyValue(uint32 id, const PropertyValue& value, String& e
     case PropertyID::WrapMethodKey:
         config.Keys.WordWrap = std::get<AppCUI::Input::Key>(value);
         return true;
+    case PropertyID::Follow:
+        SetFollowMode(std::get<bool>(value));
+        return true;
+    case PropertyID::FollowAutoScroll:
+        this->Follow.autoScroll = std::get<bool>(value);
+        return true;
+    case PropertyID::FollowKey:
+        config.Keys.Follow = std::get<AppCUI::Input::Key>(value);
+        return true;
     }
     error.SetFormat("Unknown internat ID: %u", id);
     return false;
@@ -1776,8 +2267,11 @@ const vector<Property> Instance::GetPropertiesList()
         { BT(PropertyID::ShowTabCharacter), "Tabs", "Show tab character", PropertyType::Boolean },
         { BT(PropertyID::Encoding), "Encoding", "Format", PropertyType::List, "Binary=0,Ascii=1,UTF-8=2,UTF-16(LE)=3,UTF-16(BE)=4" },
         { BT(PropertyID::HasBOM), "Encoding", "HasBom", PropertyType::Boolean },
+        { BT(PropertyID::Follow), "Follow", "Enabled", PropertyType::Boolean },
+        { BT(PropertyID::FollowAutoScroll), "Follow", "Auto scroll", PropertyType::Boolean },
         // shortcuts
         { BT(PropertyID::WrapMethodKey), "Shortcuts", "Change wrap method", PropertyType::Key },
+        { BT(PropertyID::FollowKey), "Shortcuts", "Follow mode", PropertyType::Key },
     };
 }
 #undef BT
\ No newline at end of file
@@ -0,0 +1,184 @@
+#include "TextViewer.hpp"
+#include <algorithm>
+
+using namespace GView::View::TextViewer;
+
+constexpr uint64 INVALID_BLOCK = 0xFFFFFFFFFFFFFFFFULL;
+constexpr uint32 SCAN_SIZE     = 0x10000; // bytes read at once when the lines of a block are scanned again
+
+LineIndex::LineIndex()
+{
+    this->count      = 0;
+    this->end        = 0;
+    this->denseLimit = 0;
+    this->useCounter = 0;
+    this->encoding   = LineScanner::Encoding::Ascii;
+    for (auto& b : this->cache)
+    {
+        b.block   = INVALID_BLOCK;
+        b.lastUse = 0;
+    }
+}
+void LineIndex::Reset(GView::Utils::DataCache& dataCache, CharacterEncoding::Encoding textEncoding, uint64 denseLinesLimit, uint64 reserve)
+{
+    this->data       = &dataCache;
+    this->count      = 0;
+    this->end        = 0;
+    this->useCounter = 0;
+    // the index becomes sparse at a block boundary => the first sparse line is a checkpoint
+    this->denseLimit = std::max<uint64>(denseLinesLimit, LINES_PER_CHECKPOINT);
+    this->denseLimit = (this->denseLimit + LINES_PER_CHECKPOINT - 1) / LINES_PER_CHECKPOINT * LINES_PER_CHECKPOINT;
+    this->lines.clear();
+    this->lines.shrink_to_fit();
+    this->lines.reserve(std::min<uint64>(reserve, this->denseLimit));
+    this->checkpoints.clear();
+    this->checkpoints.shrink_to_fit();
+    for (auto& b : this->cache)
+    {
+        b.block   = INVALID_BLOCK;
+        b.lastUse = 0;
+        b.lines.clear();
+    }
+
+    // only the new line characters are looked for => the text is not decoded
+    switch (textEncoding)
+    {
+    case CharacterEncoding::Encoding::UTF8:
+        this->encoding = LineScanner::Encoding::UTF8;
+        break;
+    case CharacterEncoding::Encoding::Unicode16LE:
+        this->encoding = LineScanner::Encoding::UTF16LE;
+        break;
+    case CharacterEncoding::Encoding::Unicode16BE:
+        this->encoding = LineScanner::Encoding::UTF16BE;
+        break;
+    default:
+        this->encoding = LineScanner::Encoding::Ascii;
+        break;
+    }
+}
+void LineIndex::Append(const std::vector<LineInfo>& newLines, uint64 newCount, uint64 endOffset)
+{
+    this->end = endOffset;
+    if (newCount == 0)
+        return;
+
+    // the dense part
+    const auto dense =
+          (this->checkpoints.empty()) && (this->count < this->denseLimit) ? std::min<uint64>(newCount, this->denseLimit - this->count) : 0;
+    this->lines.insert(this->lines.end(), newLines.begin(), newLines.begin() + (size_t) dense);
+    this->count += dense;
+    if (dense == newCount)
+        return;
+
+    if (this->checkpoints.empty())
+    {
+        // the index becomes sparse => only a checkpoint is kept from every block of lines
+        this->checkpoints.reserve((size_t) (this->denseLimit / LINES_PER_CHECKPOINT) * 2);
+        for (size_t idx = 0; idx < this->lines.size(); idx += LINES_PER_CHECKPOINT)
+            this->checkpoints.push_back(this->lines[idx].offset);
+        this->lines.clear();
+        this->lines.shrink_to_fit();
+    }
+    for (auto it = newLines.begin() + (size_t) dense; it != newLines.end(); it++)
+        this->checkpoints.push_back(it->offset);
+    this->count += newCount - dense;
+}
+void LineIndex::RemoveLast()
+{
+    if (this->count == 0)
+        return;
+    this->count--;
+    if (this->checkpoints.empty())
+    {
+        this->lines.pop_back();
+        return;
+    }
+    const auto block = this->count / LINES_PER_CHECKPOINT;
+    if (this->count % LINES_PER_CHECKPOINT == 0)
+        this->checkpoints.pop_back();
+    // the block can get the same number of lines again (with a different last line)
+    for (auto& b : this->cache)
+        if (b.block == block)
+            b.block = INVALID_BLOCK;
+}
+const std::vector<LineInfo>* LineIndex::GetBlock(uint64 block)
+{
+    CHECK(block < this->checkpoints.size(), nullptr, "Invalid block: %llu", block);
+    const auto first    = block * LINES_PER_CHECKPOINT;
+    const auto expected = (size_t) std::min<uint64>(LINES_PER_CHECKPOINT, this->count - first);
+
+    // the last block is scanned again if more lines were indexed since it was cached
+    CachedBlock* result = nullptr;
+    for (auto& b : this->cache)
+    {
+        if (b.block == block)
+        {
+            if (b.lines.size() == expected)
+            {
+                b.lastUse = ++this->useCounter;
+                return &b.lines;
+            }
+            result = &b;
+            break;
+        }
+        if ((result == nullptr) || (b.lastUse < result->lastUse))
+            result = &b;
+    }
+
+    const auto start = this->checkpoints[block];
+    const auto stop  = block + 1 < this->checkpoints.size() ? this->checkpoints[block + 1] : this->end;
+    std::vector<LineScanner::Line> found;
+    found.reserve(expected);
+    LineScanner scanner(this->encoding, start, MAX_CHARS_PER_LINE);
+    for (auto pos = start; pos < stop;)
+    {
+        auto buf = this->data->Get(pos, (uint32) std::min<uint64>(stop - pos, SCAN_SIZE), false);
+        if (buf.GetLength() == 0)
+            break;
+        scanner.Scan(buf, found);
+        pos += buf.GetLength();
+    }
+    scanner.Finish(found);
+
+    result->block   = block;
+    result->lastUse = ++this->useCounter;
+    result->lines.clear();
+    for (const auto& l : found)
+    {
+        if (result->lines.size() >= expected)
+            break;
+        result->lines.emplace_back(l.offset, l.charsCount, l.size);
+    }
+    // a read error => the missing lines are reported as empty lines (their number must not change)
+    while (result->lines.size() < expected)
+        result->lines.emplace_back(stop, 0, 0);
+    return &result->lines;
+}
+LineInfo LineIndex::Get(uint64 lineNo)
+{
+    if (this->checkpoints.empty())
+        return this->lines[(size_t) lineNo];
+    const auto* block = GetBlock(lineNo / LINES_PER_CHECKPOINT);
+    if (block == nullptr)
+        return LineInfo(0, 0, 0);
+    return (*block)[lineNo % LINES_PER_CHECKPOINT];
+}
+uint64 LineIndex::OffsetToLineNo(uint64 offset)
+{
+    // the last line that starts before (or at) 'offset'
+    auto lastBefore = [offset](const std::vector<LineInfo>& li) -> size_t
+    {
+        auto it = std::upper_bound(li.begin(), li.end(), offset, [](uint64 value, const LineInfo& l) { return value < l.offset; });
+        return it == li.begin() ? 0 : (size_t) ((it - li.begin()) - 1);
+    };
+    if (this->checkpoints.empty())
+        return (uint64) lastBefore(this->lines);
+
+    auto it          = std::upper_bound(this->checkpoints.begin(), this->checkpoints.end(), offset);
+    const auto block = it == this->checkpoints.begin() ? 0 : (uint64) ((it - this->checkpoints.begin()) - 1);
+    const auto* li   = GetBlock(block);
+    if (li == nullptr)
+        return 0;
+    return block * LINES_PER_CHECKPOINT + lastBefore(*li);
+}
@@ -13,6 +13,8 @@ namespace View
 
         constexpr uint32 MAX_CHARACTERS_PER_LINE = 1024;
         constexpr uint32 MAX_LINES_TO_VIEW       = 256;
+        constexpr uint32 SUB_LINES_CACHE_SIZE    = 128;        // wrap layouts of the last used lines
+        constexpr uint32 ALL_SUB_LINES           = 0xFFFFFFFF; // the whole layout of a line is needed
 
         struct SettingsData
         {
@@ -24,12 +26,35 @@ namespace View
             SettingsData();
         };
 
+        struct SearchData
+        {
+            std::u16string text;
+            bool useRegex;
+            bool matchCase;
+            bool findAll;
+            GView::Utils::SearchEngine engine;          // the text of the last search (encoded like the object)
+            GView::Utils::RegexEngine regex;            // regular expression of the last search
+            Reference<GView::Utils::Searcher> searcher; // 'engine' or 'regex' (null before the first search)
+            GView::Utils::SearchResults results;        // all the matches (only after a "find all" search)
+            uint64 matchOffset;                         // the match found by the last FindNext / FindPrevious
+            uint32 matchSize;
+            SearchData();
+        };
+
         struct Config
         {
+            struct
+            {
+                ColorPair SearchMatch;
+            } Colors;
             struct
             {
                 AppCUI::Input::Key WordWrap;
+                AppCUI::Input::Key Follow;
+                AppCUI::Input::Key FindNext;
+                AppCUI::Input::Key FindPrevious;
             } Keys;
+            uint32 SparseIndexMinLines; // objects with more lines keep only a checkpoint for every few lines
             bool Loaded;
 
             static void Update(IniSection sect);
@@ -58,6 +83,83 @@ namespace View
             {
             }
         };
+        // the sub-lines of a line ; they are valid only for the width, tab size and wrap method that were used to compute them
+        // a layout is computed only up to the last sub-line that was needed so far and continues from there when more are needed
+        struct SubLinesLayout
+        {
+            std::vector<SubLineInfo> entries;
+            uint64 lineNo;
+            uint32 leftAlignament;
+            uint32 width;
+            uint32 tabSize;
+            WrapMethod wrapMethod;
+            uint64 lastUse;
+            uint32 nextOffset;    // where the next sub-line starts (relative to the line) if the layout is not complete
+            uint32 nextCharIndex; // index of the first character of the next sub-line
+            bool complete;        // all the sub-lines of the line are in 'entries'
+        };
+        // The lines of an object. Up to 'denseLimit' lines every line is kept ; after that only the offset of every
+        // LINES_PER_CHECKPOINT-th line is kept and the lines between two checkpoints are scanned again when needed (the
+        // last scanned blocks are cached) => the memory stays bounded for objects with hundreds of millions of lines.
+        class LineIndex
+        {
+            static constexpr uint32 CACHED_BLOCKS = 32;
+            struct CachedBlock
+            {
+                uint64 block;
+                uint64 lastUse;
+                std::vector<LineInfo> lines;
+            };
+            std::vector<LineInfo> lines;     // every line (until the index becomes sparse)
+            std::vector<uint64> checkpoints; // offset of the lines 0, N, 2N, ... (sparse index)
+            CachedBlock cache[CACHED_BLOCKS];
+            Reference<GView::Utils::DataCache> data;
+            uint64 count;
+            uint64 end; // offset after the last indexed line
+            uint64 denseLimit;
+            uint64 useCounter;
+            LineScanner::Encoding encoding;
+
+            const std::vector<LineInfo>* GetBlock(uint64 block);
+
+          public:
+            static constexpr uint32 LINES_PER_CHECKPOINT = 256;
+            static constexpr uint32 MAX_CHARS_PER_LINE   = 2001; // longer lines are split
+
+            LineIndex();
+
+            void Reset(GView::Utils::DataCache& cache, CharacterEncoding::Encoding textEncoding, uint64 denseLinesLimit, uint64 reserve);
+            // 'newLines' has every line with an index smaller than the dense limit and, after it, only the checkpoints
+            void Append(const std::vector<LineInfo>& newLines, uint64 newCount, uint64 endOffset);
+            void RemoveLast();
+            LineInfo Get(uint64 lineNo); // 'lineNo' must be smaller than GetCount()
+            uint64 OffsetToLineNo(uint64 offset);
+
+            inline uint64 GetCount() const
+            {
+                return count;
+            }
+            inline bool IsEmpty() const
+            {
+                return count == 0;
+            }
+            inline bool IsSparse() const
+            {
+                return count > denseLimit;
+            }
+            inline LineInfo GetLast()
+            {
+                return Get(count - 1);
+            }
+            inline uint64 GetDenseLimit() const
+            {
+                return denseLimit;
+            }
+            inline LineScanner::Encoding GetEncoding() const
+            {
+                return encoding;
+            }
+        };
         class Instance : public View::ViewControl
         {
             enum class Direction
@@ -71,7 +173,7 @@ namespace View
                 Text,
                 Border
             };
-            std::vector<LineInfo> lines;      
+            LineIndex lines;
             Utils::Selection selection;
             Pointer<SettingsData> settings;
             Reference<GView::Object> obj;
@@ -84,14 +186,35 @@ namespace View
 
             struct
             {
-                std::vector<SubLineInfo> entries;
-                uint32 lineNo;
-                uint32 leftAlignament;
-            } SubLines;
+                std::thread worker;
+                std::mutex lock;
+                std::condition_variable published; // new lines were added to 'pending'
+                std::vector<LineInfo> pending;     // lines found by the worker that were not moved into 'lines' yet
+                uint64 pendingCount;               // lines represented by 'pending' (it only has the checkpoints of a sparse index)
+                std::atomic<uint64> indexedSize;   // bytes of the object that were already indexed
+                std::atomic<bool> stop;
+                bool completed;                    // the worker has published all the lines (protected by 'lock')
+                bool merged;                       // 'lines' has all the lines of the object
+                uint64 estimatedCount;             // total number of lines (an estimation until 'merged' is set)
+                uint64 pendingGoTo;                // offset (that was not indexed yet) requested by GoTo
+                bool replaceLast;                  // the first published line replaces the last line (the object grew)
+            } Indexer;
+            struct
+            {
+                bool enabled;                          // the size of the file is polled in background and the appended data is indexed
+                bool autoScroll;                       // the cursor moves to the new end of the object if it was on the last line
+                bool toEnd;                            // move to the end of the object when the new lines are indexed
+                uint64 polledSize;                     // size reported by 'watcher' when the object was updated last time
+                GView::Utils::FileSizeWatcher watcher; // running only while 'enabled' is set
+            } Follow;
+            SearchData search;
+            SubLinesLayout SubLines;                            // layout of the last used line
+            SubLinesLayout SubLinesCache[SUB_LINES_CACHE_SIZE]; // layouts of the lines used before it (LRU)
+            uint64 subLinesUseCounter;
             struct
             {
                 uint64 pos;
-                uint32 lineNo;
+                uint64 lineNo;
                 uint32 sublineNo;
                 uint32 charIndex;
             } Cursor;
@@ -99,15 +222,22 @@ namespace View
             {
                 struct
                 {
-                    uint32 lineNo, subLineNo;
+                    uint64 lineNo;
+                    uint32 subLineNo;
                 } Start, End;
                 struct
                 {
                     uint64 offset;
                     uint32 size;
-                    uint32 lineNo;
+                    uint64 lineNo;
                     uint32 xStart;
                     uint32 lineCharIndex;
+                    struct
+                    {
+                        uint32 x; // x offset of the character from 'bufPos' (smaller than scrollX)
+                        uint32 bufPos;
+                        uint32 charIndex;
+                    } scrollStart; // where the decoding starts when the line is scrolled horizontally
                 } Lines[MAX_LINES_TO_VIEW];
                 uint32 scrollX;
                 uint32 linesCount;
@@ -125,21 +255,32 @@ namespace View
             void OpenCurrentSelection();
 
             void RecomputeLineIndexes();
-            void CommputeViewPort_NoWrap(uint32 lineNo, Direction dir);
-            void CommputeViewPort_Wrap(uint32 lineNo, uint32 subLineNo, Direction dir);
-            void ComputeViewPort(uint32 lineNo, uint32 subLineNo, Direction dir);
-
-            bool GetLineInfo(uint32 lineNo, LineInfo& li);
-            LineInfo GetLineInfo(uint32 lineNo);
-            void ComputeSubLineIndexes(uint32 lineNo, BufferView& buf, uint64& startOffset);
-            void ComputeSubLineIndexes(uint32 lineNo);
+            void StartLineIndexing(uint64 start, uint64 end, uint64 firstLine);
+            void IndexLines(GView::Utils::DataCache& cache, uint64 start, uint64 end, uint64 firstLine);
+            void StopLineIndexing();
+            void FollowObjectGrowth();
+            void SetFollowMode(bool enabled);
+            bool UpdateLineIndexes();
+            void UpdateLineNumberWidth();
+            uint64 OffsetToLineNo(uint64 offset);
+            void CommputeViewPort_NoWrap(uint64 lineNo, Direction dir);
+            void CommputeViewPort_Wrap(uint64 lineNo, uint32 subLineNo, Direction dir);
+            void ComputeViewPort(uint64 lineNo, uint32 subLineNo, Direction dir);
+
+            bool GetLineInfo(uint64 lineNo, LineInfo& li);
+            LineInfo GetLineInfo(uint64 lineNo);
+            void ComputeSubLineIndexes(uint64 lineNo, uint32 subLinesCount, uint32 charIndex);
+            void ComputeSubLineIndexes(uint64 lineNo);
+            uint32 ComputeSubLineNo(uint64 lineNo, uint32 charIndex);
+            bool LoadSubLinesLayout(uint64 lineNo, uint32 width);
+            void ResetSubLinesCache();
             uint32 CharacterIndexToSubLineNo(uint32 charIndex);
             
             void DrawLine(uint32 viewDataIndex, Graphics::Renderer& renderer, ControlState state, bool showLineNumber);
 
-            void MoveTo(uint32 lineNo, uint32 charIndex, bool select);
-            void MoveToStartOfLine(uint32 lineNo, bool select);
-            void MoveToEndOfLine(uint32 lineNo, bool select);
+            void MoveTo(uint64 lineNo, uint32 charIndex, bool select);
+            void MoveToStartOfLine(uint64 lineNo, bool select);
+            void MoveToEndOfLine(uint64 lineNo, bool select);
             void MoveToEndOfFile(bool select);
             void MoveLeft(bool select);
             void MoveToNextWord(bool select);
@@ -162,12 +303,19 @@ namespace View
             }
             void SetWrapMethod(WrapMethod method);
 
-            void MousePosToTextOffset(int x, int y, uint32& lineNo, uint32& charIndex);
+            void MousePosToTextOffset(int x, int y, uint64& lineNo, uint32& charIndex);
+
+            void MoveToMatch(uint64 offset, uint32 size);
+            void FindNext();
+            void FindPrevious();
+            void FindAll();
 
           public:
             Instance(const std::string_view& name, Reference<GView::Object> obj, Settings* settings);
+            virtual ~Instance() override;
 
             virtual void Paint(Graphics::Renderer& renderer) override;
+            virtual bool OnFrameUpdate() override;
             virtual bool OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar) override;
             virtual bool OnKeyEvent(AppCUI::Input::Key keyCode, char16 characterCode) override;
             virtual bool OnEvent(Reference<Control>, Event eventType, int ID) override;
@@ -204,7 +352,7 @@ namespace View
             Reference<RadioBox> rbFileOffset;
             Reference<TextField> txFileOffset;
             uint64 maxSize;
-            uint32 maxLines;
+            uint64 maxLines;
             uint64 resultedPos;
             bool gotoLine;
             
@@ -212,22 +360,37 @@ namespace View
             void Validate();
 
           public:
-            GoToDialog(uint64 currentPos, uint64 size, uint32 currentLine, uint32 maxLines);
+            GoToDialog(uint64 currentPos, uint64 size, uint64 currentLine, uint64 maxLines);
 
             virtual bool OnEvent(Reference<Control>, Event eventType, int ID) override;
             inline uint64 GetFileOffset() const
             {
                 return resultedPos;
             }
-            inline uint32 GetLine() const
+            inline uint64 GetLine() const
             {
-                return static_cast<uint32>(resultedPos - 1);
+                return resultedPos - 1;
             }
             inline bool ShouldGoToLine() const
             {
                 return gotoLine;
             }
         };
+        class FindDialog : public Window
+        {
+            Reference<SearchData> search;
+            Reference<TextField> txPattern;
+            Reference<CheckBox> cbRegex;
+            Reference<CheckBox> cbMatchCase;
+            CharacterEncoding::Encoding encoding;
+
+            void Validate(bool findAll);
+
+          public:
+            FindDialog(Reference<SearchData> search, CharacterEncoding::Encoding encoding);
+
+            virtual bool OnEvent(Reference<Control>, Event eventType, int ID) override;
+        };
 
     } // namespace TextViewer
 } // namespace View
@@ -2,8 +2,16 @@
 
 #include "GView.hpp"
 
+#include <atomic>
+#include <bitset>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <queue>
 #include <set>
 #include <span>
+#include <thread>
 
 using namespace AppCUI::Controls;
 using namespace AppCUI::Graphics;
@@ -106,17 +114,34 @@ namespace Utils
 
     class ZonesList
     {
+        struct Segment
+        {
+            uint64 start;
+            uint32 zone; // index in 'list' (0xFFFFFFFF for a gap between zones)
+        };
         Zone* list;
         Zone* lastZone;
         unsigned int count, allocated;
         unsigned long long cacheStart, cacheEnd;
+        std::vector<Segment> segments; // sorted, disjoint ranges with the zone that wins over them (built at the first lookup)
+        bool indexed;
+
+        void BuildIndex();
 
       public:
         ZonesList();
         ~ZonesList();
         bool Add(uint64 start, uint64 end, AppCUI::Graphics::ColorPair c, std::string_view txt);
+        // allocates exactly 'count' zones (call it before adding a known number of zones)
         bool Reserve(unsigned int count);
+        void Clear();
+        inline uint32 GetCount() const
+        {
+            return count;
+        }
         const Zone* OffsetToZone(uint64 offset);
+        // 'runEnd' is the last offset (after 'offset') that is in the same zone (or in the same gap between zones)
+        const Zone* OffsetToZone(uint64 offset, uint64& runEnd);
     };
 
     struct UnicodeString
@@ -273,6 +298,531 @@ namespace Utils
         UnicodeString ConvertToUnicode16(BufferView buf);
         BufferView GetBOMForEncoding(Encoding encoding);
     }; // namespace CharacterEncoding
+
+    // a process object exposes the memory regions of a process one after another (without the gaps between them)
+    struct ProcessRegion
+    {
+        uint64 address;
+        uint64 size;
+        uint64 offset; // offset of the region in the process object
+        bool readable;
+        char permissions[5];
+        std::string name;
+    };
+    class ProcessRegionsMap
+    {
+        std::vector<ProcessRegion> regions;
+        uint64 size;
+
+      public:
+        ProcessRegionsMap();
+        bool Load(uint32 pid);
+        int32 OffsetToRegion(uint64 offset) const;
+        uint64 AddressToOffset(uint64 address) const; // INVALID_OFFSET if the address is not mapped
+        uint64 OffsetToAddress(uint64 offset) const;  // INVALID_OFFSET if the offset is outside the object
+
+        inline const std::vector<ProcessRegion>& GetRegions() const
+        {
+            return regions;
+        }
+        inline uint64 GetSize() const
+        {
+            return size;
+        }
+    };
+    // reads the memory of a live process (Linux: /proc/<pid>/mem) ; unreadable pages are zero-filled
+    class ProcessDataObject : public AppCUI::OS::DataObject
+    {
+        ProcessRegionsMap map;
+        uint64 pos;
+        int32 handle;
+
+        void ReadRegion(uint64 address, uint8* buffer, uint64 size);
+
+      public:
+        ProcessDataObject();
+        ~ProcessDataObject();
+
+        bool Open(uint32 pid);
+        inline const ProcessRegionsMap& GetRegionsMap() const
+        {
+            return map;
+        }
+
+        bool ReadBuffer(void* buffer, uint32 bufferSize, uint32& bytesRead) override;
+        bool WriteBuffer(const void* buffer, uint32 bufferSize, uint32& bytesWritten) override;
+        uint64 GetSize() override;
+        uint64 GetCurrentPos() const override;
+        bool SetSize(uint64 newSize) override;
+        bool SetCurrentPos(uint64 newPosition) override;
+        void Close() override;
+    };
+
+    struct SearchMatch
+    {
+        uint64 offset;
+        uint32 size;
+        uint32 patternIndex;
+    };
+    // common interface of the search engines (byte patterns, regular expressions)
+    class Searcher
+    {
+      public:
+        virtual ~Searcher() = default;
+
+        // upper limit for the size of a match
+        virtual uint32 GetMaxMatchSize() const = 0;
+        // calls onMatch (in offset order) for every match from [offset, offset+size) ; returning false from onMatch stops the search
+        // returns false if the search was canceled or the data could not be read
+        virtual bool Search(
+              DataCache& cache,
+              uint64 offset,
+              uint64 size,
+              const std::function<bool(const SearchMatch&)>& onMatch,
+              const std::atomic<bool>* cancel = nullptr,
+              std::atomic<uint64>* progress   = nullptr) const = 0;
+
+        // runs Search on a worker thread (with its own reader) while the UI thread shows a progress window (ESC cancels)
+        // onMatch is called from the worker thread
+        bool SearchWithProgress(
+              Reference<GView::Object> obj,
+              uint64 offset,
+              uint64 size,
+              std::string_view title,
+              const std::function<bool(const SearchMatch&)>& onMatch) const;
+    };
+    // searches several byte patterns at once (hex patterns with ?? wildcards, ASCII/UTF-8/UTF-16 text, optionally case insensitive)
+    class SearchEngine : public Searcher
+    {
+        struct Pattern
+        {
+            // a byte from the pattern matches 'b' if ((b & andMask) | orMask) == value (wildcards have andMask = 0)
+            std::vector<uint8> value, andMask, orMask;
+            uint32 anchor; // offset of the (rarest) fixed byte(s) that are searched first
+            bool twoBytesAnchor;
+        };
+        std::vector<Pattern> patterns;
+        uint32 maxPatternSize;
+
+        bool AddPattern(Pattern& p);
+        void SearchPattern(uint32 index, BufferView buf, uint64 bufOffset, uint32 skip, std::vector<SearchMatch>& matches) const;
+
+      public:
+        // a match may cross the border between two chunks => the last (MAX_PATTERN_SIZE-1) bytes of a chunk are kept
+        static constexpr uint32 MAX_PATTERN_SIZE = SequentialReader::MAX_KEEP_BYTES + 1;
+
+        SearchEngine();
+        void Clear();
+        bool AddHexPattern(std::string_view text);
+        bool AddBytesPattern(BufferView bytes);
+        bool AddTextPattern(std::u16string_view text, CharacterEncoding::Encoding encoding, bool ignoreCase);
+        inline uint32 GetPatternsCount() const
+        {
+            return (uint32) patterns.size();
+        }
+        inline uint32 GetMaxPatternSize() const
+        {
+            return maxPatternSize;
+        }
+
+        // adds (sorted by offset) the matches from 'buf' (bufOffset = file offset of its first byte) that end after its first
+        // 'skip' bytes (the bytes kept from the previous chunk)
+        void SearchBuffer(BufferView buf, uint64 bufOffset, uint32 skip, std::vector<SearchMatch>& matches) const;
+
+        uint32 GetMaxMatchSize() const override;
+        bool Search(
+              DataCache& cache,
+              uint64 offset,
+              uint64 size,
+              const std::function<bool(const SearchMatch&)>& onMatch,
+              const std::atomic<bool>* cancel = nullptr,
+              std::atomic<uint64>* progress   = nullptr) const override;
+    };
+    // regular expressions over bytes, compiled to NFAs and searched with lazily built DFAs (no backtracking) ; the data is
+    // scanned once and every match is then read again at most once (plus a backward pass over 32 KB when a match is not in
+    // the window of the previous one)
+    // supported syntax: literals, . (any byte), [...] / [^...], \d \w \s (and \D \W \S), \xHH, \n \r \t \0, groups ( ) and
+    // (?: ), alternation | and the quantifiers * + ? {n} {n,} {n,m} ; matches are leftmost-longest, never empty and at most
+    // MAX_MATCH_SIZE bytes long
+    class RegexEngine : public Searcher
+    {
+      public:
+        enum class NfaStateType : uint8
+        {
+            Bytes,   // consumes a byte from 'bytes' and goes to 'out'
+            Split,   // goes to both 'out' and 'out1'
+            Epsilon, // goes to 'out'
+            Match
+        };
+        struct NfaState
+        {
+            std::bitset<256> bytes;
+            uint32 out, out1;
+            NfaStateType type;
+        };
+        struct Nfa
+        {
+            std::vector<NfaState> states;
+            uint32 start;
+        };
+
+      private:
+        Nfa nfa;
+        Nfa reverseNfa; // the reversed expression (finds where matches start)
+
+      public:
+        static constexpr uint32 MAX_MATCH_SIZE = 0x1000;
+
+        RegexEngine();
+        void Clear();
+        bool Compile(std::string_view pattern, bool ignoreCase, String& error);
+        inline bool IsCompiled() const
+        {
+            return !nfa.states.empty();
+        }
+
+        uint32 GetMaxMatchSize() const override;
+        bool Search(
+              DataCache& cache,
+              uint64 offset,
+              uint64 size,
+              const std::function<bool(const SearchMatch&)>& onMatch,
+              const std::atomic<bool>* cancel = nullptr,
+              std::atomic<uint64>* progress   = nullptr) const override;
+    };
+    // what a scan found in an object (filled by RuleEngine::AddMatch, checked by RuleEngine::IsMatching)
+    struct RuleScanResult
+    {
+        std::vector<uint64> counts;       // number of matches for every string
+        std::vector<bool> ranges;         // the offset conditions ($a at N / $a in (A..B)) that have a match
+        std::vector<SearchMatch> matches; // the first MAX_STORED_MATCHES matches (patternIndex is the index of the string)
+        uint64 objectSize;
+    };
+    // a subset of the YARA rules syntax:
+    //     rule name { strings: $a = "text" nocase wide ascii   $b = { 4D 5A ?? 00 4? [2] FF }   condition: $a and not $b at 0 }
+    // conditions use and / or / not / ( ), true, false, $a, $a at N, $a in (A..B), #a <op> N, filesize <op> N and
+    // any / all / N of them / of ($a, $b*). All the strings of all the rules are searched in a single pass: an atom (up to
+    // MAX_ATOM_SIZE fixed bytes) of every string is added to one Aho-Corasick automaton and the string is verified around
+    // every atom hit. Regular expression strings are not supported.
+    class RuleEngine : public Searcher
+    {
+      public:
+        enum class ConditionType : uint8
+        {
+            True,
+            False,
+            And,
+            Or,
+            Not,
+            StringFound,   // $a
+            StringInRange, // $a at N, $a in (A..B)
+            StringCount,   // #a <op> N
+            FileSize,      // filesize <op> N
+            OfStrings      // N of (...)
+        };
+        enum class CompareOperation : uint8
+        {
+            Equal,
+            Different,
+            Less,
+            LessOrEqual,
+            Greater,
+            GreaterOrEqual
+        };
+        struct Condition
+        {
+            std::vector<uint32> strings; // OfStrings
+            uint64 value;                // StringCount, FileSize, OfStrings (needed matches) or the index of the range
+            uint32 left, right;          // operands (And, Or, Not) or the string index
+            ConditionType type;
+            CompareOperation operation;
+        };
+        struct Pattern
+        {
+            // a byte 'b' matches if (b & mask) == value ; for ignoreCase patterns 'b' is converted to lower case first
+            std::vector<uint8> value, mask;
+            uint32 stringIndex;
+            uint32 atomOffset, atomSize;
+            bool ignoreCase;
+        };
+        struct RuleString
+        {
+            std::string name;
+            std::vector<uint32> ranges; // the offset conditions that use this string
+            uint32 rule;
+        };
+        struct OffsetRange
+        {
+            uint64 start, end; // inclusive
+            uint32 stringIndex;
+        };
+        struct Rule
+        {
+            std::string name;
+            uint32 condition;
+            uint32 firstString, stringsCount;
+        };
+        struct Program
+        {
+            std::vector<Rule> rules;
+            std::vector<RuleString> strings;
+            std::vector<Pattern> patterns;
+            std::vector<OffsetRange> ranges;
+            std::vector<Condition> conditions;
+        };
+
+      private:
+        Program program;
+        std::vector<uint32> transitions; // Aho-Corasick automaton (256 transitions for every state)
+        std::vector<uint32> outputStart; // patterns whose atom ends in state S: outputs[outputStart[S] .. outputStart[S+1])
+        std::vector<uint32> outputs;
+        uint32 maxPatternSize;
+
+        bool BuildAutomaton(String& error);
+        bool Evaluate(uint32 condition, const RuleScanResult& result) const;
+
+      public:
+        static constexpr uint32 MAX_ATOM_SIZE      = 4;
+        static constexpr uint32 MAX_STRING_SIZE    = SequentialReader::MAX_KEEP_BYTES + 1;
+        static constexpr uint32 MAX_STATES         = 0x8000; // 32 MB of transitions
+        static constexpr size_t MAX_STORED_MATCHES = 100000;
+
+        RuleEngine();
+        void Clear();
+        bool Compile(std::string_view text, String& error);
+        inline bool IsCompiled() const
+        {
+            return !program.rules.empty();
+        }
+        inline uint32 GetRulesCount() const
+        {
+            return (uint32) program.rules.size();
+        }
+        inline std::string_view GetRuleName(uint32 index) const
+        {
+            return program.rules[index].name;
+        }
+        inline std::string_view GetStringName(uint32 index) const
+        {
+            return program.strings[index].name;
+        }
+        inline uint32 GetStringRule(uint32 index) const
+        {
+            return program.strings[index].rule;
+        }
+
+        void InitResult(RuleScanResult& result, uint64 objectSize) const;
+        void AddMatch(RuleScanResult& result, const SearchMatch& match) const;
+        bool IsMatching(uint32 rule, const RuleScanResult& result) const;
+        // a single pass over the entire object
+        bool Scan(DataCache& cache, RuleScanResult& result, const std::atomic<bool>* cancel = nullptr) const;
+
+        // reports the matches of all the strings (patternIndex is the index of the string)
+        uint32 GetMaxMatchSize() const override;
+        bool Search(
+              DataCache& cache,
+              uint64 offset,
+              uint64 size,
+              const std::function<bool(const SearchMatch&)>& onMatch,
+              const std::atomic<bool>* cancel = nullptr,
+              std::atomic<uint64>* progress   = nullptr) const override;
+    };
+    // all the matches of a search (sorted by offset) ; offsets and sizes are kept in separate arrays so that millions of
+    // matches can be stored and binary searched
+    class SearchResults
+    {
+        std::vector<uint64> offsets;
+        std::vector<uint32> sizes;
+        uint32 maxSize;
+
+      public:
+        SearchResults();
+        void Clear();
+        void Add(uint64 offset, uint32 size); // matches must be added in offset order
+        inline size_t GetCount() const
+        {
+            return offsets.size();
+        }
+        inline uint64 GetOffset(size_t index) const
+        {
+            return offsets[index];
+        }
+        inline uint32 GetSize(size_t index) const
+        {
+            return sizes[index];
+        }
+        inline uint32 GetMaxSize() const
+        {
+            return maxSize;
+        }
+        // index of the first match that starts at or after 'offset' (GetCount() if there is none)
+        size_t LowerBound(uint64 offset) const;
+        // index of the first match that may overlap with [offset, ...) => a match that ends after 'offset' can only start after
+        // (offset - maxSize)
+        inline size_t FirstOverlapping(uint64 offset) const
+        {
+            return LowerBound(offset >= maxSize ? offset - maxSize + 1 : 0);
+        }
+    };
+
+    struct StringRange
+    {
+        uint64 offset;
+        uint32 size;  // in bytes
+        bool unicode; // UTF-16LE (otherwise ASCII)
+    };
+    // extracts (on a worker thread) the ASCII and UTF-16LE strings of an object into an index sorted by offset ; the strings do
+    // not overlap, so the index can be binary searched from the UI thread while the extraction is still running
+    class StringsExtractor
+    {
+        std::deque<StringRange> strings;
+        mutable std::mutex lock;
+        std::thread worker;
+        std::atomic<bool> stop;
+        std::atomic<bool> completed;
+        std::atomic<uint64> indexedSize; // the index is final for [0, indexedSize)
+        std::atomic<uint64> scannedSize;
+        uint64 objectSize;
+        uint32 minCount;
+        bool asciiMask[256];
+
+        void Run(std::unique_ptr<DataCache> reader);
+        bool Publish(std::vector<StringRange>& found, uint64 stableOffset);
+
+      public:
+        static const bool DefaultAsciiMask[256];
+        static constexpr uint32 DEFAULT_MIN_COUNT = 4;
+        static constexpr size_t MAX_STRINGS       = 0x1000000; // 256 MB of index ; the rest of the object is not indexed
+
+        StringsExtractor();
+        ~StringsExtractor();
+
+        // (re)starts the extraction ; a string is a sequence of at least 'minCount' characters from 'mask' (as bytes or as
+        // UTF-16LE characters whose high byte is 0)
+        bool Start(Reference<GView::Object> obj, const bool mask[256], uint32 minCount);
+        void Stop();
+        bool HasSettings(const bool mask[256], uint32 minCount) const;
+
+        inline bool IsCompleted() const
+        {
+            return completed.load(std::memory_order_acquire);
+        }
+        inline uint64 GetIndexedSize() const
+        {
+            return indexedSize.load(std::memory_order_acquire);
+        }
+        inline uint64 GetScannedSize() const
+        {
+            return scannedSize.load(std::memory_order_relaxed);
+        }
+        inline uint64 GetObjectSize() const
+        {
+            return objectSize;
+        }
+        size_t GetCount() const;
+        bool GetString(size_t index, StringRange& result) const;
+        // O(log n) ; returns false if 'offset' was not indexed yet. Otherwise 'result' is the string that contains 'offset' or,
+        // if 'offset' is not part of a string, result.size is 0 and 'gapEnd' is where the next string (or the unindexed data) starts
+        bool Find(uint64 offset, StringRange& result, uint64& gapEnd) const;
+    };
+    // the strings extractors of an object, one for each set of settings (views with other settings do not restart the
+    // extraction used by the Strings panel or by each other) ; an extractor is started the first time its settings are needed
+    class StringsExtractorList
+    {
+        std::vector<std::unique_ptr<StringsExtractor>> extractors;
+        Reference<GView::Object> obj;
+
+      public:
+        // folders and processes (an address space of several GB that is mostly unmapped) are never indexed
+        void Init(Reference<GView::Object> obj);
+        // null if the strings of this object are not indexed
+        Reference<StringsExtractor> Get(const bool mask[256], uint32 minCount);
+        inline Reference<StringsExtractor> GetDefault()
+        {
+            return Get(StringsExtractor::DefaultAsciiMask, StringsExtractor::DEFAULT_MIN_COUNT);
+        }
+        inline bool IsEnabled() const
+        {
+            return obj.IsValid();
+        }
+    };
+
+    // a fixed set of worker threads, each with its own queue of tasks. A worker runs the last task that it queued (tasks
+    // usually queue their sub-tasks, like the files of a folder, on the same worker) and, when its queue is empty, steals
+    // the oldest task from the queues of the other workers
+    class WorkStealingPool
+    {
+      public:
+        using Task = std::function<void(uint32 worker)>;
+
+      private:
+        struct Queue
+        {
+            std::mutex lock;
+            std::deque<Task> tasks;
+        };
+        std::unique_ptr<Queue[]> queues;
+        std::vector<std::thread> threads;
+        std::mutex lock;
+        std::condition_variable workAvailable, allDone;
+        std::atomic<int64> queued;   // tasks waiting in the queues (may be briefly negative)
+        std::atomic<uint64> pending; // queued or running tasks
+        std::atomic<uint32> nextQueue;
+        std::atomic<bool> stop;
+        uint32 count;
+
+        bool Pop(uint32 worker, Task& task);
+        void Run(uint32 worker);
+
+      public:
+        static constexpr uint32 MAX_WORKERS = 64;
+
+        WorkStealingPool();
+        ~WorkStealingPool();
+
+        // 0 workers => one for every hardware thread
+        bool Start(uint32 workers = 0);
+        // waits for the running tasks ; the queued tasks that did not start are dropped (a worker checks the stop request
+        // before it takes a new task)
+        void Stop();
+        inline uint32 GetWorkersCount() const
+        {
+            return count;
+        }
+
+        // 'worker' is the index of the worker that runs the current task (or any other value when called from outside the pool)
+        void Push(Task task, uint32 worker = MAX_WORKERS);
+        // true if all the tasks were completed (or dropped by Stop)
+        bool Wait(std::chrono::milliseconds timeout);
+    };
+
+    // polls the size of a file on a background thread => a view that follows the file notices that it changed (even when it
+    // is idle) without checking the file on every paint
+    class FileSizeWatcher
+    {
+        std::filesystem::path path;
+        std::thread thread;
+        std::mutex lock;
+        std::condition_variable stopRequested;
+        std::atomic<uint64> size; // last polled size (INVALID_OFFSET if it could not be read)
+        bool stop;
+
+        void Run();
+
+      public:
+        static constexpr std::chrono::milliseconds POLL_INTERVAL{ 250 };
+
+        FileSizeWatcher();
+        ~FileSizeWatcher();
+
+        // the size is read once on the caller's thread and then every POLL_INTERVAL (until Stop is called)
+        bool Start(std::u16string_view filePath);
+        void Stop();
+        inline uint64 GetSize() const
+        {
+            return size.load(std::memory_order_relaxed);
+        }
+    };
 } // namespace Utils
 
 namespace Generic
@@ -312,19 +862,25 @@ namespace Type
         bool PopulateWindow(Reference<GView::View::WindowInterface> win);
     } // namespace FolderViewPlugin
 
+    namespace ProcessViewPlugin
+    {
+        TypeInterface* CreateInstance(uint32 pid, const GView::Utils::ProcessRegionsMap& map);
+        bool PopulateWindow(Reference<GView::View::WindowInterface> win);
+    } // namespace ProcessViewPlugin
+
+    class Plugin;
     namespace Matcher
     {
+        // the buffer is converted to UTF-16 only when the text is first requested (binary buffers are never converted)
         class TextParser
         {
+            AppCUI::Utils::BufferView buffer;
+            GView::Utils::UnicodeString unicode;
             struct
             {
                 const char16* text;
                 uint32 size;
-            } Raw;
-            struct
-            {
-                const char16* text;
-                uint32 size;
+                bool computed;
             } Text;
             struct
             {
@@ -332,12 +888,17 @@ namespace Type
                 uint32 count;
                 bool computed;
             } Lines;
+            void ComputeText();
             void ComputeLineOffsets();
 
           public:
-            TextParser(const char16* text, uint32 size);
-            inline std::u16string_view GetText() const
+            TextParser(AppCUI::Utils::BufferView buf);
+            TextParser(const TextParser&) = delete;
+            ~TextParser();
+            inline std::u16string_view GetText()
             {
+                if (!Text.computed)
+                    ComputeText();
                 return { Text.text, static_cast<size_t>(Text.size) };
             }
             inline std::span<uint32> GetLines()
@@ -346,11 +907,23 @@ namespace Type
                     ComputeLineOffsets();
                 return std::span<uint32>(this->Lines.offsets, static_cast<size_t>(this->Lines.count));
             }
+            // true if the buffer was converted to UTF-16 (only text buffers are, and only if GetText/GetLines was called)
+            inline bool WasDecoded() const
+            {
+                return (Text.computed) && (Text.size > 0);
+            }
+        };
+        enum class Kind : uint8
+        {
+            Magic,
+            StartsWith,
+            LineStartsWith
         };
         struct Interface
         {
             virtual bool Init(std::string_view text)                            = 0;
             virtual bool Match(AppCUI::Utils::BufferView buf, TextParser& text) = 0;
+            virtual Kind GetKind() const                                        = 0;
         };
         class MagicMatcher : public Interface
         {
@@ -361,14 +934,28 @@ namespace Type
                 uint32 u32[4];
                 uint64 u64[2];
             };
+            uint32 offset; // magic@<offset>:...
             uint8 count;
 
           public:
-            MagicMatcher() : count(0)
+            MagicMatcher(uint32 _offset = 0) : offset(_offset), count(0)
             {
             }
             virtual bool Init(std::string_view text) override;
             virtual bool Match(AppCUI::Utils::BufferView buf, TextParser& text) override;
+            virtual Kind GetKind() const override
+            {
+                return Kind::Magic;
+            }
+            inline uint32 GetOffset() const
+            {
+                return offset;
+            }
+            inline BufferView GetBytes() const
+            {
+                return BufferView(u8, count);
+            }
+            bool SetBytes(BufferView bytes);
         };
         class StartsWithMatcher : public Interface
         {
@@ -377,6 +964,14 @@ namespace Type
           public:
             virtual bool Init(std::string_view text) override;
             virtual bool Match(AppCUI::Utils::BufferView buf, TextParser& text) override;
+            virtual Kind GetKind() const override
+            {
+                return Kind::StartsWith;
+            }
+            inline std::string_view GetValue() const
+            {
+                return value.ToStringView();
+            }
         };
         class LineStartsWithMatcher : public Interface
         {
@@ -386,8 +981,86 @@ namespace Type
           public:
             virtual bool Init(std::string_view text) override;
             virtual bool Match(AppCUI::Utils::BufferView buf, TextParser& text) override;
+            virtual Kind GetKind() const override
+            {
+                return Kind::LineStartsWith;
+            }
+            inline std::string_view GetValue() const
+            {
+                return value.ToStringView();
+            }
         };
         Interface* CreateFromString(std::string_view stringRepresentation);
+
+        // prefix tree with a first symbol jump table ; every node that ends a pattern keeps the list of plugins that use it
+        class SignatureTrie
+        {
+            static constexpr uint32 NONE = 0xFFFFFFFF;
+            struct Node
+            {
+                uint32 child, sibling, matches;
+                uint16 symbol;
+            };
+            struct MatchEntry
+            {
+                uint32 plugin, next;
+            };
+            uint32 root[256];
+            std::vector<Node> nodes;
+            std::vector<MatchEntry> matches;
+
+            uint32 FindChild(uint32 node, uint16 symbol) const;
+
+          public:
+            SignatureTrie();
+            void Add(const uint8* pattern, uint32 size, uint32 pluginIndex);
+            template <typename T>
+            void Match(const T* p, const T* e, std::vector<bool>& candidates) const;
+            inline bool Empty() const
+            {
+                return nodes.empty();
+            }
+        };
+        class SignatureIndex;
+        // candidates found by SignatureIndex::Match ; text patterns are evaluated (and the text is converted) only when
+        // a plugin that has text patterns is queried
+        class SignatureMatches
+        {
+            const SignatureIndex* index;
+            TextParser* text;
+            std::vector<bool> candidates;
+            std::vector<bool> magics; // candidates found by a magic (bytes at a fixed offset)
+            bool textEvaluated;
+
+            friend class SignatureIndex;
+
+          public:
+            SignatureMatches();
+            bool IsCandidate(uint32 pluginIndex);
+            inline bool IsMagicCandidate(uint32 pluginIndex) const
+            {
+                return (pluginIndex < this->magics.size()) && (this->magics[pluginIndex]);
+            }
+        };
+        // the patterns of all type plugins compiled once (at startup) => one pass over the buffer/text yields all candidates
+        class SignatureIndex
+        {
+            std::vector<std::pair<uint32, SignatureTrie>> magics; // grouped by offset
+            SignatureTrie startsWith;
+            SignatureTrie lineStartsWith;
+            std::vector<bool> usesText; // plugins with startswith / linestartswith patterns
+            uint32 pluginsCount;
+
+          public:
+            SignatureIndex();
+            void Build(const std::vector<Plugin>& plugins);
+            void Match(AppCUI::Utils::BufferView buf, TextParser& text, SignatureMatches& matches) const;
+            void MatchText(TextParser& text, std::vector<bool>& candidates) const;
+            inline bool UsesText(uint32 pluginIndex) const
+            {
+                return (pluginIndex < this->pluginsCount) && (this->usesText[pluginIndex]);
+            }
+        };
     } // namespace Matcher
 
     struct PluginCommand
@@ -396,6 +1069,7 @@ namespace Type
         Input::Key key;
     };
 
+    class PluginRegistry;
     class Plugin
     {
         Matcher::Interface* pattern;
@@ -414,10 +1088,13 @@ namespace Type
 
         bool LoadPlugin();
 
+        friend class PluginRegistry;
+
       public:
         Plugin();
         bool Init(AppCUI::Utils::IniSection section);
         void Init();
+        bool Load();
         bool MatchExtension(uint64 extensionHash);
         bool MatchContent(AppCUI::Utils::BufferView buf, Matcher::TextParser& textParser);
         bool IsOfType(AppCUI::Utils::BufferView buf, GView::Type::Matcher::TextParser& textParser);
@@ -439,9 +1116,37 @@ namespace Type
         {
             return commands;
         }
+        inline uint32 GetPatternsCount() const
+        {
+            return this->patterns.empty() ? (this->pattern ? 1U : 0U) : (uint32) this->patterns.size();
+        }
+        inline Matcher::Interface* GetPattern(uint32 index) const
+        {
+            return this->patterns.empty() ? this->pattern : this->patterns[index];
+        }
 
         static uint64 ExtensionToHash(std::string_view ext);
         static uint64 ExtensionToHash(std::u16string_view ext);
+        static void GetLoadingStats(double& milliseconds, uint32& count);
+    };
+    // binary cache (next to gview.ini) with the already parsed type plugins settings (names, extension hashes, compiled
+    // patterns, priorities). It is valid as long as gview.ini and the .tpl files are not changed.
+    class RegistryReader;
+    class RegistryWriter;
+    class PluginRegistry
+    {
+        std::filesystem::path path;
+        uint64 stamp;
+
+        static bool ReadPlugin(RegistryReader& r, Plugin& plugin);
+        static void WritePlugin(RegistryWriter& w, const Plugin& plugin);
+        static void DeletePatterns(Plugin& plugin);
+
+      public:
+        PluginRegistry();
+        bool Init(const std::filesystem::path& iniPath);
+        bool Load(std::vector<Plugin>& plugins);
+        bool Save(const std::vector<Plugin>& plugins);
     };
 } // namespace Type
 
@@ -466,9 +1171,52 @@ namespace App
         constexpr int OPEN_FOLDER       = 120001;
         constexpr int OPEN_PID          = 120002;
         constexpr int OPEN_PROCESS_TREE = 120003;
+        constexpr int SEARCH_ALL        = 120004;
 
     }; // namespace MenuCommands
 
+    constexpr uint32 IDENTIFY_BUFFER_SIZE = 0x8800; // bytes (from the start of an object) used to identify its type
+
+    // the type plugins that validated the content of an object (found without any dialog by Instance::MatchTypePlugins)
+    struct TypePluginsMatch
+    {
+        GView::Type::Plugin* first; // the plugins that match the extension are checked first (nullptr if nothing matched)
+        uint32 count;               // plugins that validated the content (the search stops after 'maxCount' of them)
+        bool byExtension;           // 'first' matched the extension
+        bool byContent;             // 'first' matched a magic or a text pattern
+        bool byMagic;               // 'first' matched a magic (bytes at a fixed offset)
+    };
+
+    // an object that was searched (an open window or a file from a folder) ; files are added only if they have matches
+    struct GlobalSearchSource
+    {
+        std::filesystem::path path;
+        std::u16string name;                  // shown in the results list
+        const GView::Utils::DataCache* data; // identifies the object of an open window (nullptr for the files from a folder)
+    };
+    struct GlobalSearchResult
+    {
+        uint64 offset;
+        uint32 size;
+        uint32 source;
+        std::string context; // the match and a few bytes around it (as text)
+    };
+    // the last search over all the open windows or over a folder (kept between two searches, like the Find dialog data)
+    struct GlobalSearchData
+    {
+        std::u16string text;
+        std::u16string folder;
+        uint32 typeIndex;
+        uint32 scopeIndex;
+        bool matchCase;
+        bool truncated;
+        std::vector<GlobalSearchSource> sources;
+        std::vector<GlobalSearchResult> results;
+        size_t selectedResult;
+
+        GlobalSearchData();
+    };
+
     class Instance : public AppCUI::Utils::PropertiesInterface,
                      public AppCUI::Controls::Handlers::OnEventInterface,
                      public AppCUI::Controls::Handlers::OnStartInterface
@@ -479,8 +1227,12 @@ namespace App
         std::vector<GView::Type::Plugin> typePlugins;
         std::vector<GView::Generic::Plugin> genericPlugins;
         GView::Type::Plugin defaultPlugin;
+        GView::Type::Matcher::SignatureIndex signatures;
         GView::Utils::ErrorList errList;
         uint32 defaultCacheSize;
+        std::chrono::steady_clock::time_point startTime;
+        StartupTrace startupTrace;
+        GlobalSearchData globalSearch;
         struct
         {
             AppCUI::Input::Key changeViews;
@@ -491,19 +1243,31 @@ namespace App
         } Keys;
 
         bool BuildMainMenus();
-        bool LoadSettings();
+        bool LoadSettings(AppCUI::Utils::IniObject* ini);
         void OpenFile();
         void ShowErrors();
 
+        // extension first, then content ; used by both the GUI (before any dialog is shown) and the identify command
+        void MatchTypePlugins(
+              AppCUI::Utils::BufferView buf,
+              GView::Type::Matcher::TextParser& textParser,
+              uint64 extensionHash,
+              GView::Type::Matcher::SignatureMatches& candidates,
+              uint32 maxCount,
+              TypePluginsMatch& match);
         Reference<Type::Plugin> IdentifyTypePlugin_FirstMatch(
-              AppCUI::Utils::BufferView buf, GView::Type::Matcher::TextParser& textParser, uint64 extensionHash);
+              AppCUI::Utils::BufferView buf,
+              GView::Type::Matcher::TextParser& textParser,
+              uint64 extensionHash,
+              GView::Type::Matcher::SignatureMatches& candidates);
         Reference<Type::Plugin> IdentifyTypePlugin_BestMatch(
               const AppCUI::Utils::ConstString& name,
               const AppCUI::Utils::ConstString& path,
               uint64 dataSize,
               AppCUI::Utils::BufferView buf,
               GView::Type::Matcher::TextParser& textParser,
-              uint64 extensionHash);
+              uint64 extensionHash,
+              GView::Type::Matcher::SignatureMatches& candidates);
         Reference<Type::Plugin> IdentifyTypePlugin_Select(
               const AppCUI::Utils::ConstString& name,
               const AppCUI::Utils::ConstString& path,
@@ -528,19 +1292,38 @@ namespace App
               std::string_view typeName);
         bool Add(
               GView::Object::Type objType,
-              std::unique_ptr<AppCUI::OS::DataObject> data,
+              GView::Utils::DataCache&& cache,
               const AppCUI::Utils::ConstString& name,
               const AppCUI::Utils::ConstString& path,
               uint32 PID,
               OpenMethod method,
               std::string_view typeName);
         bool AddFolder(const std::filesystem::path& path);
+        bool AddProcess(uint32 pid);
+        void OpenProcess();
+        void ShowGlobalSearch();
+        bool GoToGlobalSearchResult(const GlobalSearchResult& result);
 
       public:
         Instance();
         bool Init();
+        bool InitHeadless();
+        void GetStartupTrace(StartupTrace& trace);
+        void Identify(const std::filesystem::path& path, OpenMethod method, IdentifyResult& result);
+        bool IdentifyFiles(
+              const std::vector<std::filesystem::path>& files,
+              uint32 threadsCount,
+              OpenMethod method,
+              std::function<void(const std::filesystem::path& path, const IdentifyResult& result)> onResult);
         bool AddFileWindow(const std::filesystem::path& path, OpenMethod method, string_view typeName);
         bool AddBufferWindow(BufferView buf, const ConstString& name, const ConstString& path, OpenMethod method, string_view typeName);
+        bool AddSubObjectWindow(
+              Reference<GView::Object> parent,
+              uint64 offset,
+              uint64 size,
+              const ConstString& name,
+              OpenMethod method,
+              string_view typeName);
         void UpdateCommandBar(AppCUI::Application::CommandBar& commandBar);
 
         // inline getters
@@ -629,6 +1412,22 @@ namespace App
         }
     };
 
+    class OpenProcessDialog : public Window
+    {
+        Reference<TextField> txPID;
+        uint32 pid;
+
+        void Validate();
+
+      public:
+        OpenProcessDialog();
+        bool OnEvent(Reference<Control>, Event eventType, int) override;
+        inline uint32 GetPID() const
+        {
+            return pid;
+        }
+    };
+
     class FileWindowProperties : public Window
     {
       public:
@@ -644,6 +1443,8 @@ namespace App
         Reference<Type::Plugin> typePlugin;
         ItemHandle cursorInfoHandle;
         std::unique_ptr<GView::Object> obj;
+        GView::Utils::StringsExtractorList strings; // used by the Strings panel and the buffer views (stopped before 'obj' is freed)
+        GView::Utils::ZonesList matchZones;         // rule matches (filled by the Rules panel, shown by the buffer views)
         unsigned int defaultCursorViewSize;
         unsigned int defaultVerticalPanelsSize;
         unsigned int defaultHorizontalPanelsSize;
@@ -676,6 +1477,80 @@ namespace App
         bool OnEvent(Reference<Control>, Event eventType, int) override;
     };
 
+    // generic panel (for every object type) with the strings found by the background extractor
+    class StringsPanel : public TabPage
+    {
+        Reference<FileWindow> win;
+        Reference<GView::Utils::StringsExtractorList> strings;
+        Reference<TextField> txFilter;
+        Reference<Label> lbStatus;
+        Reference<ListView> lst;
+        std::vector<GView::Utils::StringRange> listed;
+
+        void Refresh();
+        void GoToSelectedString();
+
+      public:
+        StringsPanel(Reference<FileWindow> win, Reference<GView::Utils::StringsExtractorList> strings);
+        bool OnEvent(Reference<Control>, Event eventType, int ID) override;
+    };
+
+    // generic panel that scans the object (or every file from a folder) with a set of rules loaded from a file
+    class RulesPanel : public TabPage
+    {
+        struct FileResult
+        {
+            std::filesystem::path path;
+            std::string rules; // names of the rules that match
+            uint64 matchesCount;
+        };
+        Reference<FileWindow> win;
+        Reference<GView::Utils::ZonesList> zones;
+        Reference<TextField> txRules;
+        Reference<Label> lbStatus;
+        Reference<ListView> lst;
+        GView::Utils::RuleEngine engine;
+        GView::Utils::RuleScanResult result;
+        std::vector<FileResult> files;
+        bool folderMode;
+
+        bool LoadRules();
+        void Browse();
+        void ScanObject();
+        void ScanFolder();
+        void OpenSelectedItem();
+
+      public:
+        RulesPanel(Reference<FileWindow> win, Reference<GView::Utils::ZonesList> zones);
+        bool OnEvent(Reference<Control>, Event eventType, int ID) override;
+    };
+
+    // searches a pattern in all the open windows or in all the files of a folder (in parallel) ; results are listed while
+    // the search is running
+    class GlobalSearchDialog : public Window
+    {
+        Reference<GlobalSearchData> search;
+        Reference<TextField> txPattern, txFolder;
+        Reference<ComboBox> cbType, cbScope;
+        Reference<CheckBox> cbMatchCase;
+        Reference<Label> lbStatus;
+        Reference<ListView> lst;
+        GView::Utils::SearchEngine engine;
+        GView::Utils::RegexEngine regex;
+
+        bool PrepareSearcher(const GView::Utils::Searcher*& searcher);
+        void Search();
+        void AddResultItem(size_t index);
+        void UpdateStatus(const char* state);
+        void UpdateControls();
+        void Validate();
+
+      public:
+        GlobalSearchDialog(Reference<GlobalSearchData> search, const std::u16string_view& currentFolder);
+
+        bool OnEvent(Reference<Control>, Event eventType, int ID) override;
+    };
+
     class ErrorDialog : public AppCUI::Controls::Window
     {
       public:
@@ -651,9 +651,7 @@ static bool ComputeHash(std::map<std::string, std::string>& outputs, uint32 hash
         }
     }
 
-    const auto block = object->GetData().GetCacheSize();
-    auto offset      = 0ULL;
-    auto left        = object->GetData().GetSize();
+    auto offset = 0ULL;
     LocalString<512> ls;
 
     const char* format = "Reading [0x%.8llX/0x%.8llX] bytes...";
@@ -662,16 +660,12 @@ static bool ComputeHash(std::map<std::string, std::string>& outputs, uint32 hash
         format = "[0x%.16llX/0x%.16llX] bytes...";
     }
 
-    do
+    // the next block is read in background while the current one is hashed
+    GView::Utils::SequentialReader reader(object->GetData(), 0, objectSize);
+    for (auto buffer = reader.Next(); buffer.IsValid(); buffer = reader.Next())
     {
         CHECK(ProgressStatus::Update(offset, ls.Format(format, offset, objectSize)) == false, false, "");
 
-        const auto sizeToRead = (left >= block ? block : left);
-        left -= (left >= block ? block : left);
-
-        const Buffer buffer = object->GetData().CopyToBuffer(offset, static_cast<uint32>(sizeToRead), true);
-        CHECK(buffer.IsValid(), false, "");
-
         for (const auto& hash : hashList)
         {
             switch (static_cast<Hashes>(hashFlags & static_cast<uint32>(hash)))
@@ -747,8 +741,9 @@ static bool ComputeHash(std::map<std::string, std::string>& outputs, uint32 hash
             }
         }
 
-        offset += sizeToRead;
-    } while (left > 0);
+        offset += buffer.GetLength();
+    }
+    CHECK(reader.HasErrors() == false, false, "");
 
     NumericFormatter nf;
     for (const auto& hash : hashList)
@@ -41,55 +41,30 @@ void GView::Type::CSV::CSVFile::UpdateBufferViewZones(GView::View::BufferViewer:
     const auto color = ColorPair{ Color::Gray, Color::Transparent };
 
     const auto oSize = obj->GetData().GetSize();
-    const auto cSize = obj->GetData().GetCacheSize();
+    auto currentLine = 0ULL;
 
-    auto oSizeProcessed = 0ULL;
-    auto currentLine    = 0ULL;
-
-    do
+    // a zone holds the line and its new line characters (a CRLF/LFCR pair is part of the same line)
+    std::vector<GView::Utils::LineScanner::Line> lines;
+    auto addZones = [&]()
     {
-        const auto buf = obj->GetData().Get(oSizeProcessed, static_cast<uint32>(cSize), false);
-        const std::string_view data{ reinterpret_cast<const char*>(buf.GetData()), buf.GetLength() };
-
-        const auto nPos = data.find_first_of('\n', 0);
-        const auto rPos = data.find_first_of('\r', 0);
-
-        const auto oldOSizeProcessed = oSizeProcessed;
-
-        if (nPos < rPos)
-        {
-            if (nPos + 1 < data.size() && data[nPos + 1] == '\r')
-            {
-                oSizeProcessed += nPos + 2;
-            }
-            else
-            {
-                oSizeProcessed += nPos + 1;
-            }
-        }
-        else if (nPos > rPos)
+        for (const auto& l : lines)
         {
-            if (rPos + 1 < data.size() && data[rPos + 1] == '\n')
-            {
-                oSizeProcessed += rPos + 2;
-            }
-            else
-            {
-                oSizeProcessed += rPos + 1;
-            }
-        }
-        else // last line EOF
-        {
-            settings.AddZone(oldOSizeProcessed, oSize - oldOSizeProcessed, color, std::to_string(currentLine));
+            settings.AddZone(l.offset, (uint64) l.size + l.newLineSize, color, std::to_string(currentLine));
             currentLine++;
-            break;
         }
+        lines.clear();
+    };
 
-        settings.AddZone(oldOSizeProcessed, oSizeProcessed - oldOSizeProcessed, color, std::to_string(currentLine));
-
-        currentLine++;
-
-    } while (oSizeProcessed < oSize);
+    // the next chunk is read in background while the current one is scanned
+    GView::Utils::LineScanner scanner(GView::Utils::LineScanner::Encoding::Ascii, 0);
+    GView::Utils::SequentialReader reader(obj->GetData(), 0, oSize);
+    for (auto buf = reader.Next(); buf.IsValid(); buf = reader.Next())
+    {
+        scanner.Scan(buf, lines);
+        addZones();
+    }
+    scanner.Finish(lines);
+    addZones();
 }
 
 void GView::Type::CSV::CSVFile::UpdateGrid(GView::View::GridViewer::Settings& settings)
@@ -90,6 +90,9 @@ class ELFFile : public TypeInterface,
     bool HasPanel(Panels::IDs id);
     bool ParseGoData();
     bool ParseSymbols();
+    template <typename Elf_Sym>
+    bool ParseSymbolsTable(
+          uint64 offset, uint64 size, uint64 strtabOffset, uint64 strtabSize, std::vector<Elf_Sym>& symbols, std::vector<std::string>& names);
 
     bool GetColorForBuffer(uint64 offset, BufferView buf, GView::View::BufferViewer::BufferColor& result) override;
     bool GetColorForBufferIntel(uint64 offset, BufferView buf, GView::View::BufferViewer::BufferColor& result);
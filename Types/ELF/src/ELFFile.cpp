@@ -255,52 +255,26 @@ bool ELFFile::ParseSymbols()
             if (section.sh_type == SHT_SYMTAB) /* Static symbol table */
             {
                 panelsMask |= (1ULL << (uint8) Panels::IDs::StaticSymbols);
-
-                const auto staticSymbolsBuffer = obj->GetData().CopyToBuffer(section.sh_offset, (uint32) section.sh_size);
-
                 const auto& strtabSection = sections64.at(section.sh_link);
-                const auto strtabBuffer   = obj->GetData().CopyToBuffer(strtabSection.sh_offset, (uint32) strtabSection.sh_size);
-
-                auto offset = 0U;
-                while (offset < section.sh_size)
-                {
-                    const auto& sym = staticSymbols64.emplace_back(*(Elf64_Sym*) (staticSymbolsBuffer.GetData() + offset));
-                    offset += sizeof(Elf64_Sym);
-
-                    String demangled;
-                    const auto str = reinterpret_cast<char*>((char*) (strtabBuffer.GetData() + sym.st_name));
-                    if (GView::Utils::Demangle(str, demangled) == false)
-                    {
-                        demangled = str;
-                    }
-
-                    staticSymbolsNames.emplace_back(demangled.GetText());
-                }
+                ParseSymbolsTable(
+                      section.sh_offset,
+                      section.sh_size,
+                      strtabSection.sh_offset,
+                      strtabSection.sh_size,
+                      staticSymbols64,
+                      staticSymbolsNames);
             }
             else if (section.sh_type == SHT_DYNSYM) /* Dynamic symbol table */
             {
                 panelsMask |= (1ULL << (uint8) Panels::IDs::DynamicSymbols);
-
-                const auto dynamicSymbolsBuffer = obj->GetData().CopyToBuffer(section.sh_offset, (uint32) section.sh_size);
-
                 const auto& dstrtabSection = sections64.at(section.sh_link);
-                const auto dstrtabBuffer   = obj->GetData().CopyToBuffer(dstrtabSection.sh_offset, (uint32) dstrtabSection.sh_size);
-
-                auto offset = 0U;
-                while (offset < section.sh_size)
-                {
-                    const auto& sym = dynamicSymbols64.emplace_back(*(Elf64_Sym*) (dynamicSymbolsBuffer.GetData() + offset));
-                    offset += sizeof(Elf64_Sym);
-
-                    String demangled;
-                    const auto str = reinterpret_cast<char*>((char*) (dstrtabBuffer.GetData() + sym.st_name));
-                    if (GView::Utils::Demangle(str, demangled) == false)
-                    {
-                        demangled = str;
-                    }
-
-                    dynamicSymbolsNames.emplace_back(demangled.GetText());
-                }
+                ParseSymbolsTable(
+                      section.sh_offset,
+                      section.sh_size,
+                      dstrtabSection.sh_offset,
+                      dstrtabSection.sh_size,
+                      dynamicSymbols64,
+                      dynamicSymbolsNames);
             }
         }
     }
@@ -312,52 +286,26 @@ bool ELFFile::ParseSymbols()
             if (section.sh_type == SHT_SYMTAB) /* Static symbol table */
             {
                 panelsMask |= (1ULL << (uint8) Panels::IDs::StaticSymbols);
-
-                const auto staticSymbolsBuffer = obj->GetData().CopyToBuffer(section.sh_offset, section.sh_size);
-
                 const auto& strtabSection = sections32.at(section.sh_link);
-                const auto strtabBuffer   = obj->GetData().CopyToBuffer(strtabSection.sh_offset, strtabSection.sh_size);
-
-                auto offset = 0U;
-                while (offset < section.sh_size)
-                {
-                    const auto& sym = staticSymbols32.emplace_back(*(Elf32_Sym*) (staticSymbolsBuffer.GetData() + offset));
-                    offset += sizeof(Elf32_Sym);
-
-                    String demangled;
-                    const auto str = reinterpret_cast<char*>((char*) (strtabBuffer.GetData() + sym.st_name));
-                    if (GView::Utils::Demangle(str, demangled) == false)
-                    {
-                        demangled = str;
-                    }
-
-                    staticSymbolsNames.emplace_back(demangled.GetText());
-                }
+                ParseSymbolsTable(
+                      section.sh_offset,
+                      section.sh_size,
+                      strtabSection.sh_offset,
+                      strtabSection.sh_size,
+                      staticSymbols32,
+                      staticSymbolsNames);
             }
             else if (section.sh_type == SHT_DYNSYM) /* Dynamic symbol table */
             {
                 panelsMask |= (1ULL << (uint8) Panels::IDs::DynamicSymbols);
-
-                const auto dynamicSymbolsBuffer = obj->GetData().CopyToBuffer(section.sh_offset, section.sh_size);
-
                 const auto& dstrtabSection = sections32.at(section.sh_link);
-                const auto dstrtabBuffer   = obj->GetData().CopyToBuffer(dstrtabSection.sh_offset, dstrtabSection.sh_size);
-
-                auto offset = 0U;
-                while (offset < section.sh_size)
-                {
-                    const auto& sym = dynamicSymbols32.emplace_back(*(Elf32_Sym*) (dynamicSymbolsBuffer.GetData() + offset));
-                    offset += sizeof(Elf32_Sym);
-
-                    String demangled;
-                    const auto str = reinterpret_cast<char*>((char*) (dstrtabBuffer.GetData() + sym.st_name));
-                    if (GView::Utils::Demangle(str, demangled) == false)
-                    {
-                        demangled = str;
-                    }
-
-                    dynamicSymbolsNames.emplace_back(demangled.GetText());
-                }
+                ParseSymbolsTable(
+                      section.sh_offset,
+                      section.sh_size,
+                      dstrtabSection.sh_offset,
+                      dstrtabSection.sh_size,
+                      dynamicSymbols32,
+                      dynamicSymbolsNames);
             }
         }
     }
@@ -365,6 +313,60 @@ bool ELFFile::ParseSymbols()
     return true;
 }
 
+template <typename Elf_Sym>
+bool ELFFile::ParseSymbolsTable(
+      uint64 offset, uint64 size, uint64 strtabOffset, uint64 strtabSize, std::vector<Elf_Sym>& symbols, std::vector<std::string>& names)
+{
+    auto& cache = obj->GetData();
+    CHECK(strtabOffset <= cache.GetSize() && strtabSize <= cache.GetSize() - strtabOffset, false, "Invalid string table");
+
+    // strings are accessed randomly => use them directly from the mapping (or copy them if the file is not mapped)
+    Buffer strtabCopy;
+    BufferView strtab;
+    if (cache.IsMemoryMapped())
+    {
+        strtab = BufferView(cache.GetEntireFile().GetData() + strtabOffset, (size_t) strtabSize);
+    }
+    else if (strtabSize > 0)
+    {
+        CHECK(strtabSize <= 0xFFFFFFFFULL, false, "String table too large (%llu bytes)", strtabSize);
+        strtabCopy = cache.CopyToBuffer(strtabOffset, (uint32) strtabSize);
+        strtab     = strtabCopy;
+    }
+
+    // the symbols table is streamed (every chunk holds a whole number of symbols)
+    constexpr uint32 SYMBOLS_PER_CHUNK = 4096;
+    const auto count                   = size / sizeof(Elf_Sym);
+    symbols.reserve(symbols.size() + (size_t) count);
+    return cache.ForEachChunk(
+          offset,
+          count * sizeof(Elf_Sym),
+          [&](uint64, BufferView chunk)
+          {
+              for (size_t pos = 0; pos + sizeof(Elf_Sym) <= chunk.GetLength(); pos += sizeof(Elf_Sym))
+              {
+                  const auto& sym = symbols.emplace_back(*(const Elf_Sym*) (chunk.GetData() + pos));
+
+                  std::string name;
+                  if (sym.st_name < strtab.GetLength())
+                  {
+                      const auto str = reinterpret_cast<const char*>(strtab.GetData() + sym.st_name);
+                      name.assign(str, strnlen(str, strtab.GetLength() - sym.st_name));
+                  }
+
+                  String demangled;
+                  if (GView::Utils::Demangle(name, demangled) == false)
+                  {
+                      demangled = name.c_str();
+                  }
+
+                  names.emplace_back(demangled.GetText());
+              }
+              return true;
+          },
+          SYMBOLS_PER_CHUNK * sizeof(Elf_Sym));
+}
+
 uint64 ELFFile::TranslateToFileOffset(uint64 value, uint32 fromTranslationIndex)
 {
     return ConvertAddress(value, static_cast<AddressType>(fromTranslationIndex), AddressType::FileOffset);
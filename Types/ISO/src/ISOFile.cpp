@@ -189,9 +189,8 @@ void ISOFile::OnOpenItem(std::u16string_view path, AppCUI::Controls::TreeViewIte
 
     auto data         = item.GetData<ECMA_119_DirectoryRecord>();
     const auto offset = (uint64) data->locationOfExtent.LSB * pvd.vdd.logicalBlockSize.LSB;
-    const auto length = (uint32) data->dataLength.LSB;
+    const auto length = (uint64) data->dataLength.LSB;
     const auto name   = std::string_view{ data->fileIdentifier, data->lengthOfFileIdentifier };
-    const auto buffer = obj->GetData().CopyToBuffer(offset, length);
 
-    GView::App::OpenBuffer(buffer, name, name, GView::App::OpenMethod::BestMatch);
+    GView::App::OpenSubObject(obj, offset, length, name, GView::App::OpenMethod::BestMatch);
 }
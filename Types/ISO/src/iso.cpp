@@ -191,7 +191,7 @@ extern "C"
 
     PLUGIN_EXPORT void UpdateSettings(IniSection sect)
     {
-        sect["Pattern"]     = "magic:00 00 00 00 00 00 00 00";
+        sect["Pattern"]     = "magic@0x8001:43 44 30 30 31"; // "CD001" - identifier of the first volume descriptor
         sect["Extension"]   = "iso";
         sect["Priority"]    = 1;
         sect["Description"] = "Optical disk image (*.iso)";
@@ -1332,10 +1332,9 @@ void MachOFile::OnOpenItem(std::u16string_view path, AppCUI::Controls::TreeViewI
 
     auto data         = item.GetData<MAC::Arch>();
     const auto offset = data->offset;
-    const auto length = (uint32) data->size;
+    const auto length = (uint64) data->size;
 
-    const auto buffer = obj->GetData().CopyToBuffer(offset, length);
-    GView::App::OpenBuffer(buffer, data->info.name, GView::App::OpenMethod::BestMatch);
+    GView::App::OpenSubObject(obj, offset, length, data->info.name, GView::App::OpenMethod::BestMatch);
 }
 
 bool MachOFile::GetColorForBufferIntel(uint64 offset, BufferView buf, GView::View::BufferViewer::BufferColor& result)
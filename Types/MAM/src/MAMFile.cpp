@@ -30,6 +30,16 @@ bool MAMFile::Decompress()
     uint64 pos       = 8ULL;
     const auto size  = obj->GetData().GetSize() - pos;
 
+    // memory mapped files => decompress directly from the mapping
+    if (obj->GetData().IsMemoryMapped())
+    {
+        const auto entireFile = obj->GetData().GetEntireFile();
+        const BufferView compressed{ entireFile.GetData() + pos, (size_t) size };
+        CHECK(GView::Compression::LZXPRESS::Huffman::Decompress(compressed, uncompressed), false, "");
+        GView::App::OpenBuffer(uncompressed, obj->GetName(), GView::App::OpenMethod::BestMatch);
+        return true;
+    }
+
     Buffer compressed;
     compressed.Resize(size);
 
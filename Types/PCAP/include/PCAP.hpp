@@ -7,10 +7,11 @@ namespace GView::Type::PCAP
 class PCAPFile : public TypeInterface
 {
   public:
-    Buffer data; // it's maximum 0xFFFF so just save it here
+    Buffer data;        // a copy of the packets (only if the file is not memory mapped)
+    BufferView packets; // all the packets (view into the mapping or into 'data')
 
     Header header;
-    std::vector<std::pair<PacketHeader*, uint32>> packetHeaders;
+    std::vector<std::pair<PacketHeader*, uint64>> packetHeaders;
 
     PCAPFile();
     virtual ~PCAPFile()
@@ -8,7 +8,7 @@ PCAPFile::PCAPFile()
 
 bool PCAPFile::Update()
 {
-    auto offset = 0;
+    uint64 offset = 0;
     CHECK(obj->GetData().Copy<Header>(offset, header), false, "");
     offset += sizeof(Header);
     if (header.magicNumber == Magic::Swapped)
@@ -16,13 +16,24 @@ bool PCAPFile::Update()
         Swap(header);
     }
 
-    data = obj->GetData().CopyToBuffer(offset, (uint32) obj->GetData().GetSize() - offset);
-    CHECK(data.IsValid(), false, "");
+    const auto size = obj->GetData().GetSize() - offset;
+    if (obj->GetData().IsMemoryMapped())
+    {
+        // packets are used directly from the mapping (no size limit)
+        packets = BufferView(obj->GetData().GetEntireFile().GetData() + offset, (size_t) size);
+    }
+    else
+    {
+        CHECK(size <= 0xFFFFFFFFULL, false, "Packets size (%llu) is too large to be copied in memory", size);
+        data = obj->GetData().CopyToBuffer(offset, (uint32) size);
+        CHECK(data.IsValid(), false, "");
+        packets = data;
+    }
 
     const auto delta = offset;
     do
     {
-        const auto& [header, _] = packetHeaders.emplace_back((PacketHeader*) (data.GetData() + offset - delta), offset);
+        const auto& [header, _] = packetHeaders.emplace_back((PacketHeader*) (packets.GetData() + offset - delta), offset);
         offset += (sizeof(PacketHeader) + header->origLen);
     } while (offset < obj->GetData().GetSize());
 
@@ -48,7 +48,7 @@ std::string_view Packets::GetValue(NumericFormatter& n, uint64 value)
 
 void Panels::Packets::GoToSelectedSection()
 {
-    auto record       = list->GetCurrentItem().GetData<const std::pair<PacketHeader*, uint32>>();
+    auto record       = list->GetCurrentItem().GetData<const std::pair<PacketHeader*, uint64>>();
     const auto offset = record->second;
 
     win->GetCurrentView()->GoTo(offset);
@@ -56,7 +56,7 @@ void Panels::Packets::GoToSelectedSection()
 
 void Panels::Packets::SelectCurrentSection()
 {
-    auto record       = list->GetCurrentItem().GetData<const std::pair<PacketHeader*, uint32>>();
+    auto record       = list->GetCurrentItem().GetData<const std::pair<PacketHeader*, uint64>>();
     const auto offset = record->second;
     const auto size   = record->first->inclLen + sizeof(PacketHeader);
 
@@ -654,7 +654,7 @@ Panels::Packets::PacketDialog::PacketDialog(
 
 void Panels::Packets::OpenPacket()
 {
-    auto itemData      = list->GetCurrentItem().GetData<const std::pair<PacketHeader*, uint32>>();
+    auto itemData      = list->GetCurrentItem().GetData<const std::pair<PacketHeader*, uint64>>();
     const auto& packet = itemData->first;
 
     LocalString<128> ls;
@@ -687,7 +687,7 @@ void Panels::Packets::Update()
         item.SetText(4, tmp.Format("%s", GetValue(n, header->inclLen).data()));
         item.SetText(5, tmp.Format("%s", GetValue(n, header->origLen).data()));
 
-        item.SetData<std::pair<PacketHeader*, uint32>>(&record);
+        item.SetData<std::pair<PacketHeader*, uint64>>(&record);
     }
 }
 
@@ -885,11 +885,13 @@ namespace Type
                 Reference<GView::Type::PE::PEFile> pe;
                 Reference<GView::View::WindowInterface> win;
                 Reference<AppCUI::Controls::ListView> list;
+                std::vector<AppCUI::Controls::ListViewItem> pendingEntropy; // sections with an entropy that was not computed yet
                 int Base;
 
                 std::string_view GetValue(NumericFormatter& n, uint32 value);
                 void GoToSelectedSection();
                 void SelectCurrentSection();
+                void UpdateEntropy();
 
               public:
                 Sections(Reference<GView::Type::PE::PEFile> pe, Reference<GView::View::WindowInterface> win);
@@ -27,7 +27,8 @@ Panels::Sections::Sections(Reference<GView::Type::PE::PEFile> _pe, Reference<GVi
             "n:NrReloc,a:r,w:10",
             "n:PtrLnNum,w:10",
             "n:NrLnNum,a:r,w:10",
-            "n:Characteristics,w:32" },
+            "n:Characteristics,w:32",
+            "n:Entropy,a:r,w:9" },
           ListViewFlags::None);
 
     Update();
@@ -60,6 +61,7 @@ void Panels::Sections::Update()
     LocalString<128> temp;
     NumericFormatter n;
     list->DeleteAllItems();
+    pendingEntropy.clear();
 
     for (auto tr = 0U; tr < pe->nrSections; tr++)
     {
@@ -118,11 +120,42 @@ void Panels::Sections::Update()
             temp.Add(" [+]");
         }
         item.SetText(9, temp);
+
+        // a packed/encrypted section has an entropy close to 8 bits/byte
+        if ((sect.SizeOfRawData > 0) && (sect.PointerToRawData < pe->obj->GetData().GetSize()))
+            pendingEntropy.push_back(item);
+    }
+    UpdateEntropy();
+}
+
+void Panels::Sections::UpdateEntropy()
+{
+    // the entropy is computed in background (once the panel is used) ; the sections that are not computed yet show "..."
+    LocalString<32> temp;
+    auto& map = pe->obj->GetEntropyMap();
+    for (auto idx = pendingEntropy.size(); idx > 0; idx--)
+    {
+        auto& item = pendingEntropy[idx - 1];
+        auto sect  = item.GetData<PE::ImageSectionHeader>();
+        double entropy;
+        if (map.TryGet(sect->PointerToRawData, sect->SizeOfRawData, entropy))
+        {
+            item.SetText(10, temp.Format("%.2f", entropy));
+            pendingEntropy.erase(pendingEntropy.begin() + (idx - 1));
+        }
+        else
+            item.SetText(10, "...");
     }
 }
 
 bool Panels::Sections::OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar)
 {
+    // called whenever the panel has the focus => a good moment to start (or to show the progress of) the entropy computation
+    if (!pendingEntropy.empty())
+    {
+        pe->obj->GetEntropyMap().Start(pendingEntropy.front().GetData<PE::ImageSectionHeader>()->PointerToRawData);
+        UpdateEntropy();
+    }
     commandBar.SetCommand(Key::Enter, "GoTo", PE_SECTIONS_GOTO);
     commandBar.SetCommand(Key::F3, "Edit", PE_SECTIONS_EDIT);
     commandBar.SetCommand(Key::F9, "Select", PE_SECTIONS_SELECT);
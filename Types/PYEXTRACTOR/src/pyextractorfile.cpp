@@ -186,10 +186,9 @@ void PYEXTRACTORFile::OnOpenItem(std::u16string_view path, AppCUI::Controls::Tre
 
     auto data         = item.GetData<TOCEntry>();
     const auto offset = (uint64) data->entryPos;
-    const auto length = (uint32) data->cmprsdDataSize;
+    const auto length = (uint64) data->cmprsdDataSize;
     const auto name   = std::string_view{ reinterpret_cast<char*>(data->name.GetData()), data->name.GetLength() };
-    const auto buffer = obj->GetData().CopyToBuffer(offset, length);
 
-    GView::App::OpenBuffer(buffer, name, name, GView::App::OpenMethod::BestMatch);
+    GView::App::OpenSubObject(obj, offset, length, name, GView::App::OpenMethod::BestMatch);
 }
 } // namespace GView::Type::PYEXTRACTOR